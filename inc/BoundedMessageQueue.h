@@ -0,0 +1,166 @@
+/**
+ * @file BoundedMessageQueue.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the BoundedMessageQueue class.
+ * The BoundedMessageQueue holds the messages received from the embedded system until the GUI takes them. Its capacity is
+ * fixed so that memory stays bounded when the GUI stops polling (for example while a modal dialog is open), and an overflow
+ * policy decides what happens when a message arrives on a full queue:
+ *
+ * BLOCK => The message is never dropped, the writer waits for room (backpressure on the link)
+ * KEEP_LATEST => Every queued message is stale, so they are all dropped and only the new message is kept
+ * DROP_OLDEST => The oldest message is dropped to make room, so the queue keeps the most recent history
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef BOUNDED_MESSAGE_QUEUE_H
+#define BOUNDED_MESSAGE_QUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include "MessagePacket.h"
+
+
+#define QUEUE_POLICY_BLOCK 0                                //!< Never drop, the writer waits for room
+#define QUEUE_POLICY_KEEP_LATEST 1                          //!< Drop every queued message and keep the new one
+#define QUEUE_POLICY_DROP_OLDEST 2                          //!< Drop the oldest message to make room
+
+
+/**
+ * @brief Counters of a queue, used to size the queues and to check that no data was lost
+ *
+ */
+struct queueStatistics{
+
+    unsigned long size; ///<Number of messages in the queue
+    unsigned long capacity; ///<Maximum number of messages in the queue
+    unsigned long highWaterMark; ///<Largest number of messages that were in the queue at once
+    unsigned long dropped; ///<Number of messages dropped by the overflow policy
+    unsigned long blocked; ///<Number of times a writer had to wait for room
+
+};
+
+
+/**
+ * @brief The BoundedMessageQueue class is a thread-safe queue of received messages with a fixed capacity and an overflow policy
+ *
+ */
+class BoundedMessageQueue{
+
+    //Declare BoundedMessageQueue attributes
+    private:
+
+        //Properties:
+
+        /**
+         * @brief Messages waiting to be taken
+         *
+         */
+        std::deque<MessagePacket> messages;
+
+        /**
+         * @brief Maximum number of messages waiting
+         *
+         */
+        unsigned long capacity;
+
+        /**
+         * @brief One of the QUEUE_POLICY defines, applied when a message arrives on a full queue
+         *
+         */
+        unsigned int policy;
+
+        /**
+         * @brief Largest number of messages that were waiting at once
+         *
+         */
+        unsigned long highWaterMark;
+
+        /**
+         * @brief Number of messages dropped by the overflow policy
+         *
+         */
+        unsigned long dropped;
+
+        /**
+         * @brief Number of times a writer had to wait for room
+         *
+         */
+        unsigned long blocked;
+
+        /**
+         * @brief Mutex used to protect the queue, as messages are pushed and taken from different threads
+         *
+         */
+        std::mutex queueMutex;
+
+        /**
+         * @brief Signalled when a message is taken off the queue or the capacity grows
+         *
+         */
+        std::condition_variable spaceAvailable;
+
+    public:
+
+        /**
+         * @brief Construct a new Bounded Message Queue object
+         *
+         * @param capacity -> Maximum number of messages waiting (at least 1)
+         * @param policy -> One of the QUEUE_POLICY defines
+         */
+        BoundedMessageQueue(unsigned long capacity = 64, unsigned int policy = QUEUE_POLICY_DROP_OLDEST);
+
+        /**
+         * @brief Set the capacity of the queue. Messages already waiting beyond a smaller capacity are kept until taken.
+         *
+         * @param capacity -> Maximum number of messages waiting (at least 1)
+         */
+        void setCapacity(unsigned long capacity);
+
+        /**
+         * @brief Set the overflow policy of the queue
+         *
+         * @param policy -> One of the QUEUE_POLICY defines
+         */
+        void setPolicy(unsigned int policy);
+
+        /**
+         * @brief This function puts a message on the queue, applying the overflow policy if the queue is full
+         *
+         * @param message -> Message received
+         */
+        void push(const MessagePacket &message);
+
+        /**
+         * @brief This function takes the oldest message off the queue without waiting
+         *
+         * @param message -> Set to the message taken
+         * @return true -> If a message was taken
+         * @return false -> If the queue is empty
+         */
+        bool tryPop(MessagePacket &message);
+
+        /**
+         * @brief This function takes every message off the queue, waking up a writer waiting for room
+         *
+         * @return unsigned long -> Number of messages taken
+         */
+        unsigned long clear();
+
+        /**
+         * @brief Get the counters of the queue
+         *
+         * @return queueStatistics -> Size, capacity, high-water mark and drop counters
+         */
+        queueStatistics getStatistics();
+
+};
+
+
+#endif /*BOUNDED_MESSAGE_QUEUE_H*/
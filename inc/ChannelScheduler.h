@@ -0,0 +1,169 @@
+/**
+ * @file ChannelScheduler.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the ChannelScheduler class.
+ * The ChannelScheduler decides which frame is written next on the single serial link shared by the logical channels of
+ * \ref MessageLibrary.h. Every channel has its own queue, so a burst on one channel never sits in front of the frames of
+ * another, and the channels are served by priority (\ref ML_CHANNEL_CONTROL first, \ref ML_CHANNEL_DEBUG last).
+ *
+ * To keep the lower channels from starving, every channel has a quota of frames it may send per round. A channel that has
+ * used its quota waits until every other waiting channel has used its own quota, then all quotas are refilled. A control
+ * frame therefore waits for at most the quotas of the lower channels, while bulk telemetry uses whatever is left.
+ *
+ * Every channel also has a capacity, used for flow control: once a channel is full, writers either wait for room or have
+ * their frame refused, depending on how they push it.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef CHANNEL_SCHEDULER_H
+#define CHANNEL_SCHEDULER_H
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include "MessageLibrary.h"
+
+
+/**
+ * @brief The ChannelScheduler class holds the frames waiting to be sent on each logical channel and hands them out by priority
+ *
+ */
+class ChannelScheduler{
+
+    //Declare ChannelScheduler attributes
+    private:
+
+        //Properties:
+
+        /**
+         * @brief Frames waiting to be sent, one queue per channel
+         *
+         */
+        std::deque<std::string> channelFrames[ML_CHANNEL_COUNT];
+
+        /**
+         * @brief Maximum number of frames waiting on each channel
+         *
+         */
+        unsigned int channelCapacity[ML_CHANNEL_COUNT];
+
+        /**
+         * @brief Number of frames each channel may send per round
+         *
+         */
+        unsigned int channelQuota[ML_CHANNEL_COUNT];
+
+        /**
+         * @brief Number of frames each channel may still send in the current round
+         *
+         */
+        unsigned int channelCredit[ML_CHANNEL_COUNT];
+
+        /**
+         * @brief Mutex used to protect the queues, as frames are pushed and taken from different threads
+         *
+         */
+        std::mutex schedulerMutex;
+
+        /**
+         * @brief Signalled when a frame is pushed on any channel
+         *
+         */
+        std::condition_variable frameAvailable;
+
+        /**
+         * @brief Signalled when a frame is taken off any channel
+         *
+         */
+        std::condition_variable spaceAvailable;
+
+        /**
+         * @brief Picks the channel of the next frame to send, refilling the quotas when every waiting channel has used its own.
+         * Must be called with \ref schedulerMutex held.
+         *
+         * @param channel -> Set to the channel of the next frame to send
+         * @return true -> If a frame is waiting
+         * @return false -> If every channel is empty
+         */
+        bool selectChannel(unsigned int &channel);
+
+        /**
+         * @brief Takes the next frame off the selected channel. Must be called with \ref schedulerMutex held.
+         *
+         * @param channel -> Channel picked by \ref selectChannel
+         * @param frame -> Set to the frame to send
+         */
+        void takeFrame(unsigned int channel, std::string &frame);
+
+    public:
+
+        /**
+         * @brief Construct a new Channel Scheduler object with the default capacity and quota of every channel
+         *
+         */
+        ChannelScheduler();
+
+        /**
+         * @brief Set the capacity and quota of a channel
+         *
+         * @param channel -> One of the ML_CHANNEL defines
+         * @param capacity -> Maximum number of frames waiting on the channel (at least 1)
+         * @param quota -> Number of frames the channel may send per round (at least 1)
+         */
+        void setChannelLimits(unsigned int channel, unsigned int capacity, unsigned int quota);
+
+        /**
+         * @brief This function queues a frame to be sent on a channel
+         *
+         * @param channel -> One of the ML_CHANNEL defines
+         * @param frame -> Full frame to send
+         * @param wait -> If true and the channel is full, waits for room. If false, a full channel refuses the frame
+         * @return true -> If the frame was queued
+         * @return false -> If the channel does not exist or is full and wait is false
+         */
+        bool push(unsigned int channel, const std::string &frame, bool wait = true);
+
+        /**
+         * @brief This function waits for a frame and takes the next one to send
+         *
+         * @param frame -> Set to the frame to send
+         * @return unsigned int -> Channel of the frame
+         */
+        unsigned int pop(std::string &frame);
+
+        /**
+         * @brief This function takes the next frame to send without waiting
+         *
+         * @param frame -> Set to the frame to send
+         * @param channel -> Set to the channel of the frame
+         * @return true -> If a frame was taken
+         * @return false -> If every channel is empty
+         */
+        bool tryPop(std::string &frame, unsigned int &channel);
+
+        /**
+         * @brief Get the number of frames waiting on a channel
+         *
+         * @param channel -> One of the ML_CHANNEL defines
+         * @return unsigned long -> Number of frames waiting
+         */
+        unsigned long getPending(unsigned int channel);
+
+        /**
+         * @brief Check whether any frame is waiting on any channel
+         *
+         * @return true -> If every channel is empty
+         */
+        bool isEmpty();
+
+};
+
+
+#endif /*CHANNEL_SCHEDULER_H*/
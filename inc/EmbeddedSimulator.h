@@ -0,0 +1,172 @@
+/**
+ * @file EmbeddedSimulator.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the EmbeddedSimulator class.
+ * The EmbeddedSimulator class holds the state of a simulated air-hockey table and produces the response the embedded system
+ * would send for every message of \ref MessageLibrary.h, as well as random goals while a game is active. It does not own
+ * any link, so it can be driven by the simulation thread of the MessageHandler, by the standalone simulation (see
+ * \ref embeddedsim.cpp) or directly by the benchmarks.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef EMBEDDED_SIMULATOR_H
+#define EMBEDDED_SIMULATOR_H
+
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <stdlib.h>     /* srand, rand */
+#include "MessageLibrary.h"
+#include "MessagePacket.h"
+#include "MessageTransport.h"
+#include "ChannelScheduler.h"
+#include "LatencyProbe.h"
+
+
+/**
+ * @brief The EmbeddedSimulator class simulates the physical attributes of the table and answers messages from the Raspberry PI
+ *
+ */
+class EmbeddedSimulator{
+
+    //Declare EmbeddedSimulator attributes
+    private:
+
+        //Properties (Simulated physical attributes of the real system):
+
+        int gameState; //!< Inactive = 0, Active = 1, goals are only generated while the game is active
+        int aiState; //!< Inactive = 0, Active = 1
+        int aiDifficulty; //!< Integer ranging from 1 to 10
+        int tableMode; //!< Standard = 0, Accessability = 1, AI = 2
+        int tableLighting; //!< 24-bit RGB value
+        int tableAirSpeed; //!< Integer ranging from 0 to 100
+
+        /**
+         * @brief MINIMUM and MAXIMUM time in milliseconds that the simulation waits before generating a random goal, can be tuned
+         *
+         */
+        unsigned int minGoalDelay;
+        unsigned int maxGoalDelay;
+
+        /**
+         * @brief Time in milliseconds between two telemetry messages while the game is active (0 = no telemetry)
+         *
+         */
+        unsigned int telemetryPeriod;
+
+        /**
+         * @brief Protocol version and capabilities (ML_CAP bitmask) of the simulated firmware
+         *
+         */
+        unsigned int protocolVersion;
+        unsigned int capabilities;
+
+        /**
+         * @brief Capabilities agreed with the Raspberry PI by the capability handshake, none until the handshake is done
+         *
+         */
+        unsigned int negotiatedCapabilities;
+
+        /**
+         * @brief Time when the simulated board was powered on, the board time counts from here
+         *
+         */
+        std::chrono::steady_clock::time_point powerOnTime;
+
+    public:
+
+        /**
+         * @brief Construct a new Embedded Simulator object with the table in its power-on state
+         *
+         */
+        EmbeddedSimulator();
+
+        /**
+         * @brief Check whether the simulated game is active and goals should be generated
+         *
+         * @return true -> If the game is active
+         */
+        bool isGameActive() {return this->gameState == ML_ACTIVE;}
+
+        /**
+         * @brief Get the board time, as read from the free-running microsecond timer of the embedded system
+         *
+         * @return unsigned int -> Microseconds since power-on, wrapping as described by \ref ML_TIMESTAMP_MASK
+         */
+        unsigned int boardTime();
+
+        /**
+         * @brief This function parses a message received from the Raspberry PI, acts accordingly on the simulated table, and
+         * creates the response the embedded system would send back
+         *
+         * @param msgReceived -> Message received from the Raspberry PI
+         * @return MessagePacket -> Response with the same message ID as the received message
+         */
+        MessagePacket respond(MessagePacket &msgReceived);
+
+        /**
+         * @brief This function creates an unsolicited goal message with a random side and puck speed, stamped with the board time
+         * if the Raspberry PI agreed to \ref ML_CAP_TIMESTAMPS
+         *
+         * @return MessagePacket -> Goal message to send to the Raspberry PI
+         */
+        MessagePacket generateGoal();
+
+        /**
+         * @brief This function creates an unsolicited telemetry message with a random puck position, sent on the telemetry channel
+         *
+         * @return MessagePacket -> Telemetry message to send to the Raspberry PI
+         */
+        MessagePacket generatePuckPosition();
+
+        /**
+         * @brief This function picks a random time until the next goal is generated while the game is active
+         *
+         * @return unsigned int -> Time until the next goal in milliseconds
+         */
+        unsigned int nextGoalDelay();
+
+        /**
+         * @brief Set the range of times between two random goals, used to speed up the simulated game for load tests
+         *
+         * @param minimum -> Shortest time between two goals in milliseconds
+         * @param maximum -> Longest time between two goals in milliseconds
+         */
+        void setGoalDelay(unsigned int minimum, unsigned int maximum);
+
+        /**
+         * @brief Set the time between two telemetry messages while the game is active
+         *
+         * @param period -> Time between two telemetry messages in milliseconds (0 = no telemetry)
+         */
+        void setTelemetryPeriod(unsigned int period);
+
+        /**
+         * @brief Set the firmware that is simulated, used to check that the HMI still works with older tables
+         *
+         * @param protocolVersion -> Protocol version of the firmware, \ref ML_PROTOCOL_VERSION_LEGACY for firmware that does
+         * not know the capability handshake
+         * @param capabilities -> ML_CAP bitmask of the firmware (ignored for legacy firmware, which has none)
+         */
+        void setFirmware(unsigned int protocolVersion, unsigned int capabilities);
+
+        /**
+         * @brief This function runs the simulated embedded system on a link: it answers every message received from the Raspberry PI
+         * and sends random goals and telemetry while the game is active. Like the embedded system, frames are sent through a
+         * \ref ChannelScheduler so that responses and goals go ahead of telemetry.
+         *
+         * @param link -> Link to the Raspberry PI, read from and written to by this function only
+         * @return int -> Returns once the link is closed or reports an error, with a negative value
+         */
+        int run(MessageTransport &link);
+
+};
+
+
+#endif /*EMBEDDED_SIMULATOR_H*/
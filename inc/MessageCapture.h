@@ -0,0 +1,191 @@
+/**
+ * @file MessageCapture.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the MessageCaptureWriter and MessageCaptureReader classes.
+ * A capture file holds every frame exchanged with the embedded system, along with the time it was seen and whether
+ * it was sent (Tx) or received (Rx) by the Raspberry PI. Captures taken on a table can be replayed at a desk through
+ * the \ref ReplayTransport.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * NOTE: The capture file is a small header followed by one record per frame:
+ *
+ * "AHCAP" VERSION | VARINT((DELTA_US << 1) | DIRECTION) VARINT(LENGTH) FRAME | ...
+ *
+ * DELTA_US = microseconds since the previous record (since the start of the capture for the first record)
+ * DIRECTION = \ref CAPTURE_DIRECTION_TX or \ref CAPTURE_DIRECTION_RX
+ * VARINT = unsigned LEB128 encoding, so a typical goal frame only costs three bytes of overhead
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef MESSAGE_CAPTURE_H
+#define MESSAGE_CAPTURE_H
+
+#include <string>
+#include <fstream>
+#include <chrono>
+
+
+#define CAPTURE_MAGIC "AHCAP"                               //!< Magic bytes at the start of every capture file
+#define CAPTURE_VERSION 1                                   //!< Version of the capture record layout
+
+#define CAPTURE_DIRECTION_TX 0                              //!< Frame was sent by the Raspberry PI to the embedded system
+#define CAPTURE_DIRECTION_RX 1                              //!< Frame was received by the Raspberry PI from the embedded system
+
+
+/**
+ * @brief A single frame read back from a capture file
+ *
+ */
+struct captureRecord{
+
+    unsigned long long timeStamp; ///<Time of the frame in microseconds since the start of the capture
+    unsigned int direction; ///<\ref CAPTURE_DIRECTION_TX or \ref CAPTURE_DIRECTION_RX
+    std::string frame; ///<Full frame of the format "|MSG_ID|>MESSAGE:ARGUMENTS<CHECKSUM|"
+
+};
+
+
+/**
+ * @brief This class is responsible for appending timestamped frames to a capture file
+ *
+ * NOTE: The writer is not thread-safe, the MessageHandler serializes access from its sending and receiving threads
+ *
+ */
+class MessageCaptureWriter{
+
+    private:
+
+        /**
+         * @brief Stream of the open capture file
+         *
+         */
+        std::ofstream captureFile;
+
+        /**
+         * @brief Time the capture was opened, all record times are relative to it
+         *
+         */
+        std::chrono::steady_clock::time_point captureStart;
+
+        /**
+         * @brief Time of the last record written, in microseconds since \ref captureStart
+         *
+         */
+        unsigned long long lastTimeStamp;
+
+        /**
+         * @brief Appends an unsigned LEB128 encoded value to the capture file
+         *
+         * @param value -> Value to encode
+         */
+        void writeVarint(unsigned long long value);
+
+    public:
+
+        /**
+         * @brief Construct a new Message Capture Writer object, no file is open until \ref open is called
+         *
+         */
+        MessageCaptureWriter();
+
+        /**
+         * @brief Destroy the Message Capture Writer object, closing the capture file if it is open
+         *
+         */
+        ~MessageCaptureWriter();
+
+        /**
+         * @brief Creates (or truncates) a capture file and writes its header
+         *
+         * @param fileName -> Path of the capture file
+         * @return true -> If the file was opened
+         * @return false -> If the file could not be created
+         */
+        bool open(const std::string &fileName);
+
+        /**
+         * @brief Closes the capture file, flushing any buffered records
+         *
+         */
+        void close();
+
+        /**
+         * @brief Check whether a capture file is open
+         *
+         * @return true -> If frames are currently being recorded
+         */
+        bool isOpen() {return this->captureFile.is_open();}
+
+        /**
+         * @brief Appends a frame to the capture file, stamped with the current time
+         *
+         * @param direction -> \ref CAPTURE_DIRECTION_TX or \ref CAPTURE_DIRECTION_RX
+         * @param frame -> Full frame that was sent or received
+         */
+        void record(unsigned int direction, const std::string &frame);
+
+};
+
+
+/**
+ * @brief This class is responsible for reading the frames of a capture file back in the order they were recorded
+ *
+ */
+class MessageCaptureReader{
+
+    private:
+
+        /**
+         * @brief Stream of the open capture file
+         *
+         */
+        std::ifstream captureFile;
+
+        /**
+         * @brief Time of the last record read, in microseconds since the start of the capture
+         *
+         */
+        unsigned long long lastTimeStamp;
+
+        /**
+         * @brief Reads an unsigned LEB128 encoded value from the capture file
+         *
+         * @param value -> Decoded value
+         * @return true -> If a complete value was read
+         */
+        bool readVarint(unsigned long long &value);
+
+    public:
+
+        /**
+         * @brief Construct a new Message Capture Reader object, no file is open until \ref open is called
+         *
+         */
+        MessageCaptureReader();
+
+        /**
+         * @brief Opens a capture file and validates its header
+         *
+         * @param fileName -> Path of the capture file
+         * @return true -> If the file exists and is a capture of a supported version
+         * @return false -> Otherwise
+         */
+        bool open(const std::string &fileName);
+
+        /**
+         * @brief Reads the next record of the capture file
+         *
+         * @param record -> Record to fill in
+         * @return true -> If a record was read
+         * @return false -> If the end of the capture was reached or the file is truncated
+         */
+        bool next(captureRecord &record);
+
+};
+
+
+#endif /*MESSAGE_CAPTURE_H*/
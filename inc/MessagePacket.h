@@ -21,6 +21,7 @@
 #include <string>
 #include <sstream>
 #include <iostream>
+#include "MessageLibrary.h"
 
 //Message packet needs to take advantage of a library of messages that can be sent to the embedded system, or received from the embedded system
 
@@ -55,19 +56,22 @@ class MessagePacket{
          */
         unsigned int checksum;
 
-        //Methods:
-
         /**
-         * @brief This function is responsible for calculating a checksum on the data that was sent to the user.
-         * The checksum is ONLY calculated on the messageString portion of the message and is calculated as the
-         * sum of all characters in the string, mod 100 after each addition of a character:
+         * @brief Stores the logical channel the message travels on (see MessageLibrary.h)
          * 
-         * @return unsigned int ==> Calculated checksum
          */
-        unsigned int calculateChecksum();
+        unsigned int channel;
     
     public:
 
+        /**
+         * @brief Get the channel used by a message when its frame does not name one
+         * 
+         * @param messageID -> ID of the message
+         * @return unsigned int => ML_CHANNEL_EVENTS for unsolicited messages, ML_CHANNEL_CONTROL otherwise
+         */
+        static unsigned int defaultChannel(unsigned int messageID);
+
         //Getter functions for the private variables
 
         /**
@@ -91,6 +95,13 @@ class MessagePacket{
          */
         unsigned int getChecksum() {return this->checksum;}
 
+        /**
+         * @brief Get the Channel object
+         * 
+         * @return unsigned int => Returns an unsigned int containing the \ref channel attribute
+         */
+        unsigned int getChannel() {return this->channel;}
+
         /**
          * @brief Create a default constructor, required when overloading is used
          * 
@@ -99,6 +110,7 @@ class MessagePacket{
             this->messageString = "";
             this->messageID = 0;
             this->checksum = 0;
+            this->channel = ML_CHANNEL_CONTROL;
         }
 
         /**
@@ -110,11 +122,21 @@ class MessagePacket{
          */
         MessagePacket(std::string messageString, unsigned int messageID);
 
+        /**
+         * @brief Construct a new Message Packet:: Message Packet object This constructor is used when a message is sent on a
+         * logical channel other than the default channel of its message ID
+         * 
+         * @param messageString => the strign containing the message and arguements to be sent
+         * @param messageID => Integer containing the ID of the message to be sent
+         * @param channel => Logical channel of the message (see MessageLibrary.h)
+         */
+        MessagePacket(std::string messageString, unsigned int messageID, unsigned int channel);
+
         /**
          * @brief Construct a new Message Packet:: Message Packet object ==> This constructor is used when a full message is being
          * read and needs to be converted into a MessagePacket object through string parsing
          * 
-         * NOTE: The string read has the format: "|MSG_ID|>MESSAGE:ARGUMENTS<CHECKSUM"
+         * NOTE: The string read has the format: "|MSG_ID|>MESSAGE:ARGUMENTS<CHECKSUM" or "|MSG_ID,CHANNEL|>MESSAGE:ARGUMENTS<CHECKSUM"
          * 
          * NOTE: Could add getline checks to see if it is getting errors when parsing and throw an associated excpetion as a result,
          * this must be added in the full product (Check if getline is reaching end of stream to early or erroring out)
@@ -139,10 +161,20 @@ class MessagePacket{
             this->messageString = mp.messageString;
             this->messageID = mp.messageID;
             this->checksum = mp.checksum;
+            this->channel = mp.channel;
         }
 
         //Functions used for added functionality for the Message Packets
 
+        /**
+         * @brief This function is responsible for calculating a checksum on the data that was sent to the user.
+         * The checksum is ONLY calculated on the messageString portion of the message and is calculated as the
+         * sum of all characters in the string, mod 100 after each addition of a character:
+         * 
+         * @return unsigned int ==> Calculated checksum
+         */
+        unsigned int calculateChecksum();
+
         /**
          * @brief This function is intended to compare the checksum stored in an object to the calculated checksum based on the attributes of the MessagePacket
          * 
@@ -158,6 +190,19 @@ class MessagePacket{
          * @return std::string -> String of format "|MSG_ID|>MESSAGE:ARGUMENTS<CHECKSUM"
          */
         std::string getFullMessage();
+
+        /**
+         * @brief This function is responsible for splitting a stream of bytes read from the embedded system back into frames.
+         * Reads on a serial line or pipe may return part of a frame or several frames at once, so bytes are accumulated in a
+         * buffer and complete frames of the format "|MSG_ID|>MESSAGE:ARGUMENTS<CHECKSUM|" are removed from its front.
+         * Any bytes in front of the first '|' (line noise, NULL terminators) are discarded.
+         * 
+         * @param buffer -> Bytes received so far, the extracted frame is removed from it
+         * @param frame -> Set to the extracted frame
+         * @return true -> If a complete frame was extracted
+         * @return false -> If the buffer does not hold a complete frame yet
+         */
+        static bool extractFrame(std::string &buffer, std::string &frame);
  
 };
 
@@ -0,0 +1,219 @@
+/**
+ * @file ReplayTransport.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the ReplayTransport class.
+ * The ReplayTransport plays the received (Rx) frames of a capture file back into the MessageHandler as if they were
+ * coming from the embedded system, while the frames the MessageHandler sends (Tx) are checked against the ones that were
+ * recorded. This allows issues seen on a table to be reproduced at a desk, and captured sessions to be used as
+ * repeatable workloads for the message handling code.
+ *
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * NOTE: An Rx frame is never delivered before the Tx frames that preceded it in the capture have been sent, so
+ * responses always follow their requests even when the HMI is slower than the recorded session. Heartbeats and their answers
+ * depend on the timing of the recorded session rather than on the HMI, so they are left out of the replay. The message IDs
+ * depend on when the capture was started, so a recorded response is given the ID its recorded request was sent with during the
+ * replay (with its checksum calculated again), and a capture started in the middle of a session replays like any other
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef REPLAY_TRANSPORT_H
+#define REPLAY_TRANSPORT_H
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "MessageTransport.h"
+#include "MessageCapture.h"
+
+
+#define CAPTURE_REPLAY_MAX_SPEED 0.0                        //!< Replay speed used to deliver frames as fast as the HMI accepts them
+
+
+/**
+ * @brief Counters describing the progress of a replay
+ *
+ */
+struct replayStatistics{
+
+    unsigned long framesReplayed; ///<Number of recorded Rx frames delivered to the MessageHandler
+    unsigned long framesMatched; ///<Number of sent frames identical to the recorded Tx frame
+    unsigned long framesMismatched; ///<Number of sent frames that differ from the recorded Tx frame
+    unsigned long framesUnexpected; ///<Number of sent frames after all recorded Tx frames were used
+    bool finished; ///<True once every recorded Rx frame has been delivered
+
+};
+
+
+/**
+ * @brief This class implements the MessageTransport interface by replaying a capture file written by the \ref MessageCaptureWriter
+ *
+ */
+class ReplayTransport : public MessageTransport{
+
+    private:
+
+        /**
+         * @brief True if the capture file was opened successfully
+         *
+         */
+        bool captureOpen;
+
+        /**
+         * @brief Reader used to walk the recorded Rx frames
+         *
+         */
+        MessageCaptureReader rxReader;
+
+        /**
+         * @brief Reader used to walk the recorded Tx frames
+         *
+         */
+        MessageCaptureReader txReader;
+
+        /**
+         * @brief Replay speed relative to the recorded session (1.0 = real time, \ref CAPTURE_REPLAY_MAX_SPEED = no delays)
+         *
+         */
+        double speed;
+
+        /**
+         * @brief Next Rx frame to deliver
+         *
+         */
+        captureRecord nextRxRecord;
+
+        /**
+         * @brief True while \ref nextRxRecord holds a frame that has not been delivered yet
+         *
+         */
+        bool hasNextRxRecord;
+
+        /**
+         * @brief Number of Tx frames recorded before \ref nextRxRecord
+         *
+         */
+        unsigned long txBeforeNextRx;
+
+        /**
+         * @brief Number of Tx frames recorded that have been read by \ref rxReader so far
+         *
+         */
+        unsigned long txRecordsSeen;
+
+        /**
+         * @brief Number of Tx frames sent by the MessageHandler so far
+         *
+         */
+        unsigned long txRecordsSent;
+
+        /**
+         * @brief Recorded time and replay time of the last frame delivered or sent, used to pace the replay
+         *
+         */
+        unsigned long long anchorTimeStamp;
+        std::chrono::steady_clock::time_point anchorTime;
+
+        /**
+         * @brief Message ID each recorded request ID was last sent with during the replay, used to give responses the ID
+         * the MessageHandler waits for
+         *
+         */
+        std::map<unsigned int, unsigned int> sentMessageIDs;
+
+        /**
+         * @brief Bytes of the current Rx frame that did not fit in the caller's buffer
+         *
+         */
+        std::string pendingBytes;
+
+        /**
+         * @brief Progress counters of the replay
+         *
+         */
+        replayStatistics statistics;
+
+        /**
+         * @brief Mutex protecting the replay state, shared by the sending and receiving threads
+         *
+         */
+        std::mutex replayMutex;
+
+        /**
+         * @brief Condition used to wake the receiving thread once a recorded Tx frame has been sent
+         *
+         */
+        std::condition_variable replayCondition;
+
+        /**
+         * @brief Reads ahead to the next Rx record of the capture, counting the Tx records skipped on the way
+         *
+         */
+        void advanceRx();
+
+        /**
+         * @brief Converts a span of recorded time into replay time according to \ref speed
+         *
+         * @param recordedMicroseconds -> Recorded time span
+         * @return std::chrono::steady_clock::duration -> Time span to wait during the replay
+         */
+        std::chrono::steady_clock::duration scaled(unsigned long long recordedMicroseconds);
+
+        /**
+         * @brief Gives a recorded response the message ID its request was sent with during the replay
+         *
+         * @param frame -> Recorded Rx frame
+         * @return std::string -> Frame to deliver, unchanged if it is not a valid response to a request sent during the replay
+         */
+        std::string renumbered(const std::string &frame);
+
+    public:
+
+        /**
+         * @brief Construct a new Replay Transport object
+         *
+         * @param fileName -> Path of the capture file to replay
+         * @param speed -> Replay speed (1.0 = real time, 10.0 = ten times faster, \ref CAPTURE_REPLAY_MAX_SPEED = no delays)
+         */
+        ReplayTransport(const std::string &fileName, double speed);
+
+        /**
+         * @brief Check whether the capture file could be opened
+         *
+         * @return true -> If the capture is valid and can be replayed
+         */
+        bool isOpen();
+
+        /**
+         * @brief Checks a frame sent by the MessageHandler against the next recorded Tx frame
+         *
+         * @param frame -> Frame sent by the MessageHandler
+         * @return true -> Always, a replay does not fail on mismatching frames, they are counted in the statistics
+         */
+        bool send(const std::string &frame);
+
+        /**
+         * @brief Blocks until the next recorded Rx frame is due and copies it into the buffer
+         *
+         * @param buffer -> Buffer to read the bytes into
+         * @param length -> Size of the buffer
+         * @return int -> Number of bytes read. Once the capture has been fully replayed, the function blocks like an idle line.
+         */
+        int receive(char *buffer, unsigned int length);
+
+        /**
+         * @brief Get the statistics of the replay
+         *
+         * @return replayStatistics -> Copy of the replay counters
+         */
+        replayStatistics getStatistics();
+
+};
+
+
+#endif /*REPLAY_TRANSPORT_H*/
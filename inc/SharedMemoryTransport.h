@@ -0,0 +1,150 @@
+/**
+ * @file SharedMemoryTransport.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the SharedMemoryTransport class.
+ * The SharedMemoryTransport links the HMI to an embedded system simulation running in another process through a POSIX
+ * shared memory object holding two single-producer single-consumer byte rings, one per direction. Bytes are copied straight
+ * into the ring of the peer without any system call, and a futex on the shared memory is only used to wake a reader that
+ * sleeps on an empty ring or a writer that sleeps on a full ring.
+ *
+ * The simulation creates the shared memory object and the HMI opens it, so the simulation must be started first.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * NOTE: Each ring has a single writer and a single reader. On the HMI, this is the sending and receiving threads of the
+ * MessageHandler, so the transport must not be shared with any other thread.
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef SHARED_MEMORY_TRANSPORT_H
+#define SHARED_MEMORY_TRANSPORT_H
+
+#include <string>
+#include <atomic>
+#include <stdint.h>
+#include "MessageTransport.h"
+
+
+#define SHARED_MEMORY_MAGIC 0x41485348                      //!< Written at the start of the shared memory object ("AHSH")
+#define SHARED_MEMORY_VERSION 1                             //!< Version of the shared memory layout
+#define SHARED_MEMORY_RING_SIZE 65536                       //!< Size of each ring in bytes, must be a power of two
+#define SHARED_MEMORY_CACHE_LINE 64                         //!< Size of a cache line, used to keep the reader and writer counters apart
+#define SHARED_MEMORY_SPIN_COUNT 4000                       //!< Number of times an empty ring is checked before the reader sleeps (multi-core only)
+
+
+/**
+ * @brief Ring of bytes written by one process and read by the other. The counters only ever grow (wrapping at 2^32), so the
+ * ring is empty when they are equal and full when they are SHARED_MEMORY_RING_SIZE apart.
+ *
+ */
+struct sharedRing{
+
+    alignas(SHARED_MEMORY_CACHE_LINE) std::atomic<uint32_t> head; ///<Number of bytes written, only changed by the writer
+    std::atomic<uint32_t> dataSignal; ///<Futex word bumped by the writer after writing
+    std::atomic<uint32_t> readerWaiting; ///<Set while the reader sleeps on the futex
+
+    alignas(SHARED_MEMORY_CACHE_LINE) std::atomic<uint32_t> tail; ///<Number of bytes read, only changed by the reader
+    std::atomic<uint32_t> spaceSignal; ///<Futex word bumped by the reader after reading
+    std::atomic<uint32_t> writerWaiting; ///<Set while the writer sleeps on the futex
+
+    alignas(SHARED_MEMORY_CACHE_LINE) char data[SHARED_MEMORY_RING_SIZE]; ///<Bytes of the ring
+
+};
+
+
+/**
+ * @brief Layout of the shared memory object
+ *
+ */
+struct sharedLink{
+
+    uint32_t magic; ///<SHARED_MEMORY_MAGIC once the rings are initialized
+    uint32_t version; ///<SHARED_MEMORY_VERSION
+    sharedRing rings[2]; ///<Ring written by the HMI (0) and ring written by the simulation (1)
+
+};
+
+
+/**
+ * @brief This class implements the MessageTransport interface over a pair of rings in shared memory
+ *
+ */
+class SharedMemoryTransport : public MessageTransport{
+
+    private:
+
+        /**
+         * @brief Shared memory mapped into this process, NULL if it could not be mapped
+         *
+         */
+        sharedLink *link;
+
+        /**
+         * @brief Ring that this process writes to
+         *
+         */
+        sharedRing *txRing;
+
+        /**
+         * @brief Ring that this process reads from
+         *
+         */
+        sharedRing *rxRing;
+
+        /**
+         * @brief Name of the shared memory object
+         *
+         */
+        std::string name;
+
+        /**
+         * @brief True if this process created the shared memory object, and must remove it
+         *
+         */
+        bool owner;
+
+        /**
+         * @brief Waits until the Rx ring holds bytes
+         *
+         * @param timeout -> Longest time to wait in milliseconds (-1 = wait forever)
+         * @return true -> If bytes are available
+         * @return false -> If the timeout expired
+         */
+        bool waitForData(int timeout);
+
+    public:
+
+        /**
+         * @brief Construct a new Shared Memory Transport object
+         *
+         * @param name -> Name of the shared memory object (for example "/carehockey")
+         * @param create -> True for the simulation, which creates the object, false for the HMI, which opens it
+         */
+        SharedMemoryTransport(const std::string &name, bool create);
+
+        /**
+         * @brief Destroy the Shared Memory Transport object, removing the shared memory object if it was created here
+         *
+         */
+        ~SharedMemoryTransport();
+
+        /**
+         * @brief Check whether the shared memory object was mapped
+         *
+         * @return true -> If the transport can be used
+         */
+        bool isOpen() {return this->link != NULL;}
+
+        bool send(const std::string &frame);
+
+        int receive(char *buffer, unsigned int length);
+
+        int waitReadable(int timeout);
+
+};
+
+
+#endif /*SHARED_MEMORY_TRANSPORT_H*/
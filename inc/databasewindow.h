@@ -7,10 +7,14 @@
  * games played during the operationl lifetime of the table. The databse contains a
  * unique match ID to distinguish matches from each other, along with records from the
  * games like the player names, the player scores, and the table mode that was used in
- * the game.
+ * the game. The games of the searched player are shown in a table, read a page at a time as
+ * the table is scrolled. The ratings of the players can be computed again from every stored match.
+ * The database is kept open by the storage service of the main menu: searches use its reader
+ * handle and the recomputed ratings are written by the storage writer, on its own thread.
+ * The names of the stored players are suggested as a name is typed into the search bar.
  *
- * @version 0.1
- * @date 2020-12-02
+ * @version 0.7
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -21,11 +25,19 @@
 #define DATABASEWINDOW_H
 
 #include <QDialog>
-#include <QtSql>
+#include <QDebug>
 #include <QMessageBox>
-#include <fstream>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QHash>
+#include <vector>
 
 #include "MessageLibrary.h"
+#include "rating.h"
+#include "matchstorage.h"
+#include "storagewriter.h"
+#include "nameindex.h"
+#include "historymodel.h"
 
 namespace Ui {
 class databaseWindow;
@@ -46,8 +58,11 @@ public:
      * @brief The constructor for the database window in the GUI.
      *
      * @param parent A pointer to the parent window that creates this.
+     * @param storage A pointer to the storage service that keeps the database open.
+     * @param writer A pointer to the storage writer that makes every change to the database.
+     * @param names A pointer to the index of the stored player names, suggested in the search bar.
      */
-    explicit databaseWindow(QWidget *parent = nullptr);
+    explicit databaseWindow(QWidget *parent = nullptr, matchStorage *storage = nullptr, storageWriter *writer = nullptr, nameIndex *names = nullptr);
 
     /**
      * @brief Destructor function for closing the database window.
@@ -56,14 +71,31 @@ public:
 
 private slots:
     /**
-     * @brief Computes an SQLite database query after the user has inserted a player name
-     * that the wish to search the records for.
+     * @brief Shows the games of the player whose name the user has inserted, newest first.
      *
-     * Displays an error message if the record does not exist, or prints the player stats onto
-     * the standard terminal if the records have returned successfully.
+     * Displays an error message if the record does not exist. Only the first page of games is
+     * read, the next pages are read as the table is scrolled.
      */
     void on_pushButton_search_clicked();
 
+    /**
+     * @brief Computes the ratings of every player again from all the matches stored in the
+     * database, in the order they were played, and hands the new ratings to the storage writer
+     * to replace the stored ratings. The matches waiting for the storage writer are saved first.
+     *
+     * This is used after the parameters of the rating engine were changed. The matches are
+     * rated on all cores.
+     */
+    void on_pushButton_recompute_clicked();
+
+    /**
+     * @brief Tells the user once the storage writer has replaced the recomputed ratings.
+     *
+     * @param job Number of the storage job.
+     * @param committed True if the ratings were stored.
+     */
+    void ratingsStored(unsigned long job, bool committed);
+
 private:
     /**
      * @brief Reference to the UI window for displaying and recieving information.
@@ -71,9 +103,34 @@ private:
     Ui::databaseWindow *ui;
 
     /**
-     * @brief SQLite database built and stored along with the project binaries.
+     * @brief Storage service of the SQLite database stored along with the project binaries.
+     */
+    matchStorage *match_history;
+
+    /**
+     * @brief Games of the searched player, shown in the table.
+     */
+    historyModel *history_model;
+
+    /**
+     * @brief Storage writer of the main menu.
+     */
+    storageWriter *history_writer;
+
+    /**
+     * @brief True while recomputed ratings wait for the storage writer.
+     */
+    bool recompute_pending;
+
+    /**
+     * @brief Number of the storage job of the recomputed ratings.
+     */
+    unsigned long recompute_job;
+
+    /**
+     * @brief Summary shown once the recomputed ratings are stored.
      */
-    QSqlDatabase match_history;
+    QString recompute_summary;
 };
 
 #endif // DATABASEWINDOW_H
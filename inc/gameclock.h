@@ -0,0 +1,87 @@
+/**
+ * @file gameclock.h
+ * @author Sanjayan Kulendran
+ * @brief Header file used to declare the gameClock class.
+ * The gameClock keeps the time of a game with millisecond accuracy. It is built on std::chrono::steady_clock, so it is not
+ * affected by changes of the wall clock, and it only counts the time while the game is running (not while paused)
+ * A clock can optionally have a time limit, in which case it also gives the time remaining in the game
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include<chrono>  //Monotonic clock used to measure the game time
+
+/**
+ * @brief The gameClock class keeps the time of a game with millisecond accuracy, counting only while the game is running
+ * If the clock has a time limit, it also gives the time remaining (the clock never stops by itself, the owner of the clock
+ * schedules the end of the game using getRemainingTime())
+ */
+class gameClock
+{
+
+private:
+
+    std::chrono::steady_clock::duration elapsedBeforeStart; //!< Time counted before the clock was last started (sum of all previous running periods)
+    std::chrono::steady_clock::time_point startTime; //!< Time when the clock was last started or resumed
+    std::chrono::steady_clock::duration timeLimit; //!< Time limit of the game (zero if the game has no time limit)
+    bool running; //!< Is true while the clock is counting
+
+public:
+
+    /**
+     * @brief gameClock - Constructor for a stopped clock at zero
+     * @param timeLimitMilliseconds - Time limit of the game in milliseconds, 0 if the game has no time limit
+     */
+    gameClock(unsigned long timeLimitMilliseconds = 0);
+
+    /**
+     * @brief start - Function to start the clock, or resume it after a pause (does nothing if already running)
+     */
+    void start();
+
+    /**
+     * @brief pause - Function to pause the clock, keeping the time counted so far (does nothing if already paused)
+     */
+    void pause();
+
+    /**
+     * @brief isRunning - Function that indicates if the clock is counting
+     * @return boolean that is 'true' if the clock is started and not paused
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief hasTimeLimit - Function that indicates if the clock has a time limit
+     * @return boolean that is 'true' if a time limit was given
+     */
+    bool hasTimeLimit() const;
+
+    /**
+     * @brief getElapsedTime - Function that returns the time counted while the clock was running
+     * @return Elapsed game time in milliseconds
+     */
+    unsigned long getElapsedTime() const;
+
+    /**
+     * @brief getRemainingTime - Function that returns the time left before the time limit is reached
+     * @return Remaining game time in milliseconds (0 once the limit is reached, or if there is no time limit)
+     */
+    unsigned long getRemainingTime() const;
+
+    /**
+     * @brief isExpired - Function that indicates if the time limit was reached
+     * @return boolean that is 'true' if the clock has a time limit and no time remains
+     */
+    bool isExpired() const;
+
+};
+
+#endif // GAMECLOCK_H
@@ -4,11 +4,16 @@
  * @brief Header file used to declare the qt5 based gameDisplay class.
  * UI displaying points and shot speeds for two players
  * Can handle games with a point threshold for victory or a game timer, with a clock that counts up or down respectively
+ * The clock shown is read from the game clock of the game, and a game timer ends the game with a precise single-shot timer
  * Functionality for pausing, resuming, and exiting a game
- * Adds executed game to an optionally given vector of game class objects to facilitate multi-game matches
+ * Adds executed game to an optionally given vector of game class objects to facilitate multi-game matches (the game is owned
+ * by the display while it is played, and moved into the vector when the display exits)
  * Uses messagehandler class to demonstrate asynchronus communication with an embedded system
- * @version 1.0
- * @date 2020-11-30
+ * Shows live statistics of each player (goals per minute, median and 90th percentile goal speed, momentum), updated on every goal
+ * The table only sends goals while a game is being played, it is made inactive as soon as the game is over
+ * Every goal waiting is taken on each message poll, so goals scored close together are never held back by the poll
+ * @version 1.4
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -22,10 +27,12 @@
 #include <QLCDNumber>
 #include <QTimer>
 #include <vector>
+#include <memory>
 #include "player.h"
 #include "tableconfigurationsettings.h"
 #include "usermatchsettings.h"
 #include "game.h"
+#include "livestatistics.h"
 
 
 #include "MessagePacket.h"
@@ -71,6 +78,11 @@ public slots:
      */
     void updateScore();
 
+    /**
+     * @brief gameTimeExpired - Function that ends a game with a time limit, bounded to the single-shot game end timer
+     */
+    void gameTimeExpired();
+
 
 private slots:
 
@@ -87,21 +99,51 @@ private slots:
 
 private:
 
+    /**
+     * @brief markDisplayedGoals - Function that marks the goals shown for the first time on the score displays, for latency measurements
+     */
+    void markDisplayedGoals();
+
+    /**
+     * @brief startTable - Function that makes the game active on the table, and starts/resumes the game clock aligned with the board time
+     */
+    void startTable();
+
+    /**
+     * @brief stopTable - Function that makes the game inactive on the table, so that it stops sending goals (sent once per pause or end)
+     */
+    void stopTable();
+
+    /**
+     * @brief scheduleGameEnd - Function that starts the game end timer for the time remaining in the game (only for games with a time limit)
+     */
+    void scheduleGameEnd();
+
+    /**
+     * @brief showStatistics - Function that shows the live statistics of both players at the current game time
+     */
+    void showStatistics();
+
     Ui::gameDisplay *ui; //!< QT5 autogenerated pointer to ui
-    game *currentGame; //!< Points to the current game - Will be replaced with match
+    std::unique_ptr<game> currentGame; //!< Owns the current game until it is moved into the game vector
+    liveStatistics statistics; //!< Live statistics of the current game, updated on every goal
     std::vector<game> *gameVector; //!<Pointer to game vector to append finished game into
 
     double displayUpdateInterval; //!< Update interval of display in milliseconds
     double messagePollInterval; //!< Update interval of message poller in milliseconds
-    double gameTime; //!< Current game time in seconds
 
     bool gamePaused;//!< Tracks wheather the game is paused
 
+    bool tableActive;//!< Tracks wheather the game is active on the table (goals are being sent)
+
+    std::vector<unsigned long> undisplayedGoals; //!< Board times of the goals added since the score was last shown, used for latency measurements
+
     player *playerA; //!< Player A
     player *playerB; //!< Player B
 
     QTimer *gameTimeUpdater; //!< Pointer for the the game timer (The trigger interval to update the display)
     QTimer *messagePollTimer; //!< Timer for message poll timer (Governs the interval at which we read messages from the embeded system)
+    QTimer *gameEndTimer; //!< Single-shot timer that ends a game with a time limit when its game clock runs out
 
 
 };
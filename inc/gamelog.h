@@ -0,0 +1,137 @@
+/**
+ * @file gamelog.h
+ * @author Sanjayan Kulendran
+ * @brief Header file used to declare the gameLog class.
+ * The gameLog records a game as an append-only list of events (start, goal, pause, resume, correction and end). The state
+ * of the game (scores, goal statistics, status) is a fold over the events, kept up to date as each event is appended
+ * A copy of the state is kept every GAME_LOG_SNAPSHOT_INTERVAL events, so the state of the game after any number of events
+ * can be rebuilt by folding only the events since the closest snapshot
+ * A disputed goal is retracted by appending a correction event, the goal is then skipped by the fold from that point on
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef GAMELOG_H
+#define GAMELOG_H
+
+#include<vector>  //Vectors for storing the events and snapshots
+
+#define GAME_LOG_SNAPSHOT_INTERVAL 32 //!< Number of events between two snapshots of the game state
+
+#define GAME_EVENT_START 0 //!< The game was started
+#define GAME_EVENT_GOAL 1 //!< A goal was scored
+#define GAME_EVENT_PAUSE 2 //!< The game was paused
+#define GAME_EVENT_RESUME 3 //!< The game was resumed
+#define GAME_EVENT_CORRECTION 4 //!< A goal was retracted
+#define GAME_EVENT_END 5 //!< The game was ended
+
+/**
+ * @brief Running statistics of the goals scored by one player, updated on every goal
+ */
+struct goalStatistics
+{
+    unsigned long count; //!< Number of goals scored
+    int maxSpeed; //!< Fastest goal (0 if no goals)
+    double meanSpeed; //!< Mean goal speed (0 if no goals)
+    double speedVariance; //!< Sample variance of the goal speed (0 if less than two goals)
+    double speedSquaredDeviations; //!< Sum of squared deviations from the mean speed, used to update the variance (Welford's method)
+    unsigned long longestStreak; //!< Longest run of goals scored in a row by the player
+};
+
+/**
+ * @brief One event of a game
+ */
+struct gameEvent
+{
+    unsigned char type; //!< One of the GAME_EVENT defines
+    bool onBSide; //!< For a goal, 'true' if on B side, i.e. if Player A has scored
+    int speed; //!< For a goal, goal speed (unspecified units)
+    unsigned time; //!< Game time of the event [ms]
+    unsigned target; //!< For a correction, index of the goal event that is retracted
+};
+
+/**
+ * @brief State of a game after a number of events
+ */
+struct gameState
+{
+    unsigned long events; //!< Number of events folded into the state
+    unsigned long playerAScore; //!< Score of player A
+    unsigned long playerBScore; //!< Score of player B
+    bool started; //!< Is true once the game was started
+    bool running; //!< Is true while the game is started and not paused or ended
+    bool finished; //!< Is true once the game was ended
+    unsigned long corrections; //!< Number of goals retracted
+    goalStatistics playerAStatistics; //!< Statistics of the goals scored by player A (goals on B side)
+    goalStatistics playerBStatistics; //!< Statistics of the goals scored by player B (goals on A side)
+    bool lastGoalOnBSide; //!< Side of the last goal counted, used for the streaks
+    unsigned long currentStreak; //!< Number of goals in a row scored by the player who scored last
+};
+
+/**
+ * @brief The gameLog class records the events of a game, and folds them into the state of the game
+ */
+class gameLog
+{
+
+private:
+
+    std::vector<gameEvent> events; //!< Every event of the game, in the order they happened
+    std::vector<gameState> snapshots; //!< State after 0, GAME_LOG_SNAPSHOT_INTERVAL, 2*GAME_LOG_SNAPSHOT_INTERVAL... events
+    gameState state; //!< State after all the events
+
+    /**
+     * @brief applyEvent - Function that folds one event into a state
+     * @param foldState - State to update
+     * @param event - Event to fold into the state
+     * @param retracted - 'true' if the event is a goal that is retracted by a later correction, it is then not counted
+     */
+    static void applyEvent(gameState &foldState, const gameEvent &event, bool retracted);
+
+public:
+
+    /**
+     * @brief gameLog - Constructor for an empty log, the state is that of a game not started yet
+     */
+    gameLog();
+
+    /**
+     * @brief append - Function to append an event to the log and fold it into the state
+     * @param event - Event to append, a correction must target a goal event that is not already retracted
+     */
+    void append(const gameEvent &event);
+
+    /**
+     * @brief getState - Function that returns the state after all the events
+     * @return state of the game
+     */
+    const gameState &getState() const;
+
+    /**
+     * @brief getStateAt - Function that rebuilds the state of the game after a number of events, as it was known at that point
+     * (corrections appended later are not applied)
+     * @param eventCount - Number of events to fold (at most getEventCount())
+     * @return state of the game after the first eventCount events
+     */
+    gameState getStateAt(unsigned long eventCount) const;
+
+    /**
+     * @brief getEventCount - Function that returns the number of events in the log
+     * @return number of events
+     */
+    unsigned long getEventCount() const;
+
+    /**
+     * @brief getEvents - Function that gives access to the events, for replay and storage
+     * @return vector of the events, in the order they happened
+     */
+    const std::vector<gameEvent> &getEvents() const;
+
+};
+
+#endif // GAMELOG_H
@@ -9,8 +9,8 @@
  * by the user, the main menu window class opens the respective window to handle the command and
  * passes it any neccessary information.
  *
- * @version 0.1
- * @date 2020-11-11
+ * @version 0.7
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -35,12 +35,33 @@
 #include "gameoutcome.h"
 #include "time.h" //For unique match id generation
 #include "sqlite3.h" //For accessing an SQLite database.
+#include "matchstorage.h" //For the database kept open for the lifetime of the program
+#include "storagewriter.h" //For saving the matches on a background thread
+#include "nameindex.h" //For suggesting the names of the stored players
 #include "databasewindow.h"
+#include "rating.h" //For rating the players after a match
+#include <cmath> //For rounding the ratings
+#include "tournament.h"
+#include "tournamentdisplay.h"
+#include <memory> //For keeping the tournament between openings of the tournament display
+#include <map> //For the matches waiting to be saved
 
 namespace Ui {
 class MainMenuWindow;
 }
 
+/**
+ * @brief The pendingMatch struct holds a match handed to the storage writer, and the new ratings of its players once it is saved
+ */
+struct pendingMatch
+{
+    matchOutcome outcome; //!< Games of the match, with the names of the players
+    matchStandings standings; //!< Games won by each player
+    bool rated; //!< True if the players were rated from the match
+    playerRating playerARating; //!< New rating of player A, once rated
+    playerRating playerBRating; //!< New rating of player B, once rated
+};
+
 /**
  * @brief  The main menu window class is responsible for displaying the GUI to all the available
  * features in the program. It contains its own usermatchsettings, tableconfigurationsettings, and
@@ -85,6 +106,21 @@ public:
      */
     player *playerBObjPtr;
 
+    /**
+     * @brief Pointer to the storage service, which keeps the database open for the lifetime of the program
+     */
+    matchStorage *storageObjPtr;
+
+    /**
+     * @brief Pointer to the storage writer, which saves the matches on a background thread
+     */
+    storageWriter *storageWriterPtr;
+
+    /**
+     * @brief Pointer to the index of the stored player names, which the player settings and database windows suggest names from
+     */
+    nameIndex *playerNamesPtr;
+
 private slots:
     /**
      * @brief Creates a usermatchsettingswindow object, passes it a pointer to self, pointer to own
@@ -105,23 +141,44 @@ private slots:
     void on_pushButtonPlayerSettings_clicked();
 
     /**
-     * @brief Creates a temporary game vector to hold the data about the games that are
-     * about to be played and a game outcome vector to be passed to database. It then
-     * creates a game outcome object to store data about the games outcome, with this a unique
-     * match ID is created to identify gameoutcome objects from the same match. The game match display
-     * window object is created based on the given match settings object, table settings object
-     * and player objects. The relevant information (player names, table mode) that are consistent
-     * with each game are saved to a current game object, then the total player score is computed
-     * from the completed games in the game vector. Lastly the database file is opened and the match
-     * data is saved into the database
+     * @brief Plays a match between the player objects of the main menu (see playMatch)
      */
     void on_pushButtonStartMatch_clicked();
 
+    /**
+     * @brief Creates a tournamentDisplay object for the tournament of the main menu, and shows it as a modal.
+     * The entrants are seeded by their stored ratings, and the tournament matches played on this table are
+     * played and stored by playMatch like any other match
+     */
+    void on_pushButtonTournament_clicked();
+
     /**
      * @brief Creates a databaseWindow object, passes it a pointer to self and then shows the database window GUI
      */
     void on_pushButtonDatabaseWindow_clicked();
 
+    /**
+     * @brief Called once the storage writer has saved a match, shows the new ratings on the player objects of
+     * the main menu that played it
+     *
+     * @param job => Number of the storage job of the match
+     * @param committed => True if the match was saved
+     */
+    void matchSaved(unsigned long job, bool committed);
+
+    /**
+     * @brief Called once the storage writer has read the names of the stored players, adds them to the index of the player names
+     *
+     * @param job => Number of the storage job that read the names
+     * @param committed => True if the names were read
+     */
+    void playerNamesLoaded(unsigned long job, bool committed);
+
+    /**
+     * @brief Called once the player settings are applied, shows the stored ratings of the chosen players
+     */
+    void playerSettingsChanged();
+
 private:
 
     /**
@@ -144,6 +201,60 @@ private:
      */
     playersettingswindow *playerSettingsWindowPtr;
 
+    /**
+     * @brief Tournament in progress, kept between openings of the tournament display
+     */
+    std::unique_ptr<tournament> currentTournament;
+
+    /**
+     * @brief Matches handed to the storage writer and not yet saved, by the number of their storage job
+     */
+    std::map<unsigned long, std::shared_ptr<pendingMatch>> pendingMatches;
+
+    /**
+     * @brief Number of the storage job that reads the names of the stored players when the program starts
+     */
+    unsigned long playerNamesJob;
+
+    /**
+     * @brief Names of the stored players, filled by the storage writer before they are added to the index
+     */
+    std::shared_ptr<std::vector<std::string>> loadedPlayerNames;
+
+    /**
+     * @brief Creates a match to hold the games that are about to be played and a
+     * match outcome to be passed to database, with this a unique match ID is created to identify
+     * the games from the same match. The game match display window object is created based on the
+     * given match settings object, table settings object and player objects. The relevant information
+     * (player names, table mode) that are consistent with each game are saved once to the match outcome,
+     * and the completed games are moved into it. Lastly the match is handed to the storage writer, which
+     * saves the games and the ratings of both players (updated from the result of the match) on its own
+     * thread, so the main menu can be used again as soon as the match is over
+     *
+     * @param playerA => Player A of the match, its rating is updated once the match is saved
+     * @param playerB => Player B of the match, its rating is updated once the match is saved
+     * @return One of the MATCH_RESULT defines, MATCH_RESULT_UNDECIDED if the match was left before it was over
+     */
+    unsigned char playMatch(player *playerA, player *playerB);
+
+    /**
+     * @brief Reads the stored ratings of players, a player without a stored rating has the rating of a new player.
+     * The matches waiting for the storage writer are saved first, so the ratings are up to date.
+     *
+     * @param names => Names of the players
+     * @return Ratings of the players, in the order of the names
+     */
+    std::vector<double> loadRatings(const std::vector<std::string> &names);
+
+    /**
+     * @brief Sets the stored ratings of two players on the player objects, rounded to the nearest integer.
+     * A player without a stored rating gets the rating of a new player.
+     *
+     * @param playerA => Player A
+     * @param playerB => Player B
+     */
+    void showStoredRatings(player *playerA, player *playerB);
+
     gameDisplay *gameDisplayPtr; ///< Stores pointer to game display
     matchDisplay *matchDisplayPtr; ///< Stores pointer to match display
     databaseWindow *databaseWindowPtr;///< Stores pointer to database display
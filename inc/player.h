@@ -6,7 +6,7 @@
  * The player class is responsible for creating a standard structure for creating
  * storing and accessing player objects.
  *
- * @version 0.3
+ * @version 0.4
  * @date 2020-12-02
  *
  *
@@ -60,6 +60,13 @@ public:
      */
     void setpType(unsigned int type);
 
+    /**
+     * @brief This function is intended to set the player rating, as computed by the rating engine
+     *
+     * @param rating => rating of the player, rounded to the nearest integer
+     */
+    void setRating(int rating);
+
     /**
      * @brief This function is intended to return the currently saved player name
      *
@@ -90,7 +97,7 @@ private:
     std::string pName;
 
     /**
-     * @brief Player score
+     * @brief Player rating (Glicko-2 rating, stored in the players table of the database)
      */
     int pRating;
 
@@ -0,0 +1,268 @@
+/**
+ * @file tournament.h
+ * @author Sanjayan Kulendran
+ * @brief Header file used to declare the tournament class.
+ * The tournament class runs an event between many entrants as a single elimination bracket, a double elimination bracket
+ * (winners and losers brackets, and a grand final that is played again if the winner of the losers bracket wins it), or a
+ * round robin in which every entrant plays every other entrant once
+ * The entrants are seeded by rating, and in a bracket the best seeds are placed so they can only meet in the late rounds.
+ * Brackets are filled up to a power of two with byes, which the best seeds receive
+ * Every match of the tournament is created when the tournament is created, and each match knows where its winner and loser
+ * go next, so a result only updates the matches that follow it. A match is ready once both its entrants are known
+ * The tournament is played on a number of tables. Whenever a table is free, it is given the ready match with the longest
+ * chain of matches still to follow it (the rounds of a bracket that depend on it), whose entrants are not playing on
+ * another table. Playing the longest chains first keeps later rounds from waiting on one slow table, which keeps the other
+ * tables busy. In a round robin, the matches are played in the order of the rounds of the schedule
+ * The tournament has no display, so it can be used by the tournament display and by batch simulations alike
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "match.h"  //Matches of the tournament are reported with the MATCH_RESULT defines
+#include<string>  //Names of the entrants
+#include<vector>  //Vectors for the entrants, matches and tables
+#include<set>  //Ordered set of the ready matches
+
+#define TOURNAMENT_SINGLE_ELIMINATION 0 //!< Entrants are out after one lost match
+#define TOURNAMENT_DOUBLE_ELIMINATION 1 //!< Entrants are out after two lost matches
+#define TOURNAMENT_ROUND_ROBIN 2 //!< Every entrant plays every other entrant once
+
+#define TOURNAMENT_NONE static_cast<unsigned long>(-1) //!< No entrant, match or table
+#define TOURNAMENT_BYE static_cast<unsigned long>(-2) //!< Slot of a match without an entrant, the other entrant goes through
+
+#define TOURNAMENT_MATCH_WAITING 0 //!< At least one entrant of the match is not known yet
+#define TOURNAMENT_MATCH_READY 1 //!< Both entrants are known, the match waits for a table
+#define TOURNAMENT_MATCH_PLAYING 2 //!< The match is being played on a table
+#define TOURNAMENT_MATCH_FINISHED 3 //!< The match has been played
+#define TOURNAMENT_MATCH_SKIPPED 4 //!< The match was not played (a bye, or a grand final reset that was not needed)
+
+#define TOURNAMENT_BRACKET_WINNERS 0 //!< Match of the winners bracket (every match of a single elimination)
+#define TOURNAMENT_BRACKET_LOSERS 1 //!< Match of the losers bracket
+#define TOURNAMENT_BRACKET_FINAL 2 //!< Grand final (round 1) or its reset (round 2)
+#define TOURNAMENT_BRACKET_ROUND_ROBIN 3 //!< Match of a round robin
+
+/**
+ * @brief One entrant of the tournament
+ */
+struct tournamentEntrant
+{
+    std::string name; //!< Name of the entrant
+    double rating; //!< Rating the entrant was seeded with
+    unsigned long seed; //!< Seed of the entrant, 1 for the highest rating
+    unsigned long wins; //!< Matches won
+    unsigned long losses; //!< Matches lost
+    unsigned long ties; //!< Matches tied (round robin only)
+    double points; //!< Round robin points, 1 for a win and 0.5 for a tie
+    bool eliminated; //!< True once the entrant is out of a bracket
+    unsigned long eliminationChain; //!< Chain of the match the entrant was eliminated in, a lower chain is a later round
+    unsigned long table; //!< Table the entrant is playing on, or TOURNAMENT_NONE
+};
+
+/**
+ * @brief One match of the tournament
+ */
+struct tournamentMatch
+{
+    unsigned long entrants[2]; //!< Entrants of the match (entrant A, entrant B), TOURNAMENT_NONE until known, or TOURNAMENT_BYE
+    unsigned char bracket; //!< One of the TOURNAMENT_BRACKET defines
+    unsigned long round; //!< Round of the match within its bracket, from 1
+    unsigned char state; //!< One of the TOURNAMENT_MATCH defines
+    unsigned char result; //!< One of the MATCH_RESULT defines, once the match is finished
+    unsigned long winner; //!< Entrant that won the match (or went through a bye), TOURNAMENT_NONE until decided
+    unsigned long loser; //!< Entrant that lost the match, TOURNAMENT_NONE until decided
+    unsigned long winnerMatch; //!< Match the winner goes to, or TOURNAMENT_NONE
+    unsigned char winnerSlot; //!< Slot of the winner in that match
+    unsigned long loserMatch; //!< Match the loser goes to, or TOURNAMENT_NONE if the loser is out
+    unsigned char loserSlot; //!< Slot of the loser in that match
+    unsigned long chain; //!< Number of matches that have to be played one after the other from this match to the end
+    unsigned long priority; //!< Order in which ready matches are given a table, lowest first
+    unsigned long table; //!< Table the match is played on, or TOURNAMENT_NONE
+};
+
+/**
+ * @brief The tournament class creates the matches of a tournament between seeded entrants, updates them as results are
+ * reported, and schedules the ready matches on the tables
+ */
+class tournament
+{
+
+private:
+
+    //Tournament Rules
+    unsigned char format; //!< One of the TOURNAMENT defines for the format
+
+    //Entrants and Matches
+    std::vector<tournamentEntrant> entrants; //!< Entrants, in the order they were given
+    std::vector<tournamentMatch> matches; //!< Every match of the tournament, a match only feeds matches after it
+    unsigned long grandFinal; //!< Grand final of a double elimination, or TOURNAMENT_NONE
+    unsigned long champion; //!< Winner of a bracket once it is over, or TOURNAMENT_NONE
+    unsigned long matchesLeft; //!< Number of matches neither finished nor skipped
+
+    //Scheduling
+    std::set<std::pair<unsigned long, unsigned long> > readyMatches; //!< Ready matches, as (priority, match)
+    std::vector<unsigned long> tables; //!< Match played on each table, or TOURNAMENT_NONE if the table is free
+    unsigned long freeEntrants; //!< Number of entrants still in the tournament and not playing on a table
+
+    /**
+     * @brief addMatch - Function that adds a match, with no entrants yet
+     * @param bracket - one of the TOURNAMENT_BRACKET defines
+     * @param round - round of the match within its bracket
+     * @return index of the match
+     */
+    unsigned long addMatch(unsigned char bracket, unsigned long round);
+
+    /**
+     * @brief linkWinner - Function that sends the winner of a match to a slot of a later match
+     */
+    void linkWinner(unsigned long from, unsigned long to, unsigned char slot);
+
+    /**
+     * @brief linkLoser - Function that sends the loser of a match to a slot of a later match
+     */
+    void linkLoser(unsigned long from, unsigned long to, unsigned char slot);
+
+    /**
+     * @brief createBracket - Function that creates the matches of a single or double elimination bracket
+     * @param seeded - entrants in the order of their seeds
+     */
+    void createBracket(const std::vector<unsigned long> &seeded);
+
+    /**
+     * @brief createRoundRobin - Function that creates the matches of a round robin (circle method, one round per rotation)
+     * @param seeded - entrants in the order of their seeds
+     */
+    void createRoundRobin(const std::vector<unsigned long> &seeded);
+
+    /**
+     * @brief prioritize - Function that works out the chain and priority of every match
+     */
+    void prioritize();
+
+    /**
+     * @brief placeEntrant - Function that places an entrant (or a bye) in a slot of a match, which makes the match ready, or
+     * decides it straight away if one of its entrants is a bye
+     */
+    void placeEntrant(unsigned long matchIndex, unsigned char slot, unsigned long entrant);
+
+    /**
+     * @brief decideMatch - Function that decides a match and sends its winner and loser on
+     * @param matchIndex - match to decide
+     * @param winnerSlot - slot of the winner
+     * @param played - true if the match was played, false if it was decided by a bye
+     */
+    void decideMatch(unsigned long matchIndex, unsigned char winnerSlot, bool played);
+
+    /**
+     * @brief isEntrant - Function that indicates if a slot holds an entrant (not unknown and not a bye)
+     */
+    static bool isEntrant(unsigned long entrant);
+
+public:
+
+    /**
+     * @brief tournament - Tournament constructor, creates every match and schedules the first matches on the tables
+     * @param tournamentFormat - one of the TOURNAMENT defines for the format
+     * @param names - names of the entrants
+     * @param ratings - ratings of the entrants, in the same order as the names, the highest rating is seeded first (entrants
+     * with the same rating keep the order they were given in)
+     * @param tableCount - number of tables the tournament is played on, at least 1
+     */
+    tournament(unsigned char tournamentFormat, const std::vector<std::string> &names, const std::vector<double> &ratings, unsigned long tableCount);
+
+    /**
+     * @brief reportResult - Function to report the result of a match being played, which frees its table, updates the
+     * matches that follow it, and schedules the next ready matches on the free tables
+     * In a bracket, a tied match is won by the entrant with the better seed
+     * @param matchIndex - match being played
+     * @param result - MATCH_RESULT_PLAYER_A, MATCH_RESULT_PLAYER_B or MATCH_RESULT_TIE (other results are ignored)
+     * @return true if the result was taken
+     */
+    bool reportResult(unsigned long matchIndex, unsigned char result);
+
+    /**
+     * @brief scheduleTables - Function that gives every free table a ready match, if any can be played
+     * @return number of matches scheduled
+     */
+    unsigned long scheduleTables();
+
+    /**
+     * @brief isTournamentOver - Function that indicates if every match has been decided
+     * @return boolean that is 'true' once the tournament is over
+     */
+    bool isTournamentOver();
+
+    /**
+     * @brief getFormat - Function that returns the format of the tournament
+     * @return one of the TOURNAMENT defines for the format
+     */
+    unsigned char getFormat();
+
+    /**
+     * @brief getChampion - Function that returns the winner of the tournament
+     * @return entrant that won the bracket, or that leads the round robin, TOURNAMENT_NONE until the tournament is over
+     */
+    unsigned long getChampion();
+
+    /**
+     * @brief getStandings - Function that returns the entrants in the order of their standing
+     * In a bracket, entrants still in come first, then the entrants eliminated in later rounds. In a round robin, entrants
+     * are ordered by points, then by wins. Entrants that cannot be told apart are ordered by seed
+     * @return entrants, from the first to the last
+     */
+    std::vector<unsigned long> getStandings();
+
+    /**
+     * @brief getEntrantCount - Function that returns the number of entrants
+     */
+    unsigned long getEntrantCount();
+
+    /**
+     * @brief getEntrant - Function that returns an entrant
+     * @param entrantIndex - entrant, in the order they were given
+     */
+    const tournamentEntrant &getEntrant(unsigned long entrantIndex);
+
+    /**
+     * @brief getMatchCount - Function that returns the number of matches of the tournament, including byes
+     */
+    unsigned long getMatchCount();
+
+    /**
+     * @brief getMatch - Function that returns a match
+     * @param matchIndex - match, in the order they were created
+     */
+    const tournamentMatch &getMatch(unsigned long matchIndex);
+
+    /**
+     * @brief getMatchesLeft - Function that returns the number of matches that have not been decided yet
+     */
+    unsigned long getMatchesLeft();
+
+    /**
+     * @brief getReadyCount - Function that returns the number of ready matches waiting for a table
+     */
+    unsigned long getReadyCount();
+
+    /**
+     * @brief getTableCount - Function that returns the number of tables
+     */
+    unsigned long getTableCount();
+
+    /**
+     * @brief getTableMatch - Function that returns the match being played on a table
+     * @param table - table, from 0
+     * @return match, or TOURNAMENT_NONE if the table is free
+     */
+    unsigned long getTableMatch(unsigned long table);
+
+};
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,115 @@
+/**
+ * @file tournamentdisplay.h
+ * @author Sanjayan Kulendran
+ * @brief Header file used to declare the qt5 based tournamentDisplay class.
+ * UI creating a tournament from a list of entrants, and showing the match on each table and the standings
+ * A match on a table can be played on this table, through the same match display (and storage) as any other match, or
+ * its result can be entered when it was played on another table. The tournament then queues the next matches on the freed
+ * table
+ * The tournament itself is kept by the main menu, so it lasts when the display is closed
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef TOURNAMENTDISPLAY_H
+#define TOURNAMENTDISPLAY_H
+
+#include <QDialog>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tournament.h"
+
+
+namespace Ui {
+class tournamentDisplay;
+}
+
+/**
+ *
+ * @brief UI creating a tournament, showing the match on each table and the standings, and reporting the results of the
+ * matches
+ *
+ */
+class tournamentDisplay : public QDialog
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief tournamentDisplay - constructor for the display of the tournament kept by the caller
+     * @param currentTournamentReference - Reference to the tournament shown, replaced when a tournament is created
+     * @param ratingLoader - Function that returns the ratings of the entrants, in the order of their names, to seed them
+     * @param matchPlayer - Function that plays a match between entrants A and B on this table, and returns one of the
+     * MATCH_RESULT defines (MATCH_RESULT_UNDECIDED if the match was left before it was over)
+     * @param parent - Pointer to the calling qt window
+     */
+    explicit tournamentDisplay(std::unique_ptr<tournament> &currentTournamentReference, std::function<std::vector<double>(const std::vector<std::string> &)> ratingLoader, std::function<unsigned char(const std::string &, const std::string &)> matchPlayer, QWidget *parent = nullptr);
+
+    /**
+     * @brief Destructor for the class
+     */
+    ~tournamentDisplay();
+
+private slots:
+    /**
+     * @brief on_pushButtonCreate_clicked - Function that creates a tournament from the entrants, format and tables entered
+     */
+    void on_pushButtonCreate_clicked();
+
+    /**
+     * @brief on_pushButtonPlay_clicked - Function that plays the match of the selected table on this table
+     */
+    void on_pushButtonPlay_clicked();
+
+    /**
+     * @brief on_pushButtonPlayerAWon_clicked - Function that reports a win of entrant A in the match of the selected table
+     */
+    void on_pushButtonPlayerAWon_clicked();
+
+    /**
+     * @brief on_pushButtonPlayerBWon_clicked - Function that reports a win of entrant B in the match of the selected table
+     */
+    void on_pushButtonPlayerBWon_clicked();
+
+    /**
+     * @brief on_listWidgetTables_currentRowChanged - Function that enables the buttons for the match of the selected table
+     * @param row - selected table
+     */
+    void on_listWidgetTables_currentRowChanged(int row);
+
+private:
+
+    Ui::tournamentDisplay *ui; //!< QT5 autogenerated pointer to ui
+
+    std::unique_ptr<tournament> *currentTournament; //!< Pointer to the tournament kept by the caller
+
+    std::function<std::vector<double>(const std::vector<std::string> &)> loadRatings; //!< Function returning the ratings of the entrants
+    std::function<unsigned char(const std::string &, const std::string &)> playMatch; //!< Function playing a match on this table
+
+    /**
+     * @brief getSelectedMatch - Function that returns the match on the selected table
+     * @return match, or TOURNAMENT_NONE if there is no tournament, no selected table, or the table is free
+     */
+    unsigned long getSelectedMatch();
+
+    /**
+     * @brief reportSelected - Function that reports the result of the match on the selected table
+     * @param result - one of the MATCH_RESULT defines
+     */
+    void reportSelected(unsigned char result);
+
+    /**
+     * @brief showTournament - Function that shows the tables, standings and status of the tournament
+     */
+    void showTournament();
+};
+
+#endif // TOURNAMENTDISPLAY_H
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui widgets sql
+QT       += core gui widgets
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -14,6 +14,9 @@ TEMPLATE = app
 # Add the ld library to account for the SQLite database.
 LIBS += -ldl
 
+# librt provides shm_open on older C libraries, used by the shared memory link to an out-of-process simulation.
+LIBS += -lrt
+
 # The following define makes your compiler emit warnings if you use
 # any feature of Qt which has been marked as deprecated (the exact warnings
 # depend on your compiler). Please consult the documentation of the
@@ -41,9 +44,30 @@ SOURCES += \
     gamedisplay.cpp\
     goal.cpp\
     game.cpp \
+    gameclock.cpp \
+    gamelog.cpp \
+    livestatistics.cpp \
+    match.cpp \
+    rating.cpp \
+    matchstorage.cpp \
+    storagewriter.cpp \
+    nameindex.cpp \
+    historymodel.cpp \
+    tournament.cpp \
+    tournamentdisplay.cpp \
     matchdisplay.cpp\
     MessageHandler.cpp\
     MessagePacket.cpp \
+    MessageTransport.cpp \
+    MessageCapture.cpp \
+    ReplayTransport.cpp \
+    EmbeddedSimulator.cpp \
+    LatencyProbe.cpp \
+    ChannelScheduler.cpp \
+    BoundedMessageQueue.cpp \
+    LinkMonitor.cpp \
+    ClockSync.cpp \
+    SharedMemoryTransport.cpp \
     sqlite3.c \
     databasewindow.cpp
 
@@ -62,10 +86,31 @@ HEADERS += \
     gamedisplay.h\
     goal.h\
     game.h\
+    gameclock.h \
+    gamelog.h \
+    livestatistics.h \
+    match.h \
+    rating.h \
+    matchstorage.h \
+    storagewriter.h \
+    nameindex.h \
+    historymodel.h \
+    tournament.h \
+    tournamentdisplay.h \
     matchdisplay.h\
     MessageHandler.h\
     MessageLibrary.h\
     MessagePacket.h \
+    MessageTransport.h \
+    MessageCapture.h \
+    ReplayTransport.h \
+    EmbeddedSimulator.h \
+    LatencyProbe.h \
+    ChannelScheduler.h \
+    BoundedMessageQueue.h \
+    LinkMonitor.h \
+    ClockSync.h \
+    SharedMemoryTransport.h \
     gameoutcome.h \
     sqlite3.h \
     sqlite3ext.h \
@@ -79,6 +124,7 @@ FORMS += \
     playersettingswindow.ui \
     gamedisplay.ui \
     matchdisplay.ui \
+    tournamentdisplay.ui \
     databasewindow.ui
 
 # Default rules for deployment.
@@ -0,0 +1,175 @@
+/**
+ * @file ClockSync.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the ClockSync class.
+ * The ClockSync estimates the offset and drift between the free-running microsecond timer of the embedded system (the board
+ * time, see \ref ML_TIMESTAMP_MASK) and the steady_clock of the HMI, so that board timestamps can be placed on the HMI time line.
+ *
+ * The estimate is made as done by NTP: the heartbeat answer carries the board time at which the heartbeat was answered, and
+ * the board time is assumed to match the middle of the round trip measured by the HMI. The error of a sample is then at most
+ * half of its round trip, so the samples with the shortest round trips are trusted, and the drift is the slope of the offset
+ * over time.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <chrono>
+#include <mutex>
+#include <deque>
+#include <stdint.h>
+
+
+#define CLOCK_SYNC_WINDOW 32                                //!< Number of samples kept to estimate the offset and drift
+#define CLOCK_SYNC_BURST 8                                  //!< Number of samples taken on every heartbeat after the link starts
+#define CLOCK_SYNC_PERIOD 10000                             //!< Time in milliseconds between two samples once the burst is done
+#define CLOCK_SYNC_MIN_SPAN 1000                            //!< Shortest time in milliseconds covered by the samples before the drift is estimated
+
+
+/**
+ * @brief Estimate of the board clock
+ *
+ */
+struct clockSyncStatistics{
+
+    bool synchronized; ///<True once at least one sample was taken
+    double offset; ///<Board time minus HMI time in microseconds, at the last sample
+    double drift; ///<Rate of the board clock relative to the HMI clock, in parts per million (positive = board runs fast)
+    double uncertainty; ///<Largest error of the offset in microseconds (half the shortest round trip of the samples)
+    unsigned long samples; ///<Number of samples taken since the link started
+
+};
+
+
+/**
+ * @brief The ClockSync class keeps the samples of the board clock and converts board times to HMI times. It is shared by
+ * the receiving and heartbeat threads of the MessageHandler, and the GUI.
+ *
+ */
+class ClockSync{
+
+    //Declare ClockSync attributes
+    private:
+
+        /**
+         * @brief Sample of the board clock, with times in microseconds from \ref epoch
+         *
+         */
+        struct clockSample{
+            double hmiTime; ///<Middle of the round trip on the HMI clock
+            double offset; ///<Board time minus hmiTime
+            double roundTrip; ///<Round trip of the heartbeat
+        };
+
+        //Properties:
+
+        /**
+         * @brief Most recent samples, oldest first
+         *
+         */
+        std::deque<clockSample> samples;
+
+        /**
+         * @brief HMI time of the first sample, all the times of the samples are counted from here
+         *
+         */
+        std::chrono::steady_clock::time_point epoch;
+
+        /**
+         * @brief Last board time received, and the same time without the wrap of the board timer
+         *
+         */
+        uint32_t lastBoardTime;
+        int64_t lastBoardTimeUnwrapped;
+
+        /**
+         * @brief Time the last sample was taken
+         *
+         */
+        std::chrono::steady_clock::time_point lastSampleTime;
+
+        /**
+         * @brief Current estimate: offset at \ref epoch and drift (as a fraction, not in ppm)
+         *
+         */
+        double estimatedOffset;
+        double estimatedDrift;
+
+        /**
+         * @brief Current statistics
+         *
+         */
+        clockSyncStatistics statistics;
+
+        /**
+         * @brief Mutex used to protect the samples and the estimate, as they are used from different threads
+         *
+         */
+        std::mutex syncMutex;
+
+        /**
+         * @brief Computes the offset and drift again from the samples. Must be called with \ref syncMutex held.
+         *
+         */
+        void estimate();
+
+    public:
+
+        /**
+         * @brief Construct a new Clock Sync object without any sample
+         *
+         */
+        ClockSync();
+
+        /**
+         * @brief Forget every sample, used when the link starts again as the board may have been restarted
+         *
+         */
+        void reset();
+
+        /**
+         * @brief This function decides whether the next heartbeat must be sent to take a sample, even if the link is busy
+         *
+         * @param now -> Current time
+         * @return true -> If a sample is due
+         */
+        bool sampleDue(std::chrono::steady_clock::time_point now);
+
+        /**
+         * @brief This function adds a sample of the board clock
+         *
+         * @param sent -> Time the heartbeat was sent
+         * @param received -> Time the answer was received
+         * @param boardTime -> Board time carried by the answer
+         */
+        void addSample(std::chrono::steady_clock::time_point sent, std::chrono::steady_clock::time_point received, uint32_t boardTime);
+
+        /**
+         * @brief This function converts a board time to the HMI steady_clock. The board time must be within about 17 minutes of
+         * the last sample, as the board timer wraps.
+         *
+         * @param boardTime -> Board time in microseconds
+         * @param steadyTime -> Set to the matching time on the HMI steady_clock
+         * @return true -> If the board clock is synchronized
+         * @return false -> If no sample was taken yet, steadyTime is then unchanged
+         */
+        bool boardToSteady(uint32_t boardTime, std::chrono::steady_clock::time_point &steadyTime);
+
+        /**
+         * @brief Get the current estimate of the board clock
+         *
+         * @return clockSyncStatistics -> Offset, drift and uncertainty
+         */
+        clockSyncStatistics getStatistics();
+
+};
+
+
+#endif /*CLOCK_SYNC_H*/
@@ -0,0 +1,44 @@
+#-------------------------------------------------
+#
+# Benchmarks of the communication classes, built separately from the HMI
+#
+#-------------------------------------------------
+
+TARGET = CommsBench
+TEMPLATE = app
+
+CONFIG += console c++11
+CONFIG -= app_bundle qt
+
+# Google Benchmark is used to time the benchmarks and write the results as JSON.
+LIBS += -lbenchmark -lrt -lpthread
+
+SOURCES += \
+    commsbench.cpp \
+    MessageHandler.cpp \
+    MessagePacket.cpp \
+    MessageTransport.cpp \
+    MessageCapture.cpp \
+    ReplayTransport.cpp \
+    EmbeddedSimulator.cpp \
+    LatencyProbe.cpp \
+    ChannelScheduler.cpp \
+    BoundedMessageQueue.cpp \
+    LinkMonitor.cpp \
+    ClockSync.cpp \
+    SharedMemoryTransport.cpp
+
+HEADERS += \
+    MessageHandler.h \
+    MessageLibrary.h \
+    MessagePacket.h \
+    MessageTransport.h \
+    MessageCapture.h \
+    ReplayTransport.h \
+    EmbeddedSimulator.h \
+    LatencyProbe.h \
+    ChannelScheduler.h \
+    BoundedMessageQueue.h \
+    LinkMonitor.h \
+    ClockSync.h \
+    SharedMemoryTransport.h
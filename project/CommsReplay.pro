@@ -0,0 +1,43 @@
+#-------------------------------------------------
+#
+# Check of the capture and replay of a session started mid-way, built separately from the HMI
+#
+#-------------------------------------------------
+
+TARGET = CommsReplay
+TEMPLATE = app
+
+CONFIG += console c++11
+CONFIG -= app_bundle qt
+
+LIBS += -lrt -lpthread
+
+SOURCES += \
+    commsreplay.cpp \
+    MessageHandler.cpp \
+    MessagePacket.cpp \
+    MessageTransport.cpp \
+    MessageCapture.cpp \
+    ReplayTransport.cpp \
+    EmbeddedSimulator.cpp \
+    LatencyProbe.cpp \
+    ChannelScheduler.cpp \
+    BoundedMessageQueue.cpp \
+    LinkMonitor.cpp \
+    ClockSync.cpp \
+    SharedMemoryTransport.cpp
+
+HEADERS += \
+    MessageHandler.h \
+    MessageLibrary.h \
+    MessagePacket.h \
+    MessageTransport.h \
+    MessageCapture.h \
+    ReplayTransport.h \
+    EmbeddedSimulator.h \
+    LatencyProbe.h \
+    ChannelScheduler.h \
+    BoundedMessageQueue.h \
+    LinkMonitor.h \
+    ClockSync.h \
+    SharedMemoryTransport.h
@@ -0,0 +1,32 @@
+#-------------------------------------------------
+#
+# Embedded system simulation run as its own process, built separately from the HMI
+#
+#-------------------------------------------------
+
+TARGET = EmbeddedSim
+TEMPLATE = app
+
+CONFIG += console c++11
+CONFIG -= app_bundle qt
+
+# librt provides shm_open on older C libraries.
+LIBS += -lrt -lpthread
+
+SOURCES += \
+    embeddedsim.cpp \
+    EmbeddedSimulator.cpp \
+    MessagePacket.cpp \
+    MessageTransport.cpp \
+    SharedMemoryTransport.cpp \
+    ChannelScheduler.cpp \
+    LatencyProbe.cpp
+
+HEADERS += \
+    EmbeddedSimulator.h \
+    MessageLibrary.h \
+    MessagePacket.h \
+    MessageTransport.h \
+    SharedMemoryTransport.h \
+    ChannelScheduler.h \
+    LatencyProbe.h
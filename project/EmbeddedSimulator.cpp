@@ -0,0 +1,410 @@
+/**
+ * @file EmbeddedSimulator.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the EmbeddedSimulator class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "EmbeddedSimulator.h"
+
+
+EmbeddedSimulator::EmbeddedSimulator(){
+
+    //Before beginning the simulation, we need to initialize system variables that the embedded system will have
+    //that represent or simulate the physical attributes of the real system
+
+    this->gameState = ML_INACTIVE;                //Initialize the air-hockey game as inactive
+    this->aiState = ML_INACTIVE;                  //Initialize the AI state as inactive
+    this->aiDifficulty = 0;                       //Initialize the AI difficulty to 0
+    this->tableMode = ML_STANDARD;                //Initialize the table mode to Standard
+    this->tableLighting = 0x000000;               //initialize the table lighting to off (RGB hex value)
+    this->tableAirSpeed = 50;                     //Initialize the table air speed to 50%
+
+    //Below, we define a MINIMUM and MAXIMUM time that we would like the air-hockey game to sleep prior to generating a random goal
+    //The sleep time is stored as a value in milliseconds and can be tuned
+    this->minGoalDelay = 1000;
+    this->maxGoalDelay = 5000;
+
+    this->telemetryPeriod = 0;
+
+    //The simulated firmware is up to date with the library
+    this->protocolVersion = ML_PROTOCOL_VERSION;
+    this->capabilities = ML_CAP_SUPPORTED;
+    this->negotiatedCapabilities = 0;
+
+    //The board time starts counting at power-on
+    this->powerOnTime = std::chrono::steady_clock::now();
+
+}
+
+
+MessagePacket EmbeddedSimulator::respond(MessagePacket &msgReceived){
+
+    //Perform necessary parsing to identify what to do with the message
+    //Create a string to compare when parsing
+    std::string tokenMsg;
+    std::string tokenData;
+
+    //Convert the read data line into a stream that we can tokenize as an input
+    std::istringstream stream(msgReceived.getMessageString());
+
+    //First, we parse the string to get the token corresponding to the message string:
+    getline(stream, tokenMsg, ':'); //Get message for now, assuming only message
+
+    //Prior to performing full processing on the token received, we must check whether it is a getter or setter
+    //message in order to identify whether any additional information is required
+    if(msgReceived.getMessageString().find(SETTER_STRING) != std::string::npos){
+        //If we are dealing with a setter message, then we must read the data coming along with the message
+        getline(stream, tokenData, '<'); //Get message for now, assuming only message
+    }
+
+    //Based on the received message, decide how to respond and what simulation values to alter/change!
+    MessagePacket msgReturn;
+
+
+    //Prior to processing the message, we must ensure that the checksums match:
+    if(!msgReceived.validateChecksum()){
+    
+        std::string stringToSend = "ERROR! NONMATCHING CHECKSUMS";
+        MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
+        msgReturn = msgTmp;
+
+    }
+
+    //Process the message based on the token received
+    if(tokenMsg == M_RPI_GET_AI_DIFFICULTY){
+        std::string stringToSend = M_RPI_GET_AI_DIFFICULTY;
+        MessagePacket msgTmp(stringToSend + ":" + std::to_string(this->aiDifficulty), msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+    else if(tokenMsg == M_RPI_GET_AI_ACTIVE_STATE){
+        std::string stringToSend = M_RPI_GET_AI_ACTIVE_STATE;
+        MessagePacket msgTmp(stringToSend + ":" + std::to_string(this->aiState), msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+    else if(tokenMsg == M_RPI_GET_GAME_ACTIVE_STATE){
+        std::string stringToSend = M_RPI_GET_GAME_ACTIVE_STATE;
+        MessagePacket msgTmp(stringToSend + ":" + std::to_string(this->gameState), msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+    else if(tokenMsg == M_RPI_GET_TABLE_MODE){
+        std::string stringToSend = M_RPI_GET_TABLE_MODE;
+        MessagePacket msgTmp(stringToSend + ":" + std::to_string(this->tableMode), msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+    else if(tokenMsg == M_RPI_GET_TABLE_LIGHTING){
+        std::string stringToSend = M_RPI_GET_TABLE_LIGHTING;
+        MessagePacket msgTmp(stringToSend + ":" + std::to_string(this->tableLighting), msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+    else if(tokenMsg == M_RPI_GET_TABLE_AIR_SPEED){
+        std::string stringToSend = M_RPI_GET_TABLE_AIR_SPEED;
+        MessagePacket msgTmp(stringToSend + ":" + std::to_string(this->tableAirSpeed), msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+    else if(tokenMsg == M_RPI_GET_CAPABILITIES && this->protocolVersion > ML_PROTOCOL_VERSION_LEGACY){
+        //Read the protocol version and capabilities of the Raspberry PI, and only use the capabilities both sides have
+        getline(stream, tokenData, '<');
+        std::istringstream mData(tokenData);
+        unsigned int remoteVersion = 0;
+        unsigned int remoteCapabilities = 0;
+        char comma;
+        mData >> remoteVersion >> comma >> remoteCapabilities;
+        this->negotiatedCapabilities = this->capabilities & remoteCapabilities;
+
+        std::string stringToSend = M_RPI_GET_CAPABILITIES;
+        MessagePacket msgTmp(stringToSend + ":" + std::to_string(this->protocolVersion) + "," + std::to_string(this->capabilities), msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+    else if(tokenMsg == M_RPI_GET_HEARTBEAT && (this->capabilities & ML_CAP_HEARTBEAT)){
+        //The heartbeat is answered with its own sequence number, and the board time it was answered at if timestamps are used
+        getline(stream, tokenData, '<');
+        if(this->negotiatedCapabilities & ML_CAP_TIMESTAMPS){
+            tokenData += "," + std::to_string(this->boardTime());
+        }
+        std::string stringToSend = M_RPI_GET_HEARTBEAT;
+        MessagePacket msgTmp(stringToSend + ":" + tokenData, msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+    else if(tokenMsg == M_RPI_SET_AI_DIFFICULTY){
+        //Convert our token into a string stream and then pipe it into an integer:
+        std::istringstream mData(tokenData);
+        mData >> this->aiDifficulty;
+        //Return the same message that was sent, without data:
+        std::string stringToSend = M_RPI_SET_AI_DIFFICULTY;
+        MessagePacket msgTmp(stringToSend + ":1", msgReceived.getMessageID());
+        msgReturn = msgTmp;
+
+    }
+    else if(tokenMsg == M_RPI_SET_AI_ACTIVE_STATE){
+        //Convert our token into a string stream and then pipe it into an integer:
+        std::istringstream mData(tokenData);
+        mData >> this->aiState;
+        //Return the same message that was sent, without data:
+        std::string stringToSend = M_RPI_SET_AI_ACTIVE_STATE;
+        MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
+        msgReturn = msgTmp;
+
+    }
+    else if(tokenMsg == M_RPI_SET_GAME_ACTIVE_STATE){
+        //Convert our token into a string stream and then pipe it into an integer:
+        std::istringstream mData(tokenData);
+        mData >> this->gameState;
+        //Return the same message that was sent, with the board time of the change if timestamps are used:
+        std::string stringToSend = M_RPI_SET_GAME_ACTIVE_STATE;
+        stringToSend += ":";
+        if(this->negotiatedCapabilities & ML_CAP_TIMESTAMPS){
+            stringToSend += std::to_string(this->boardTime());
+        }
+        MessagePacket msgTmp(stringToSend, msgReceived.getMessageID());
+        msgReturn = msgTmp;
+
+    }
+    else if(tokenMsg == M_RPI_SET_TABLE_MODE){
+        //Convert our token into a string stream and then pipe it into an integer:
+        std::istringstream mData(tokenData);
+        mData >> this->tableMode;
+        //Return the same message that was sent, without data:
+        std::string stringToSend = M_RPI_SET_TABLE_MODE;
+        MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
+        msgReturn = msgTmp;
+
+    }
+    else if(tokenMsg == M_RPI_SET_TABLE_LIGHTING){
+        //Convert our token into a string stream and then pipe it into an integer:
+        std::istringstream mData(tokenData);
+        mData >> this->tableLighting;
+        //Return the same message that was sent, without data:
+        std::string stringToSend = M_RPI_SET_TABLE_LIGHTING;
+        MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
+        msgReturn = msgTmp;
+
+    }
+    else if(tokenMsg == M_RPI_SET_TABLE_AIR_SPEED){
+        //Convert our token into a string stream and then pipe it into an integer:
+        std::istringstream mData(tokenData);
+        mData >> this->tableAirSpeed;
+        //Return the same message that was sent, without data:
+        std::string stringToSend = M_RPI_SET_TABLE_AIR_SPEED;
+        MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
+        msgReturn = msgTmp;
+
+    }
+    else{
+        std::string stringToSend = "ERROR! UNRECOGNIZED MESSAGE";
+        MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
+        msgReturn = msgTmp;
+    }
+
+    return msgReturn;
+
+}
+
+
+MessagePacket EmbeddedSimulator::generateGoal(){
+
+    int goalSide = (rand() % 2);
+    int goalSpeed = (rand() % 100) + 1;
+
+    std::string stringToSend = M_EMB_SET_GOAL_DATA;
+    stringToSend += ":" + std::to_string(goalSide) + "," + std::to_string(goalSpeed);
+
+    //The board stamps the goal when the puck crosses the line, so the HMI does not depend on when it reads the goal
+    if(this->negotiatedCapabilities & ML_CAP_TIMESTAMPS){
+        unsigned int goalTimestamp = this->boardTime();
+        stringToSend += "," + std::to_string(goalTimestamp);
+
+        //The board time names the goal for latency measurements
+        LatencyProbe::instance().mark(LATENCY_STAGE_EMITTED, goalTimestamp);
+    }
+
+    //Use the unsolicited messageID in order to indicate that it is an unsolicited goal message
+    return MessagePacket(stringToSend, ML_UNSOLICITED_MESSAGE_ID);
+
+}
+
+
+MessagePacket EmbeddedSimulator::generatePuckPosition(){
+
+    //Random position of the puck on the table, in mm from the corner of side 0
+    int positionX = rand() % 2000;
+    int positionY = rand() % 1000;
+
+    std::string stringToSend = M_EMB_SET_PUCK_POSITION;
+    stringToSend += ":" + std::to_string(positionX) + "," + std::to_string(positionY);
+
+    //Telemetry is unsolicited, but travels on its own channel so that it never delays goals
+    return MessagePacket(stringToSend, ML_UNSOLICITED_MESSAGE_ID, ML_CHANNEL_TELEMETRY);
+
+}
+
+
+unsigned int EmbeddedSimulator::boardTime(){
+
+    std::chrono::microseconds sincePowerOn = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->powerOnTime);
+    return (unsigned int)(sincePowerOn.count() & ML_TIMESTAMP_MASK);
+
+}
+
+
+unsigned int EmbeddedSimulator::nextGoalDelay(){
+
+    //Below, we generate a time at which we will generate a goal while the game mode is active:
+    return this->minGoalDelay + (rand() % (this->maxGoalDelay - this->minGoalDelay + 1));
+
+}
+
+
+void EmbeddedSimulator::setGoalDelay(unsigned int minimum, unsigned int maximum){
+
+    this->minGoalDelay = minimum;
+    this->maxGoalDelay = (maximum < minimum) ? minimum : maximum;
+
+}
+
+
+void EmbeddedSimulator::setTelemetryPeriod(unsigned int period){
+
+    this->telemetryPeriod = period;
+
+}
+
+
+void EmbeddedSimulator::setFirmware(unsigned int protocolVersion, unsigned int capabilities){
+
+    this->protocolVersion = protocolVersion;
+    this->capabilities = (protocolVersion > ML_PROTOCOL_VERSION_LEGACY) ? capabilities : 0;
+    this->negotiatedCapabilities = 0;
+
+}
+
+
+int EmbeddedSimulator::run(MessageTransport &link){
+
+    //Create a char array of max message length:
+    char readMessage[100];
+
+    //Bytes read from the line that have not been split into frames yet
+    std::string streamBuffer;
+    std::string readString;
+
+    //Frames of the simulation are sent by priority, in the same way as the embedded system. This function is the only
+    //reader of the scheduler, so frames are never pushed with a wait, which could never end
+    ChannelScheduler simulationScheduler;
+    std::string sendString;
+    unsigned int sendChannel;
+
+    bool goalTimerRunning = false;
+    std::chrono::steady_clock::time_point nextGoalTime;
+    std::chrono::steady_clock::time_point nextTelemetryTime;
+
+    while(1){
+
+        //If the game is in an inactive state, then we only listen for messages from the main RaspberryPi
+        int timeout = -1;
+
+        if(this->isGameActive()){
+
+            //If the game is in an ACTIVE state, then we generate random goals at random time intervals
+            //while simultaneously listening for received messages:
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+            if(!goalTimerRunning){
+                nextGoalTime = now + std::chrono::milliseconds(this->nextGoalDelay());
+                nextTelemetryTime = now + std::chrono::milliseconds(this->telemetryPeriod);
+                goalTimerRunning = true;
+            }
+
+            std::chrono::steady_clock::time_point wakeTime = nextGoalTime;
+            if(this->telemetryPeriod > 0 && nextTelemetryTime < wakeTime){
+                wakeTime = nextTelemetryTime;
+            }
+
+            timeout = 0;
+            if(wakeTime > now){
+                timeout = (int)std::chrono::duration_cast<std::chrono::milliseconds>(wakeTime - now).count() + 1;
+            }
+        }
+        else{
+            goalTimerRunning = false;
+        }
+
+        //Frames still waiting to be sent must not wait for the next message
+        if(!simulationScheduler.isEmpty()){
+            timeout = 0;
+        }
+
+        //Wait for a message on the link, or for the next goal to be due. Waking up on the message itself
+        //rather than polling lets the simulation respond as soon as a message is sent
+        int ready = link.waitReadable(timeout);
+
+        if(ready < 0){
+            return -1;
+        }
+
+        if(goalTimerRunning){
+
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+            if(now >= nextGoalTime){
+
+                //Queue the goal to be sent over the link:
+                simulationScheduler.push(ML_CHANNEL_EVENTS, this->generateGoal().getFullMessage(), false);
+
+                nextGoalTime = now + std::chrono::milliseconds(this->nextGoalDelay());
+            }
+
+            //Telemetry is only streamed to a Raspberry PI that agreed to receive it
+            if(this->telemetryPeriod > 0 && (this->negotiatedCapabilities & ML_CAP_TELEMETRY) && now >= nextTelemetryTime){
+
+                //Telemetry is dropped rather than queued without bound when the link cannot keep up
+                simulationScheduler.push(ML_CHANNEL_TELEMETRY, this->generatePuckPosition().getFullMessage(), false);
+
+                nextTelemetryTime = now + std::chrono::milliseconds(this->telemetryPeriod);
+            }
+        }
+
+        if(ready > 0){
+
+            int bytesRead = link.receive(readMessage, sizeof(readMessage));
+
+            //A readable link with nothing to read has been closed by the Raspberry PI
+            if(bytesRead <= 0){
+                return -1;
+            }
+
+            streamBuffer.append(readMessage, bytesRead);
+
+            while(MessagePacket::extractFrame(streamBuffer, readString)){
+
+                //Create the a message packet corresponding to the read string
+                MessagePacket msgReceived(readString);
+
+                //Only requests on the control channel are answered, debug and telemetry messages need no response
+                if(msgReceived.getChannel() != ML_CHANNEL_CONTROL){
+                    continue;
+                }
+
+                //Based on the received message, decide how to respond and what simulation values to alter/change,
+                //then queue a response to the sent message:
+                MessagePacket response = this->respond(msgReceived);
+                simulationScheduler.push(response.getChannel(), response.getFullMessage(), false);
+
+            }
+        }
+
+        //Send a few frames by priority, then check the line again so that new messages are answered ahead of queued telemetry
+        for(unsigned int i = 0; i < ML_CHANNEL_COUNT && simulationScheduler.tryPop(sendString, sendChannel); i++){
+
+            if(!link.send(sendString)){
+                return -1;
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,67 @@
+#-------------------------------------------------
+#
+# Goal-to-pixel latency harness, built separately from the HMI
+#
+#-------------------------------------------------
+
+QT       += core gui widgets
+
+TARGET = LatencyHarness
+TEMPLATE = app
+
+LIBS += -lrt -lpthread
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+CONFIG += c++11
+
+SOURCES += \
+    latencyharness.cpp \
+    gamedisplay.cpp \
+    game.cpp \
+    gameclock.cpp \
+    gamelog.cpp \
+    livestatistics.cpp \
+    goal.cpp \
+    player.cpp \
+    usermatchsettings.cpp \
+    tableconfigurationsettings.cpp \
+    MessageHandler.cpp \
+    MessagePacket.cpp \
+    MessageTransport.cpp \
+    MessageCapture.cpp \
+    ReplayTransport.cpp \
+    EmbeddedSimulator.cpp \
+    LatencyProbe.cpp \
+    ChannelScheduler.cpp \
+    BoundedMessageQueue.cpp \
+    LinkMonitor.cpp \
+    ClockSync.cpp \
+    SharedMemoryTransport.cpp
+
+HEADERS += \
+    gamedisplay.h \
+    game.h \
+    gameclock.h \
+    gamelog.h \
+    livestatistics.h \
+    goal.h \
+    player.h \
+    usermatchsettings.h \
+    tableconfigurationsettings.h \
+    MessageHandler.h \
+    MessageLibrary.h \
+    MessagePacket.h \
+    MessageTransport.h \
+    MessageCapture.h \
+    ReplayTransport.h \
+    EmbeddedSimulator.h \
+    LatencyProbe.h \
+    ChannelScheduler.h \
+    BoundedMessageQueue.h \
+    LinkMonitor.h \
+    ClockSync.h \
+    SharedMemoryTransport.h
+
+FORMS += \
+    gamedisplay.ui
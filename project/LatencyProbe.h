@@ -0,0 +1,217 @@
+/**
+ * @file LatencyProbe.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the LatencyProbe class.
+ * The LatencyProbe measures the time it takes for a goal to travel from the sensor of the table to the score shown on
+ * the display. Each stage of the goal pipeline marks the probe when a goal passes through it, and the probe reports the
+ * latency distribution of every stage and of the whole pipeline.
+ *
+ * The stages of the pipeline are:
+ *
+ * EMITTED => The embedded system stamps the goal, marked by the simulation when it runs in the HMI, and otherwise placed on
+ *            the HMI clock from the board time of the goal (see \ref MessageHandler::boardTicksToSteady)
+ * RECEIVED => The receiving thread of the MessageHandler puts the goal on the unsolicited queue
+ * DEQUEUED => \ref MessageHandler::unsolicitedQueueGet returns the goal to the GUI
+ * ADDED => \ref game::addGoal adds the goal to the game
+ * DISPLAYED => The gameDisplay shows the new score on the LCD
+ *
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * NOTE: Every mark names its goal by the board time the goal was stamped with (see \ref ML_CAP_TIMESTAMPS), which travels
+ * with the goal through the queue and into the game, so a goal that is dropped or retracted between two stages only leaves
+ * its own sample incomplete. Goals without a board time are not recorded. A stage that is never marked (for example EMITTED
+ * when the embedded system is real) is left out of the report, and a stage missed by a goal leaves it out of that stage.
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <iostream>
+#include <string>
+
+
+#define LATENCY_STAGE_EMITTED 0                             //!< Goal message sent by the embedded system
+#define LATENCY_STAGE_RECEIVED 1                            //!< Goal message put on the unsolicited queue
+#define LATENCY_STAGE_DEQUEUED 2                            //!< Goal message taken off the unsolicited queue by the GUI
+#define LATENCY_STAGE_ADDED 3                               //!< Goal added to the game
+#define LATENCY_STAGE_DISPLAYED 4                           //!< New score shown on the display
+#define LATENCY_STAGE_COUNT 5                               //!< Number of stages in the goal pipeline
+
+#define LATENCY_MATCH_WINDOW 256                            //!< Number of most recent goals searched for the goal of a mark
+
+
+/**
+ * @brief Times at which a single goal passed through each stage of the pipeline
+ *
+ */
+struct latencySample{
+
+    unsigned long goalTimestamp; ///<Board time of the goal, which names the goal at every stage
+    std::chrono::steady_clock::time_point stageTime[LATENCY_STAGE_COUNT]; ///<Time of each stage, zero if the stage was not marked
+
+};
+
+
+/**
+ * @brief The LatencyProbe class is designed using a Singleton design pattern so that every stage of the goal pipeline can
+ * mark the same probe. The probe does nothing until it is enabled, so the marks can stay in the production code.
+ *
+ */
+class LatencyProbe{
+
+    //Declare LatencyProbe attributes
+    private:
+
+        /**
+         * @brief True while goals are being recorded, checked without locking so that a disabled probe costs a single load
+         *
+         */
+        std::atomic<bool> enabled;
+
+        /**
+         * @brief Samples of the recorded goals, allocated up front when the probe is enabled
+         *
+         */
+        std::vector<latencySample> samples;
+
+        /**
+         * @brief Number of goals recorded in \ref samples, in the order they were first marked
+         *
+         */
+        unsigned long sampleCount;
+
+        /**
+         * @brief Number of goals that have been marked for each stage
+         *
+         */
+        unsigned long stageCount[LATENCY_STAGE_COUNT];
+
+        /**
+         * @brief Mutex used to protect the samples, as the stages are marked from different threads
+         *
+         */
+        std::mutex probeMutex;
+
+        /**
+         * @brief Construct a new Latency Probe object, disabled. Private for the Singleton design pattern.
+         *
+         */
+        LatencyProbe();
+
+        /**
+         * @brief Make copy constructor private to prevent accidental creation of another singleton
+         *
+         */
+        LatencyProbe(const LatencyProbe &other);
+
+        /**
+         * @brief Make assignment operator private to prevent accidental creation of another singleton
+         *
+         */
+        LatencyProbe& operator=(const LatencyProbe &other);
+
+        /**
+         * @brief Writes the latency distribution between two stages, over the goals marked at both
+         *
+         * @param out -> Stream to write the report line to
+         * @param from -> Earlier stage
+         * @param to -> Later stage
+         * @param suffix -> Text added to the name of the line
+         */
+        void writeStages(std::ostream &out, unsigned int from, unsigned int to, const std::string &suffix);
+
+    public:
+
+        /**
+         * @brief Get the single LatencyProbe object
+         *
+         * @return LatencyProbe&
+         */
+        static LatencyProbe& instance();
+
+        /**
+         * @brief This function clears any previous samples and starts recording goals
+         *
+         * @param capacity -> Maximum number of goals to record, further goals are ignored
+         */
+        void enable(unsigned long capacity);
+
+        /**
+         * @brief This function stops recording goals, the samples are kept for the report
+         *
+         */
+        void disable();
+
+        /**
+         * @brief Check whether goals are being recorded, so that a stage can skip finding the board time of its goal
+         *
+         * @return true -> If the probe is enabled
+         */
+        bool isEnabled() {return this->enabled.load(std::memory_order_relaxed);}
+
+        /**
+         * @brief This function records the current time for a goal passing through a stage
+         *
+         * @param stage -> One of the LATENCY_STAGE defines
+         * @param goalTimestamp -> Board time the goal was stamped with, which names the goal
+         */
+        void mark(unsigned int stage, unsigned long goalTimestamp){
+            if(this->enabled.load(std::memory_order_relaxed)){
+                this->record(stage, goalTimestamp, std::chrono::steady_clock::now());
+            }
+        }
+
+        /**
+         * @brief This function records a time in the past for a goal passing through a stage, for example the time the
+         * embedded system stamped the goal, converted to the HMI clock
+         *
+         * @param stage -> One of the LATENCY_STAGE defines
+         * @param goalTimestamp -> Board time the goal was stamped with, which names the goal
+         * @param stageTime -> Time the goal passed through the stage
+         */
+        void markAt(unsigned int stage, unsigned long goalTimestamp, std::chrono::steady_clock::time_point stageTime){
+            if(this->enabled.load(std::memory_order_relaxed)){
+                this->record(stage, goalTimestamp, stageTime);
+            }
+        }
+
+        /**
+         * @brief Records the time of a goal passing through a stage, called by \ref mark when the probe is enabled.
+         * The goal is searched among the \ref LATENCY_MATCH_WINDOW goals recorded last, and a new sample is started if it is not
+         * found. Only the first mark of a stage is kept for a goal.
+         *
+         * @param stage -> One of the LATENCY_STAGE defines
+         * @param goalTimestamp -> Board time the goal was stamped with
+         * @param stageTime -> Time the goal passed through the stage
+         */
+        void record(unsigned int stage, unsigned long goalTimestamp, std::chrono::steady_clock::time_point stageTime);
+
+        /**
+         * @brief Get the number of goals that have been marked for a stage
+         *
+         * @param stage -> One of the LATENCY_STAGE defines
+         * @return unsigned long -> Number of goals that passed through the stage
+         */
+        unsigned long getStageCount(unsigned int stage);
+
+        /**
+         * @brief This function writes the latency distribution (mean, p50, p90, p99 and max in microseconds) of every stage
+         * relative to the previous marked stage, and of the whole pipeline from the first to the last marked stage. Each
+         * distribution only counts the goals marked at both of its stages
+         *
+         * @param out -> Stream to write the report to
+         */
+        void writeReport(std::ostream &out);
+
+};
+
+
+#endif /*LATENCY_PROBE_H*/
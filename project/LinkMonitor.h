@@ -0,0 +1,187 @@
+/**
+ * @file LinkMonitor.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the LinkMonitor class.
+ * The LinkMonitor keeps track of the health of the link with the embedded system: round trip time, jitter, heartbeat loss
+ * and checksum errors, and whether the link is up. Every frame received counts as a sign of life, so a heartbeat is only sent
+ * when the link has been quiet for a whole interval, and every answered request gives a round trip time sample. An active
+ * game therefore costs little or no extra bandwidth.
+ *
+ * The link is declared down when nothing has been received for the link timeout, and up again on the next frame received.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef LINK_MONITOR_H
+#define LINK_MONITOR_H
+
+#include <chrono>
+#include <mutex>
+
+
+/**
+ * @brief Metrics of the link with the embedded system
+ *
+ */
+struct linkStatistics{
+
+    bool linkUp; ///<False once nothing was received for the link timeout
+    double roundTripTime; ///<Smoothed round trip time in microseconds
+    double jitter; ///<Smoothed variation between consecutive round trip times in microseconds
+    unsigned long roundTripSamples; ///<Number of round trips measured (answered heartbeats and requests)
+    unsigned long heartbeatsSent; ///<Number of heartbeats sent
+    unsigned long heartbeatsSuppressed; ///<Number of heartbeats not sent because other traffic was received
+    unsigned long heartbeatsLost; ///<Number of heartbeats that were not answered before the next one
+    double lossRate; ///<Fraction of the heartbeats sent that were lost
+    unsigned long framesReceived; ///<Number of frames received
+    unsigned long checksumErrors; ///<Number of frames received with a wrong checksum
+    double checksumErrorRate; ///<Fraction of the frames received with a wrong checksum
+    unsigned long linkDownEvents; ///<Number of times the link went down
+
+};
+
+
+/**
+ * @brief The LinkMonitor class measures the quality of the link and decides when a heartbeat must be sent. It is shared by
+ * the sending, receiving and heartbeat threads of the MessageHandler.
+ *
+ */
+class LinkMonitor{
+
+    //Declare LinkMonitor attributes
+    private:
+
+        //Properties:
+
+        /**
+         * @brief Metrics of the link
+         *
+         */
+        linkStatistics statistics;
+
+        /**
+         * @brief Time the last frame was received
+         *
+         */
+        std::chrono::steady_clock::time_point lastReceived;
+
+        /**
+         * @brief Time the last heartbeat was sent or suppressed, heartbeats are considered once per interval
+         *
+         */
+        std::chrono::steady_clock::time_point lastHeartbeat;
+
+        /**
+         * @brief Time the outstanding heartbeat was sent
+         *
+         */
+        std::chrono::steady_clock::time_point heartbeatSentTime;
+
+        /**
+         * @brief Sequence number of the last heartbeat sent
+         *
+         */
+        unsigned int heartbeatSequence;
+
+        /**
+         * @brief True while the last heartbeat sent has not been answered
+         *
+         */
+        bool heartbeatOutstanding;
+
+        /**
+         * @brief Last round trip time sample in microseconds, used to compute the jitter
+         *
+         */
+        double lastRoundTrip;
+
+        /**
+         * @brief Mutex used to protect the metrics, as they are updated from different threads
+         *
+         */
+        std::mutex monitorMutex;
+
+        /**
+         * @brief Adds a round trip time sample to the smoothed round trip time and jitter. Must be called with \ref monitorMutex held.
+         *
+         * @param microseconds -> Round trip time sample
+         */
+        void addRoundTrip(double microseconds);
+
+    public:
+
+        /**
+         * @brief Construct a new Link Monitor object, with the link up and no traffic seen yet
+         *
+         */
+        LinkMonitor();
+
+        /**
+         * @brief This function records a frame received from the embedded system
+         *
+         * @param checksumValid -> Whether the checksum of the frame was valid
+         * @return true -> If the link was down and is now up again
+         */
+        bool frameReceived(bool checksumValid);
+
+        /**
+         * @brief This function records the time taken by a request to be answered, so that regular traffic measures the link as well
+         *
+         * @param roundTrip -> Time between sending the request and receiving its response
+         */
+        void roundTrip(std::chrono::steady_clock::duration roundTrip);
+
+        /**
+         * @brief This function decides whether a heartbeat must be sent now. A heartbeat is sent once per interval, unless a frame
+         * was received during the interval. A heartbeat still outstanding when the next one is sent is counted as lost.
+         *
+         * @param now -> Current time
+         * @param interval -> Heartbeat interval
+         * @param sequence -> Set to the sequence number of the heartbeat to send
+         * @param force -> True to send the heartbeat even if a frame was received during the interval (used to sample the board clock)
+         * @return true -> If a heartbeat must be sent with the given sequence number
+         */
+        bool heartbeatDue(std::chrono::steady_clock::time_point now, std::chrono::steady_clock::duration interval, unsigned int &sequence, bool force = false);
+
+        /**
+         * @brief This function records the answer to a heartbeat
+         *
+         * @param sequence -> Sequence number echoed by the embedded system
+         * @param sentTime -> Set to the time the heartbeat was sent
+         * @return true -> If the answer is for the outstanding heartbeat
+         * @return false -> If the answer is for a heartbeat already counted as lost, it is then ignored
+         */
+        bool heartbeatAnswered(unsigned int sequence, std::chrono::steady_clock::time_point &sentTime);
+
+        /**
+         * @brief This function checks whether the link must be declared down
+         *
+         * @param now -> Current time
+         * @param timeout -> Time without any frame received after which the link is down
+         * @return true -> If the link was up and is now down
+         */
+        bool linkTimedOut(std::chrono::steady_clock::time_point now, std::chrono::steady_clock::duration timeout);
+
+        /**
+         * @brief Check whether the link is up
+         *
+         * @return true -> If a frame was received within the link timeout
+         */
+        bool isLinkUp();
+
+        /**
+         * @brief Get the metrics of the link
+         *
+         * @return linkStatistics -> Metrics of the link
+         */
+        linkStatistics getStatistics();
+
+};
+
+
+#endif /*LINK_MONITOR_H*/
@@ -0,0 +1,31 @@
+#-------------------------------------------------
+#
+# Allocation check of the games of a long match, built separately from the HMI
+#
+#-------------------------------------------------
+
+TARGET = MatchBench
+TEMPLATE = app
+
+CONFIG += console c++11
+CONFIG -= app_bundle qt
+
+LIBS += -lpthread
+
+SOURCES += \
+    matchbench.cpp \
+    game.cpp \
+    gameclock.cpp \
+    gamelog.cpp \
+    match.cpp \
+    goal.cpp \
+    LatencyProbe.cpp
+
+HEADERS += \
+    game.h \
+    gameclock.h \
+    gamelog.h \
+    match.h \
+    gameoutcome.h \
+    goal.h \
+    LatencyProbe.h
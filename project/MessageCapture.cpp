@@ -0,0 +1,171 @@
+/**
+ * @file MessageCapture.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the MessageCaptureWriter and MessageCaptureReader classes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "MessageCapture.h"
+
+#include <string.h>
+
+
+MessageCaptureWriter::MessageCaptureWriter(){
+    this->lastTimeStamp = 0;
+}
+
+
+MessageCaptureWriter::~MessageCaptureWriter(){
+    this->close();
+}
+
+
+void MessageCaptureWriter::writeVarint(unsigned long long value){
+
+    //Emit 7 bits at a time, setting the high bit on every byte except the last one
+    while(value >= 0x80){
+        this->captureFile.put((char)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+
+    this->captureFile.put((char)value);
+
+}
+
+
+bool MessageCaptureWriter::open(const std::string &fileName){
+
+    this->close();
+
+    this->captureFile.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!this->captureFile.is_open()){
+        return false;
+    }
+
+    //Write the header so that the reader can reject files that are not captures
+    this->captureFile.write(CAPTURE_MAGIC, strlen(CAPTURE_MAGIC));
+    this->captureFile.put((char)CAPTURE_VERSION);
+
+    this->captureStart = std::chrono::steady_clock::now();
+    this->lastTimeStamp = 0;
+
+    return true;
+
+}
+
+
+void MessageCaptureWriter::close(){
+
+    if(this->captureFile.is_open()){
+        this->captureFile.close();
+    }
+
+}
+
+
+void MessageCaptureWriter::record(unsigned int direction, const std::string &frame){
+
+    if(!this->captureFile.is_open()){
+        return;
+    }
+
+    unsigned long long timeStamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->captureStart).count();
+
+    //Both threads stamp frames, so guard against a record that was stamped just before the previous one was written
+    if(timeStamp < this->lastTimeStamp){
+        timeStamp = this->lastTimeStamp;
+    }
+
+    this->writeVarint(((timeStamp - this->lastTimeStamp) << 1) | (direction & 1));
+    this->writeVarint(frame.length());
+    this->captureFile.write(frame.data(), frame.length());
+
+    //Flush every record so that a capture taken in the field survives a crash of the HMI
+    this->captureFile.flush();
+
+    this->lastTimeStamp = timeStamp;
+
+}
+
+
+MessageCaptureReader::MessageCaptureReader(){
+    this->lastTimeStamp = 0;
+}
+
+
+bool MessageCaptureReader::readVarint(unsigned long long &value){
+
+    value = 0;
+    unsigned int shift = 0;
+
+    while(shift < 64){
+
+        int byte = this->captureFile.get();
+        if(byte == EOF){
+            return false;
+        }
+
+        value |= ((unsigned long long)(byte & 0x7F)) << shift;
+        if(!(byte & 0x80)){
+            return true;
+        }
+
+        shift += 7;
+    }
+
+    //More than 64 bits of data means the file is corrupted
+    return false;
+
+}
+
+
+bool MessageCaptureReader::open(const std::string &fileName){
+
+    this->captureFile.open(fileName.c_str(), std::ios::in | std::ios::binary);
+    if(!this->captureFile.is_open()){
+        return false;
+    }
+
+    //Check the header before accepting the file
+    char magic[sizeof(CAPTURE_MAGIC)] = {0};
+    this->captureFile.read(magic, strlen(CAPTURE_MAGIC));
+    int version = this->captureFile.get();
+
+    if(strcmp(magic, CAPTURE_MAGIC) != 0 || version != CAPTURE_VERSION){
+        this->captureFile.close();
+        return false;
+    }
+
+    this->lastTimeStamp = 0;
+
+    return true;
+
+}
+
+
+bool MessageCaptureReader::next(captureRecord &record){
+
+    unsigned long long header;
+    unsigned long long length;
+
+    if(!this->readVarint(header) || !this->readVarint(length)){
+        return false;
+    }
+
+    record.frame.resize(length);
+    this->captureFile.read(&record.frame[0], length);
+    if((unsigned long long)this->captureFile.gcount() != length){
+        return false;
+    }
+
+    this->lastTimeStamp += header >> 1;
+    record.timeStamp = this->lastTimeStamp;
+    record.direction = header & 1;
+
+    return true;
+
+}
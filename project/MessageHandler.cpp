@@ -14,28 +14,134 @@
 
 MessageHandler* MessageHandler::_instance = NULL;
 std::mutex MessageHandler::instantiateMutex;
+std::string MessageHandler::replayFileName = "";
+double MessageHandler::replaySpeed = 1.0;
+std::string MessageHandler::simulatorAddress = "";
+unsigned int MessageHandler::simulatedGoalDelayMin = 1000;
+unsigned int MessageHandler::simulatedGoalDelayMax = 5000;
+unsigned int MessageHandler::simulatedTelemetryPeriod = 0;
+unsigned int MessageHandler::heartbeatInterval = 1000;
+unsigned int MessageHandler::heartbeatMissedLimit = 3;
+unsigned int MessageHandler::responseTimeout = 2000;
+
+
+//Finds the board time a goal message was stamped with (the third value of the goal data, see ML_CAP_TIMESTAMPS)
+static bool findGoalTimestamp(const std::string &messageString, unsigned long &goalTimestamp){
+
+    std::string::size_type data = messageString.find(':');
+    if(data == std::string::npos || messageString.compare(0, data, M_EMB_SET_GOAL_DATA) != 0){
+        return false;
+    }
+
+    //The board time follows the side and the speed
+    std::string::size_type first = messageString.find(',', data);
+    std::string::size_type second = (first == std::string::npos) ? first : messageString.find(',', first + 1);
+    if(second == std::string::npos){
+        return false;
+    }
+
+    goalTimestamp = strtoul(messageString.c_str() + second + 1, NULL, 10);
+    return true;
+
+}
 
 MessageHandler::MessageHandler(){
     this->messageIDCount = 0;
     this->incomingQueue.empty();
-    this->outgoingQueue.empty();
-    this->unsolicitedQueue.empty();
 
-    //Lock the mutexes to be treated as Semaphores/Flags
-    this->outgoingMutex.lock();
-    this->incomingMutex.lock();
+    //Goals are never dropped, telemetry only keeps the latest data, and debug keeps the most recent messages
+    this->unsolicitedQueue.setCapacity(64);
+    this->unsolicitedQueue.setPolicy(QUEUE_POLICY_BLOCK);
+    this->channelQueue[ML_CHANNEL_TELEMETRY].setCapacity(8);
+    this->channelQueue[ML_CHANNEL_TELEMETRY].setPolicy(QUEUE_POLICY_KEEP_LATEST);
+    this->channelQueue[ML_CHANNEL_DEBUG].setCapacity(256);
+    this->channelQueue[ML_CHANNEL_DEBUG].setPolicy(QUEUE_POLICY_DROP_OLDEST);
 
-    //Begin the pipe to allow communication between threads for simulating USART/UART:
-    pipe(this->simulationPipeSend);
-    pipe(this->simulationPipeReceive);
-    
+    this->transport = NULL;
+    this->replayTransport = NULL;
+
+    //Until the handshake is done, the embedded system is assumed to only know the legacy protocol
+    this->linkProtocolVersion = ML_PROTOCOL_VERSION_LEGACY;
+    this->linkCapabilities = 0;
+    this->handshakePending = false;
+
+    //If a capture was selected for replay, it takes the place of the embedded system
+    if(!MessageHandler::replayFileName.empty()){
+
+        this->replayTransport = new ReplayTransport(MessageHandler::replayFileName, MessageHandler::replaySpeed);
+
+        if(this->replayTransport->isOpen()){
+            this->transport = this->replayTransport;
+        }
+        else{
+            std::cerr<<"ERROR> Could not open capture file "<<MessageHandler::replayFileName<<", using the simulation instead"<<std::endl;
+            delete this->replayTransport;
+            this->replayTransport = NULL;
+        }
+    }
+
+    //If a simulation runs in another process, the link to it takes the place of the simulation thread
+    if(this->transport == NULL && !MessageHandler::simulatorAddress.empty()){
+
+        const std::string &address = MessageHandler::simulatorAddress;
+
+        if(address.compare(0, 4, "shm:") == 0){
+
+            SharedMemoryTransport *sharedMemory = new SharedMemoryTransport(address.substr(4), false);
+
+            if(sharedMemory->isOpen()){
+                this->transport = sharedMemory;
+            }
+            else{
+                delete sharedMemory;
+            }
+        }
+        else if(address.compare(0, 5, "unix:") == 0){
+
+            int descriptor = SocketTransport::connectTo(address.substr(5));
+
+            if(descriptor >= 0){
+                this->transport = new SocketTransport(descriptor);
+            }
+        }
+
+        if(this->transport == NULL){
+            std::cerr<<"ERROR> Could not reach the simulation at "<<address<<", using the simulation thread instead"<<std::endl;
+        }
+    }
+
+    if(this->transport == NULL){
+
+        //Begin the pipe to allow communication between threads for simulating USART/UART:
+        pipe(this->simulationPipeSend);
+        pipe(this->simulationPipeReceive);
+
+        //The HMI reads the simulated Rx line and writes the simulated Tx line
+        this->transport = new PipeTransport(this->simulationPipeReceive[0], this->simulationPipeSend[1]);
+
+        this->embeddedSystemSimThread = std::thread(&MessageHandler::embeddedSystemSimulation, this);
+    }
 
 
 
     //Requires Exception throwing on error
     this->outgoingThread = std::thread(&MessageHandler::sendQueueMessagesThread, this);
     this->incomingThread = std::thread(&MessageHandler::receiveQueueMessagesThread, this);
-    this->embeddedSystemSimThread = std::thread(&MessageHandler::embeddedSystemSimulation, this);
+
+    //A replayed capture is not a live link, so it is not checked
+    if(this->replayTransport == NULL && MessageHandler::heartbeatInterval > 0){
+        this->heartbeatThread = std::thread(&MessageHandler::linkHeartbeatThread, this);
+    }
+
+    //Learn what the embedded system supports before any other message is sent. A capture is replayed without its
+    //handshake, as recorded with the capabilities of this library
+    if(this->replayTransport == NULL){
+        this->negotiateCapabilities();
+    }
+    else{
+        this->linkProtocolVersion = ML_PROTOCOL_VERSION;
+        this->linkCapabilities = ML_CAP_SUPPORTED;
+    }
     
 }
 
@@ -43,27 +149,18 @@ MessageHandler::MessageHandler(){
 void MessageHandler::sendQueueMessagesThread(){
     
 
-    while(1){
+    std::string sendString;
 
-        this->outgoingMutex.lock();
-        
-        //Need to check for errors here!
-        MessagePacket msgToSend = this->outgoingQueue.front();
-
-        this->outgoingQueue.pop();
+    while(1){
 
-        std::string sendString = msgToSend.getFullMessage();
+        //Wait for the next frame, chosen by priority among the channels
+        this->outgoingScheduler.pop(sendString);
 
-        //We need to convert the string that we are sending into a character array for piping and/or UART
-        unsigned int n = sendString.length();
-    
-        char charArraySend[n + 1];
-    
-        //copy the contents of the string to a char array
-        strcpy(charArraySend, sendString.c_str());
+        //The frame is recorded before it is sent, so that its response can never be recorded ahead of it
+        this->captureFrame(CAPTURE_DIRECTION_TX, sendString);
 
         //Send the contents of the string over UART or over a pipe:
-        write(this->simulationPipeSend[1], charArraySend, strlen(charArraySend));
+        this->transport->send(sendString);
 
     }
     
@@ -75,318 +172,183 @@ void MessageHandler::receiveQueueMessagesThread(){
     //Create a char array of max message length:
     char readMessage[100];
 
+    //Bytes read from the line that have not been split into frames yet
+    std::string streamBuffer;
+    std::string readString;
+
 
 
     while(1){
  
         //Wait to read the contents of the simulated UART
-        read(this->simulationPipeReceive[0], readMessage, 100);
-
-        
-
-        //Once a message has been read, we convert it into a string for processing
-        //When converting to a string, we iterate through each character until a null terminator is reached
-        std::string readString = ""; 
-        for (int i = 0; i < 100; i++) { 
-            readString = readString + readMessage[i];
-            if(readMessage[i] == '\0'){
-                break;
-            }
-        }
-
-        
-
-        //Create the a message packet corresponding to the read string
-        MessagePacket msgReceived(readString);
-
-        //Before pushing the message on the incoming queue, we must check if the message ID indicates that it was an unsolicited message
-        //That must go onto the unsolicited message queue!
-        if(msgReceived.getMessageID() == 100){
-            //If the message ID is 100, then we must pass the message onto the unsolicited queue
-            this->unsolicitedMutex.lock(); //Protected access to queue
-            unsolicitedQueue.push(msgReceived);
-            this->unsolicitedMutex.unlock(); //Protected access to queue
+        int bytesRead = this->transport->receive(readMessage, sizeof(readMessage));
+        if(bytesRead <= 0){
 
+            //A link closed by the other side keeps reporting it, so wait before retrying rather than spinning.
+            //The heartbeat reports the link as down in the meantime
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
         }
-        else{
-            //Push the message packet onto the received queue:
-            incomingQueue.push(msgReceived);
 
-            //Signal that the message has been received:
-            this->incomingMutex.unlock();
-        }
+        //A read may hold part of a frame or several frames, so they are split out of the accumulated stream
+        streamBuffer.append(readMessage, bytesRead);
 
-        
-
-    }
-
-}
-
-
-void MessageHandler::embeddedSystemSimulation(){
+        while(MessagePacket::extractFrame(streamBuffer, readString)){
 
-    //Create a char array of max message length:
-    char readMessage[100];
+            this->captureFrame(CAPTURE_DIRECTION_RX, readString);
 
-    //Set up the pipe here to be polling on read operations to emulate embedded system
-    fcntl( this->simulationPipeSend[0], F_SETFL, fcntl(this->simulationPipeSend[0], F_GETFL) | O_NONBLOCK);
+            //Create the a message packet corresponding to the read string
+            MessagePacket msgReceived(readString);
 
-    //Before beginning the simulation, we need to initialize system variables that the embedded system will have
-    //that represent or simulate the physical attributes of the real system
+            //Every frame received shows that the link is alive
+            if(this->linkMonitor.frameReceived(msgReceived.validateChecksum())){
 
-    int gameState = ML_INACTIVE;                //Initialize the air-hockey game as inactive
-    int aiState = ML_INACTIVE;                  //Initialize the AI state as inactive
-    int aiDifficulty = 0;                       //Initialize the AI difficulty to 0
-    int tableMode = ML_STANDARD;                //Initialize the table mode to Standard
-    int tableLighting = 0x000000;               //initialize the table lighting to off (RGB hex value)
-    int tableAirSpeed = 50;                     //Initialize the table air speed to 50%
+                //The embedded system may have been restarted with other firmware, so the next request negotiates again, and
+                //its clock is sampled again
+                this->handshakePending = true;
+                this->clockSync.reset();
+                this->notifyLinkState(true);
+            }
 
-    //Seed RNG for determining when a goal has been scored:
-    srand(time(NULL));
+            //Heartbeat answers are only used to measure the link
+            if(msgReceived.getMessageID() == ML_HEARTBEAT_MESSAGE_ID){
 
-    //Below, we define a MAXIMUM time that we would like the air-hockey game to sleep prior to generating a random goal
-    //The sleep time is stored as a value in seconds and can be tuned
-    int maxSleep = 5;
-    //sleep((rand() % maxSleep) + 1);
-    int i = 0;
-    unsigned int nextGoalTime = (rand() % maxSleep) + 1;
-    int counter = 0;
+                std::chrono::steady_clock::time_point receivedTime = std::chrono::steady_clock::now();
+                std::chrono::steady_clock::time_point sentTime;
 
-    while(1){
+                std::string tokenData = msgReceived.getMessageString();
+                tokenData.erase(0, tokenData.find(':') + 1);
 
-        //If the game is in an inactive state, then we only listen for messages from the main RaspberryPi
-        if(gameState != ML_ACTIVE){
+                bool answered = this->linkMonitor.heartbeatAnswered((unsigned int)strtoul(tokenData.c_str(), NULL, 10), sentTime);
 
-            counter = 0;
-            //Wait to read the contents of the simulated UART
-            while(1){
-                i = read(this->simulationPipeSend[0], readMessage, 100);
-                if(i != -1){
-                    break;
+                //A stamped answer is a sample of the board clock
+                std::string::size_type comma = tokenData.find(',');
+                if(answered && comma != std::string::npos){
+                    this->clockSync.addSample(sentTime, receivedTime, (uint32_t)strtoul(tokenData.c_str() + comma + 1, NULL, 10));
                 }
+                continue;
+            }
 
-                //Sleep this thread to simulate the response time of an embedded system ==> 100ms
-                usleep(100000);
-            } 
-            
-        }
-        else{
-            //If the game is in an ACTIVE state, then we generate random goals and send them at random time intervals
-            //while simultaneously polling for received messages:
+            //Before pushing the message on the incoming queue, we must check the channel of the message. Each channel has its own
+            //queue, so that a burst of telemetry never delays a goal or a response
+            if(msgReceived.getChannel() == ML_CHANNEL_EVENTS){
+                //Unsolicited events, such as goals, must go onto the unsolicited queue (waits here while the queue is full)
+                this->unsolicitedQueue.push(msgReceived);
 
+                //The goal is named by its board time for latency measurements, which is only looked for while measuring
+                unsigned long goalTimestamp;
+                if(LatencyProbe::instance().isEnabled() && findGoalTimestamp(msgReceived.getMessageString(), goalTimestamp)){
 
-            while(1){
+                    //Once the board clock is sampled, the board time also tells when the goal was emitted, unless the
+                    //simulation in this process already marked it
+                    std::chrono::steady_clock::time_point emittedTime;
+                    if(this->boardTicksToSteady((unsigned int)goalTimestamp, emittedTime)){
+                        LatencyProbe::instance().markAt(LATENCY_STAGE_EMITTED, goalTimestamp, emittedTime);
+                    }
 
-                i = read(this->simulationPipeSend[0], readMessage, 100);
-                if(i != -1){
-                    break;
+                    LatencyProbe::instance().mark(LATENCY_STAGE_RECEIVED, goalTimestamp);
                 }
 
-                if((unsigned int)(counter*0.1) >= nextGoalTime){
+            }
+            else if(msgReceived.getChannel() == ML_CHANNEL_CONTROL){
+                //Push the message packet onto the received queue:
+                this->incomingMutex.lock(); //Protected access to queue
+                incomingQueue.push(msgReceived);
+                this->incomingMutex.unlock(); //Protected access to queue
+
+                //Signal that the message has been received:
+                this->responseAvailable.notify_one();
+            }
+            else{
+                //The queue of the channel drops stale messages when full
+                this->channelQueue[msgReceived.getChannel()].push(msgReceived);
+            }
 
-                    int goalSide = (rand() % 2);
-                    int goalSpeed = (rand() % 100) + 1;
+        }
 
-                    std::string stringToSend = M_EMB_SET_GOAL_DATA;
-                    stringToSend += ":" + std::to_string(goalSide) + "," + std::to_string(goalSpeed);
-                    MessagePacket msgTmp(stringToSend, 100); //Use a messageID of 100 in order to indicate that it is an unsolicited goal message
+    }
 
-                    //Now, we return a response to the sent message:
-                    std::string sendString = msgTmp.getFullMessage();
+}
 
 
-                    //We need to convert the string that we are sending into a character array for piping and/or UART
-                    unsigned int n = sendString.length();
-                
-                    char charArraySend[n + 1];
-                
-                    //copy the contents of the string to a char array
-                    strcpy(charArraySend, sendString.c_str());
+void MessageHandler::embeddedSystemSimulation(){
 
+    //The simulated embedded system reads the Tx line of the HMI and writes to its Rx line
+    PipeTransport simulationLink(this->simulationPipeSend[0], this->simulationPipeReceive[1]);
 
-                    //Send the contents of the string over UART or over a pipe:
-                    write(this->simulationPipeReceive[1], charArraySend, strlen(charArraySend));
+    //The simulated table holds the system variables that the embedded system will have
+    EmbeddedSimulator simulator;
+    simulator.setGoalDelay(MessageHandler::simulatedGoalDelayMin, MessageHandler::simulatedGoalDelayMax);
+    simulator.setTelemetryPeriod(MessageHandler::simulatedTelemetryPeriod);
 
-                    //Below, we generate a time at which we will generate a goal while the game mode is active:
-                    nextGoalTime = (rand() % maxSleep) + 1;
-                    counter = 0;
-                }
+    //Seed RNG for determining when a goal has been scored:
+    srand(time(NULL));
 
-                
+    //The pipes are never closed, so the simulation runs for the life of the HMI
+    simulator.run(simulationLink);
 
-                //Sleep this thread to simulate the response time of an embedded system ==> 100ms
-                usleep(100000);
-                counter++;
-            } 
-            
+}
 
-            
 
-        }
+void MessageHandler::linkHeartbeatThread(){
 
-        
+    std::chrono::steady_clock::duration interval = std::chrono::milliseconds(MessageHandler::heartbeatInterval);
+    std::chrono::steady_clock::duration timeout = interval * MessageHandler::heartbeatMissedLimit;
 
-        //Once a message has been read, we convert it into a string for processing
-        //When converting to a string, we iterate through each character until a null terminator is reached
-        std::string readString = ""; 
-        for (int i = 0; i < 100; i++) { 
-            readString = readString + readMessage[i];
-            if(readMessage[i] == '\0'){
-                break;
-            }
-        }
+    //The link is checked several times per interval, which bounds how late the link-down is detected
+    std::chrono::steady_clock::duration checkPeriod = interval / 4;
 
-        //Create the a message packet corresponding to the read string
-        MessagePacket msgReceived(readString);
+    unsigned int sequence = 0;
 
-        //Perform necessary parsing to identify what to do with the message
-        //Create a string to compare when parsing
-        std::string tokenMsg;
-        std::string tokenData;
+    while(1){
 
-        //Convert the read data line into a stream that we can tokenize as an input
-        std::istringstream stream(msgReceived.getMessageString());
+        std::this_thread::sleep_for(checkPeriod);
 
-        //First, we parse the string to get the token corresponding to the message string:
-        getline(stream, tokenMsg, ':'); //Get message for now, assuming only message
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
 
-        //Prior to performing full processing on the token received, we must check whether it is a getter or setter
-        //message in order to identify whether any additional information is required
-        if(msgReceived.getMessageString().find(SETTER_STRING) != std::string::npos){
-            //If we are dealing with a setter message, then we must read the data coming along with the message
-            getline(stream, tokenData, '<'); //Get message for now, assuming only message
+        //Firmware without heartbeats cannot be told apart from a dead link when it is quiet, so the link is not checked
+        if(!this->hasCapability(ML_CAP_HEARTBEAT)){
+            continue;
         }
 
-        //Based on the received message, decide how to respond and what simulation values to alter/change!
-        MessagePacket msgReturn;
-
-
-        //Prior to processing the message, we must ensure that the checksums match:
-        if(!msgReceived.validateChecksum()){
-        
-            std::string stringToSend = "ERROR! NONMATCHING CHECKSUMS";
-            MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
-            msgReturn = msgTmp;
-
-        }
+        //The board clock is sampled on a schedule of its own, so those heartbeats are sent even when the link is busy
+        bool clockSampleDue = this->hasCapability(ML_CAP_TIMESTAMPS) && this->clockSync.sampleDue(now);
 
-        //Process the message based on the token received
-        if(tokenMsg == M_RPI_GET_AI_DIFFICULTY){
-            std::string stringToSend = M_RPI_GET_AI_DIFFICULTY;
-            MessagePacket msgTmp(stringToSend + ":" + std::to_string(aiDifficulty), msgReceived.getMessageID());
-            msgReturn = msgTmp;
-        }
-        else if(tokenMsg == M_RPI_GET_AI_ACTIVE_STATE){
-            std::string stringToSend = M_RPI_GET_AI_ACTIVE_STATE;
-            MessagePacket msgTmp(stringToSend + ":" + std::to_string(aiState), msgReceived.getMessageID());
-            msgReturn = msgTmp;
-        }
-        else if(tokenMsg == M_RPI_GET_GAME_ACTIVE_STATE){
-            std::string stringToSend = M_RPI_GET_GAME_ACTIVE_STATE;
-            MessagePacket msgTmp(stringToSend + ":" + std::to_string(gameState), msgReceived.getMessageID());
-            msgReturn = msgTmp;
-        }
-        else if(tokenMsg == M_RPI_GET_TABLE_MODE){
-            std::string stringToSend = M_RPI_GET_TABLE_MODE;
-            MessagePacket msgTmp(stringToSend + ":" + std::to_string(tableMode), msgReceived.getMessageID());
-            msgReturn = msgTmp;
-        }
-        else if(tokenMsg == M_RPI_GET_TABLE_LIGHTING){
-            std::string stringToSend = M_RPI_GET_TABLE_LIGHTING;
-            MessagePacket msgTmp(stringToSend + ":" + std::to_string(tableLighting), msgReceived.getMessageID());
-            msgReturn = msgTmp;
-        }
-        else if(tokenMsg == M_RPI_GET_TABLE_AIR_SPEED){
-            std::string stringToSend = M_RPI_GET_TABLE_AIR_SPEED;
-            MessagePacket msgTmp(stringToSend + ":" + std::to_string(tableAirSpeed), msgReceived.getMessageID());
-            msgReturn = msgTmp;
-        }
-        else if(tokenMsg == M_RPI_SET_AI_DIFFICULTY){
-            //Convert our token into a string stream and then pipe it into an integer:
-            std::istringstream mData(tokenData);
-            mData >> aiDifficulty;
-            //Return the same message that was sent, without data:
-            std::string stringToSend = M_RPI_SET_AI_DIFFICULTY;
-            MessagePacket msgTmp(stringToSend + ":1", msgReceived.getMessageID());
-            msgReturn = msgTmp;
+        if(this->linkMonitor.heartbeatDue(now, interval, sequence, clockSampleDue)){
 
-        }
-        else if(tokenMsg == M_RPI_SET_AI_ACTIVE_STATE){
-            //Convert our token into a string stream and then pipe it into an integer:
-            std::istringstream mData(tokenData);
-            mData >> aiState;
-            //Return the same message that was sent, without data:
-            std::string stringToSend = M_RPI_SET_AI_ACTIVE_STATE;
-            MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
-            msgReturn = msgTmp;
+            MessagePacket heartbeat(std::string(M_RPI_GET_HEARTBEAT) + ":" + std::to_string(sequence), ML_HEARTBEAT_MESSAGE_ID);
 
+            //A heartbeat that does not fit is simply not sent, the link is then checked on the next interval
+            this->outgoingScheduler.push(ML_CHANNEL_CONTROL, heartbeat.getFullMessage(), false);
         }
-        else if(tokenMsg == M_RPI_SET_GAME_ACTIVE_STATE){
-            //Convert our token into a string stream and then pipe it into an integer:
-            std::istringstream mData(tokenData);
-            mData >> gameState;
-            //Return the same message that was sent, without data:
-            std::string stringToSend = M_RPI_SET_GAME_ACTIVE_STATE;
-            MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
-            msgReturn = msgTmp;
 
+        if(this->linkMonitor.linkTimedOut(now, timeout)){
+            this->notifyLinkState(false);
         }
-        else if(tokenMsg == M_RPI_SET_TABLE_MODE){
-            //Convert our token into a string stream and then pipe it into an integer:
-            std::istringstream mData(tokenData);
-            mData >> tableMode;
-            //Return the same message that was sent, without data:
-            std::string stringToSend = M_RPI_SET_TABLE_MODE;
-            MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
-            msgReturn = msgTmp;
+    }
 
-        }
-        else if(tokenMsg == M_RPI_SET_TABLE_LIGHTING){
-            //Convert our token into a string stream and then pipe it into an integer:
-            std::istringstream mData(tokenData);
-            mData >> tableLighting;
-            //Return the same message that was sent, without data:
-            std::string stringToSend = M_RPI_SET_TABLE_LIGHTING;
-            MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
-            msgReturn = msgTmp;
+}
 
-        }
-        else if(tokenMsg == M_RPI_SET_TABLE_AIR_SPEED){
-            //Convert our token into a string stream and then pipe it into an integer:
-            std::istringstream mData(tokenData);
-            mData >> tableAirSpeed;
-            //Return the same message that was sent, without data:
-            std::string stringToSend = M_RPI_SET_TABLE_AIR_SPEED;
-            MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
-            msgReturn = msgTmp;
 
-        }
-        else{
-            std::string stringToSend = "ERROR! UNRECOGNIZED MESSAGE";
-            MessagePacket msgTmp(stringToSend + ":", msgReceived.getMessageID());
-            msgReturn = msgTmp;
-        }
+void MessageHandler::notifyLinkState(bool linkUp){
 
-        //Now, we return a response to the sent message:
-        std::string sendString = msgReturn.getFullMessage();
+    std::lock_guard<std::mutex> lock(this->callbackMutex);
 
+    if(this->linkStateCallback){
+        this->linkStateCallback(linkUp);
+    }
 
-        //We need to convert the string that we are sending into a character array for piping and/or UART
-        unsigned int n = sendString.length();
-    
-        char charArraySend[n + 1];
-    
-        //copy the contents of the string to a char array
-        strcpy(charArraySend, sendString.c_str());
+}
 
 
-        //Send the contents of the string over UART or over a pipe:
-        write(this->simulationPipeReceive[1], charArraySend, strlen(charArraySend));
+void MessageHandler::setLinkStateCallback(std::function<void(bool)> callback){
 
-    }
+    std::lock_guard<std::mutex> lock(this->callbackMutex);
+    this->linkStateCallback = callback;
 
 }
 
+
 MessageHandler& MessageHandler::instance(){
     
     //After we check if _instance has been set, we lock the mutex. This is important
@@ -411,15 +373,122 @@ MessageHandler& MessageHandler::instance(){
 }
 
 
-std::vector<int> MessageHandler::sendMessage(std::string message, std::string arguements){
+void MessageHandler::setReplaySource(const std::string &fileName, double speed){
 
-    std::vector<int> vectReturn;
+    MessageHandler::replayFileName = fileName;
+    MessageHandler::replaySpeed = speed;
 
-    //First, we must construct the message with the arguements provided
-    std::string messageString = message + ":" + arguements;
+}
 
-    //Pass the contructed message string into a MessagePacket object
-    MessagePacket msgToSend(messageString, this->messageIDCount);
+
+void MessageHandler::setSimulatedGoalDelay(unsigned int minimum, unsigned int maximum){
+
+    MessageHandler::simulatedGoalDelayMin = minimum;
+    MessageHandler::simulatedGoalDelayMax = maximum;
+
+}
+
+
+void MessageHandler::setSimulatorAddress(const std::string &address){
+
+    MessageHandler::simulatorAddress = address;
+
+}
+
+
+void MessageHandler::setSimulatedTelemetryPeriod(unsigned int period){
+
+    MessageHandler::simulatedTelemetryPeriod = period;
+
+}
+
+
+void MessageHandler::setHeartbeatInterval(unsigned int interval, unsigned int missedLimit){
+
+    MessageHandler::heartbeatInterval = interval;
+    MessageHandler::heartbeatMissedLimit = (missedLimit > 0) ? missedLimit : 1;
+
+}
+
+
+void MessageHandler::setResponseTimeout(unsigned int timeout){
+
+    MessageHandler::responseTimeout = timeout;
+
+}
+
+
+bool MessageHandler::startCapture(const std::string &fileName){
+
+    std::lock_guard<std::mutex> lock(this->captureMutex);
+    return this->captureWriter.open(fileName);
+
+}
+
+
+void MessageHandler::stopCapture(){
+
+    std::lock_guard<std::mutex> lock(this->captureMutex);
+    this->captureWriter.close();
+
+}
+
+
+void MessageHandler::captureFrame(unsigned int direction, const std::string &frame){
+
+    std::lock_guard<std::mutex> lock(this->captureMutex);
+    this->captureWriter.record(direction, frame);
+
+}
+
+
+replayStatistics MessageHandler::getReplayStatistics(){
+
+    if(this->replayTransport != NULL){
+        return this->replayTransport->getStatistics();
+    }
+
+    replayStatistics statistics = {0, 0, 0, 0, true};
+    return statistics;
+
+}
+
+
+bool MessageHandler::negotiateCapabilities(){
+
+    this->handshakePending = false;
+
+    std::vector<int> result = this->exchangeMessage(M_RPI_GET_CAPABILITIES, std::to_string(ML_PROTOCOL_VERSION) + "," + std::to_string(ML_CAP_SUPPORTED), ML_HANDSHAKE_MESSAGE_ID);
+
+    if(result[0] == -4){
+        //No answer, the capabilities are kept as they were and negotiated again on the next request
+        this->handshakePending = true;
+        return false;
+    }
+
+    if(result[0] >= 0 && result.size() >= 3 && result[1] > ML_PROTOCOL_VERSION_LEGACY){
+        this->linkProtocolVersion = (unsigned int)result[1];
+        this->linkCapabilities = (unsigned int)result[2] & ML_CAP_SUPPORTED;
+    }
+    else{
+        //The firmware does not know the handshake
+        this->linkProtocolVersion = ML_PROTOCOL_VERSION_LEGACY;
+        this->linkCapabilities = 0;
+    }
+
+    return true;
+
+}
+
+
+std::vector<int> MessageHandler::sendMessage(std::string message, std::string arguements){
+
+    if(this->handshakePending && !this->negotiateCapabilities()){
+        //The embedded system did not answer the handshake, so it would not answer the message either
+        return std::vector<int>(1, -4);
+    }
+
+    unsigned int messageID = this->messageIDCount;
 
     //Needs to be mutex protected
     this->messageIDCount++;
@@ -427,29 +496,61 @@ std::vector<int> MessageHandler::sendMessage(std::string message, std::string ar
         this->messageIDCount = 0;  //Wrap the message count once we reach 99 messages.
     }
 
+    return this->exchangeMessage(message, arguements, messageID);
+
+}
+
+
+std::vector<int> MessageHandler::exchangeMessage(std::string message, std::string arguements, unsigned int messageID){
+
+    std::vector<int> vectReturn;
+
+    //First, we must construct the message with the arguements provided
+    std::string messageString = message + ":" + arguements;
+
+    //Pass the contructed message string into a MessagePacket object
+    MessagePacket msgToSend(messageString, messageID);
+
     //Could be formed as a vector so we can have any number of messges waiting for a response
     this->waitingMessage = msgToSend;
 
-    //Put the message to send onto the queue and then signal the thread to send the message
-    //It is assumed that the main program will be hosted in a single thread, and such the sending queue
-    //Is not mutex protected ==> Should be mutex protected if multiple threads in main program leading to
-    //Multiple calls to sendMessage (ALSO, would require a counting semaphore for message notifications)
+    //Put the message to send onto the control channel, the sending thread is woken up by the scheduler
+    //It is assumed that the main program will be hosted in a single thread, as messageIDCount is not protected
+    std::chrono::steady_clock::time_point sendTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point deadline = sendTime + std::chrono::milliseconds(MessageHandler::responseTimeout);
 
-    
+    this->outgoingScheduler.push(ML_CHANNEL_CONTROL, this->waitingMessage.getFullMessage());
 
-    outgoingQueue.push(this->waitingMessage);
-    this->outgoingMutex.unlock(); //Needs to be a counting semaphore here IF multiple threads can send messages
+    //Wait here until the response to the message was received, or the board is considered gone:
+    MessagePacket msgReceived;
+    bool responseReceived = false;
 
-    //Wait here until a message was received:
-    this->incomingMutex.lock();
+    std::unique_lock<std::mutex> lock(this->incomingMutex);
 
-    
+    while(!responseReceived){
 
-    //Get the message received: Check for errors here
-    MessagePacket msgReceived = this->incomingQueue.front();
-    this->incomingQueue.pop();
+        //Responses to earlier messages that timed out arrive late, and are discarded
+        while(!this->incomingQueue.empty()){
 
-    
+            msgReceived = this->incomingQueue.front();
+            this->incomingQueue.pop();
+
+            if(msgReceived.getMessageID() == msgToSend.getMessageID()){
+                responseReceived = true;
+                break;
+            }
+        }
+
+        if(!responseReceived && this->responseAvailable.wait_until(lock, deadline) == std::cv_status::timeout && this->incomingQueue.empty()){
+            vectReturn.push_back(-4);
+            return vectReturn;
+        }
+    }
+
+    lock.unlock();
+
+    //Answered requests measure the link as well as heartbeats do
+    this->linkMonitor.roundTrip(std::chrono::steady_clock::now() - sendTime);
 
     //Perform error checking
     if(msgReceived.getMessageString().find("ERROR") != std::string::npos){
@@ -487,28 +588,28 @@ std::vector<int> MessageHandler::sendMessage(std::string message, std::string ar
 }
 
 
+unsigned long MessageHandler::unsolicitedQueueClear(){
+
+    //The goals of the game before are not counted as drops, they were delivered while no game was taking them
+    return this->unsolicitedQueue.clear();
+
+}
+
+
 std::vector<int> MessageHandler::unsolicitedQueueGet(){
 
     std::vector<int> vectReturn;
 
-    //First, we check if there is anything on the queue:
-    this->unsolicitedMutex.lock(); //Protected access to queue
+    //First, we check if there is anything on the queue, and if so we get the next message on it for processing:
+    MessagePacket msgReceived;
 
-    //Check if the unsolicitedQueue is empty
-    if(this->unsolicitedQueue.empty()){
+    if(!this->unsolicitedQueue.tryPop(msgReceived)){
         
         //If the unsolicited queue is empty, then we return in error
-        this->unsolicitedMutex.unlock(); //Unlock the queue before returning in error
         vectReturn.push_back(-1);
         return vectReturn;
     }
 
-    //If the queue is not empty, then we get the next message on it for processing:
-    MessagePacket msgReceived = this->unsolicitedQueue.front();
-    this->unsolicitedQueue.pop();
-
-    this->unsolicitedMutex.unlock(); //Protected access to queue
-
     //Now, we can process the unsolicited message for the values received:
 
     //Perform necessary parsing to identify what to do with the message
@@ -557,6 +658,15 @@ std::vector<int> MessageHandler::unsolicitedQueueGet(){
 
         vectReturn.push_back(goalSide);
         vectReturn.push_back(goalSpeed);
+
+        //With ML_CAP_TIMESTAMPS, the goal also carries the board time when it was scored
+        int goalTimestamp = 0;
+        if(mData >> comma >> goalTimestamp){
+            vectReturn.push_back(goalTimestamp);
+
+            LatencyProbe::instance().mark(LATENCY_STAGE_DEQUEUED, (unsigned long)goalTimestamp);
+        }
+
         return vectReturn;
 
     }
@@ -567,4 +677,76 @@ std::vector<int> MessageHandler::unsolicitedQueueGet(){
     }
 
 
+}
+
+
+bool MessageHandler::postMessage(std::string message, std::string arguements, unsigned int channel){
+
+    if(channel >= ML_CHANNEL_COUNT){
+        return false;
+    }
+
+    //Firmware without channels would read the channel as part of the message ID
+    if(channel != ML_CHANNEL_CONTROL && !this->hasCapability(ML_CAP_CHANNELS)){
+        return false;
+    }
+
+    //No response is expected, so the message is sent with the unsolicited message ID
+    MessagePacket msgToSend(message + ":" + arguements, ML_UNSOLICITED_MESSAGE_ID, channel);
+
+    return this->outgoingScheduler.push(channel, msgToSend.getFullMessage(), false);
+
+}
+
+
+bool MessageHandler::channelQueueGet(unsigned int channel, MessagePacket &message){
+
+    if(channel != ML_CHANNEL_TELEMETRY && channel != ML_CHANNEL_DEBUG){
+        return false;
+    }
+
+    return this->channelQueue[channel].tryPop(message);
+
+}
+
+
+BoundedMessageQueue* MessageHandler::receivedQueue(unsigned int channel){
+
+    if(channel == ML_CHANNEL_EVENTS){
+        return &this->unsolicitedQueue;
+    }
+    else if(channel == ML_CHANNEL_TELEMETRY || channel == ML_CHANNEL_DEBUG){
+        return &this->channelQueue[channel];
+    }
+
+    return NULL;
+
+}
+
+
+bool MessageHandler::setChannelQueueCapacity(unsigned int channel, unsigned long capacity){
+
+    BoundedMessageQueue *queue = this->receivedQueue(channel);
+
+    if(queue == NULL){
+        return false;
+    }
+
+    queue->setCapacity(capacity);
+    return true;
+
+}
+
+
+queueStatistics MessageHandler::getChannelQueueStatistics(unsigned int channel){
+
+    BoundedMessageQueue *queue = this->receivedQueue(channel);
+
+    if(queue == NULL){
+        queueStatistics statistics = {0, 0, 0, 0, 0};
+        return statistics;
+    }
+
+    return queue->getStatistics();
+
 }
\ No newline at end of file
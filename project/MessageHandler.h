@@ -23,16 +23,31 @@
 #include <sstream>
 #include <queue>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <vector>
 #include <thread>
 #include <iostream>
+#include <chrono>
+#include <atomic>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <string.h>
 #include <stdlib.h>     /* srand, rand */
 #include <time.h>       /* time */
 #include "MessageLibrary.h"
 #include "MessagePacket.h"
+#include "MessageTransport.h"
+#include "MessageCapture.h"
+#include "ReplayTransport.h"
+#include "EmbeddedSimulator.h"
+#include "ChannelScheduler.h"
+#include "BoundedMessageQueue.h"
+#include "LinkMonitor.h"
+#include "ClockSync.h"
+#include "SharedMemoryTransport.h"
+#include "LatencyProbe.h"
 
 
 /**
@@ -75,16 +90,26 @@ class MessageHandler{
         std::queue<MessagePacket> incomingQueue;
 
         /**
-         * @brief Queue used for handling multiple unsolicited messages simultaneously
+         * @brief Queue used for handling multiple unsolicited messages simultaneously. Goals must never be lost, so the queue
+         * applies backpressure when full: the receiving thread waits for the GUI to take a goal before reading the link again.
+         * The GUI puts the table in the inactive game state as soon as a game is over, so goals only arrive while they are taken
          * 
          */
-        std::queue<MessagePacket> unsolicitedQueue;
+        BoundedMessageQueue unsolicitedQueue;
 
         /**
-         * @brief Queue used if multiple messages are being sent simultaneously
+         * @brief Queues used for the messages received on the telemetry and debug channels, indexed by channel
+         * (control and event messages use \ref incomingQueue and \ref unsolicitedQueue). Telemetry only keeps the latest data,
+         * while debug keeps the most recent messages
          * 
          */
-        std::queue<MessagePacket> outgoingQueue;
+        BoundedMessageQueue channelQueue[ML_CHANNEL_COUNT];
+
+        /**
+         * @brief Frames waiting to be sent, queued per channel and sent by priority (see \ref ChannelScheduler.h)
+         * 
+         */
+        ChannelScheduler outgoingScheduler;
 
         /**
          * @brief Thread used for sending messages to the embedded system
@@ -105,34 +130,151 @@ class MessageHandler{
         std::thread embeddedSystemSimThread;
 
         /**
-         * @brief Pipe used to simulate the USART Tx line
+         * @brief Thread used for sending heartbeats and detecting when the link goes down
          * 
          */
-        int simulationPipeSend[2];
+        std::thread heartbeatThread;
 
         /**
-         * @brief Pipe used to simulate the USART Rx line
+         * @brief Metrics of the link with the embedded system, updated by the sending, receiving and heartbeat threads
          * 
          */
-        int simulationPipeReceive[2];
+        LinkMonitor linkMonitor;
+
+        /**
+         * @brief Estimate of the board clock, sampled by the heartbeats when the embedded system stamps its answers (\ref ML_CAP_TIMESTAMPS)
+         * 
+         */
+        ClockSync clockSync;
+
+        /**
+         * @brief Function called when the link goes down or comes back up (empty if none)
+         * 
+         */
+        std::function<void(bool)> linkStateCallback;
+
+        /**
+         * @brief Mutex used to protect the link state callback
+         * 
+         */
+        std::mutex callbackMutex;
+
+        /**
+         * @brief Protocol version of the embedded system, learned by the capability handshake
+         * 
+         */
+        std::atomic<unsigned int> linkProtocolVersion;
+
+        /**
+         * @brief Capabilities (ML_CAP bitmask) that both the HMI and the embedded system support, cached for the life of the link
+         * 
+         */
+        std::atomic<unsigned int> linkCapabilities;
+
+        /**
+         * @brief Set while the capabilities must be negotiated again, because the handshake got no answer or the link came back up
+         * (the embedded system may have been restarted with other firmware)
+         * 
+         */
+        std::atomic<bool> handshakePending;
+
+        /**
+         * @brief Link used to exchange frames with the embedded system (simulated pipes, or a replayed capture)
+         * 
+         */
+        MessageTransport *transport;
+
+        /**
+         * @brief Set when the link is a replayed capture, used to report the progress of the replay
+         * 
+         */
+        ReplayTransport *replayTransport;
+
+        /**
+         * @brief Writer used to record every frame sent and received while a capture is running
+         * 
+         */
+        MessageCaptureWriter captureWriter;
+
+        /**
+         * @brief Mutex used to protect the capture writer, which is shared by the sending and receiving threads
+         * 
+         */
+        std::mutex captureMutex;
+
+        /**
+         * @brief Capture file to replay instead of running the embedded system simulation (empty if none)
+         * 
+         */
+        static std::string replayFileName;
+
+        /**
+         * @brief Speed at which \ref replayFileName is replayed
+         * 
+         */
+        static double replaySpeed;
+
+        /**
+         * @brief Address of an embedded system simulation running in another process (empty to run the simulation in a thread)
+         * 
+         */
+        static std::string simulatorAddress;
+
+        /**
+         * @brief Shortest and longest time in milliseconds between two goals of the embedded system simulation
+         * 
+         */
+        static unsigned int simulatedGoalDelayMin;
+        static unsigned int simulatedGoalDelayMax;
+
+        /**
+         * @brief Time in milliseconds between two telemetry messages of the embedded system simulation (0 = no telemetry)
+         * 
+         */
+        static unsigned int simulatedTelemetryPeriod;
+
+        /**
+         * @brief Time in milliseconds between two heartbeats on a quiet link (0 = no heartbeats)
+         * 
+         */
+        static unsigned int heartbeatInterval;
+
+        /**
+         * @brief Number of heartbeat intervals without any frame received after which the link is down
+         * 
+         */
+        static unsigned int heartbeatMissedLimit;
 
         /**
-         * @brief Mutex used as a flag to identify when a message is ready to send
+         * @brief Time in milliseconds that \ref sendMessage waits for a response
          * 
          */
-        std::mutex outgoingMutex;
+        static unsigned int responseTimeout;
 
         /**
-         * @brief Mutex used as a flag to identify when a message has been received
+         * @brief Pipe used to simulate the USART Tx line
+         * 
+         */
+        int simulationPipeSend[2];
+
+        /**
+         * @brief Pipe used to simulate the USART Rx line
+         * 
+         */
+        int simulationPipeReceive[2];
+
+        /**
+         * @brief Mutex used to protect access to the incoming queue
          * 
          */
         std::mutex incomingMutex;
 
         /**
-         * @brief Mutex used to protect access to the unsolicited queue
+         * @brief Signalled when a response is put on the incoming queue
          * 
          */
-        std::mutex unsolicitedMutex;
+        std::condition_variable responseAvailable;
+
 
         /**
          * @brief Mutex used for thread-safe Singleton creation
@@ -162,8 +304,8 @@ class MessageHandler{
 
         /**
          * @brief The sendQueueMessagesThread is responsible for operating as a thread that sends messages to
-         * the embedded system. When a message is available to send, it receives a notification through the
-         * outgoingMutex and then takes the next message to send from the outgoingQueue. For simulation purposes,
+         * the embedded system. When a message is available to send, it takes the next frame chosen by the
+         * outgoingScheduler, so that control and event frames are never stuck behind bulk telemetry. For simulation purposes,
          * the message is sent through a Pipe as the Tx line.
          * 
          */
@@ -172,8 +314,11 @@ class MessageHandler{
         /**
          * @brief The receiveQueueMessagesThread is responsible for operating as a thread that receives messages from
          * the embedded system. When a message is receives, it receives a notification through the
-         * pipe, simulationPipeReceive, and then takes the recieved message, and puts it on the incomingQueue.
-         * The thread also notifies that it has put a received message on the queue using incomingMutex. It is noted
+         * pipe, simulationPipeReceive, and then takes the recieved message, and puts it on the queue of its channel.
+         * Responses go on the incomingQueue, and the thread notifies that it has put a received message on the queue using responseAvailable.
+         * Heartbeat answers are handed to the linkMonitor, and every frame received counts as a sign of life of the link.
+         * Events go on the unsolicitedQueue, while telemetry and debug messages go on their channelQueue. While the unsolicitedQueue
+         * is full, the thread waits for the GUI to take a goal rather than drop it, which holds back the embedded system. It is noted
          * that the thread is intended to behave as the Rx line.
          * 
          */
@@ -182,9 +327,64 @@ class MessageHandler{
         /**
          * @brief The embeddedSystemSimulation is responsible for operating as a thread that simulates the embedded system.
          * As a result, it is responsible for receiving and parsing messages, acting accordingly to the messages, and then sending a valid response.
+         * The simulated table itself is held by an \ref EmbeddedSimulator, this thread only runs it on the simulated UART
+         * (see \ref EmbeddedSimulator::run).
          * 
          */
         void embeddedSystemSimulation();
+
+        /**
+         * @brief The linkHeartbeatThread is responsible for operating as a thread that keeps the link alive. When nothing has been
+         * received for a heartbeat interval, it sends a heartbeat that the embedded system echoes back, and when nothing has been
+         * received for \ref heartbeatMissedLimit intervals, it declares the link down. When the board clock must be sampled, the
+         * heartbeat is sent even on a busy link.
+         * 
+         */
+        void linkHeartbeatThread();
+
+        /**
+         * @brief Calls the link state callback, if any
+         * 
+         * @param linkUp -> New state of the link
+         */
+        void notifyLinkState(bool linkUp);
+
+        /**
+         * @brief Sends a request on the control channel and waits for its response, as described in \ref sendMessage
+         * 
+         * @param message -> Message to send to the embedded system according to \ref MessageLibrary.h
+         * @param arguements -> Arguments to send along with the message
+         * @param messageID -> ID of the request, matched against the ID of the response
+         * @return std::vector<int> -> Same as \ref sendMessage
+         */
+        std::vector<int> exchangeMessage(std::string message, std::string arguements, unsigned int messageID);
+
+        /**
+         * @brief Performs the capability handshake: the HMI sends its protocol version and capabilities, and the embedded system
+         * answers with its own. Only the capabilities both sides have are used. Firmware that predates the handshake answers
+         * with an error, and is then used with the legacy protocol and no capabilities. The handshake uses its own message ID,
+         * so that it does not change the IDs of the requests of the HMI.
+         * 
+         * @return true -> If the embedded system answered (even with an error)
+         * @return false -> If no answer was received within the response timeout, the handshake is then retried later
+         */
+        bool negotiateCapabilities();
+
+        /**
+         * @brief Records a frame in the capture file, if a capture is running
+         * 
+         * @param direction -> \ref CAPTURE_DIRECTION_TX or \ref CAPTURE_DIRECTION_RX
+         * @param frame -> Full frame that was sent or received
+         */
+        void captureFrame(unsigned int direction, const std::string &frame);
+
+        /**
+         * @brief Get the queue holding the messages received on a channel
+         * 
+         * @param channel -> One of the ML_CHANNEL defines
+         * @return BoundedMessageQueue* -> Queue of the channel, NULL for the control channel (responses use \ref incomingQueue)
+         */
+        BoundedMessageQueue* receivedQueue(unsigned int channel);
         
 
     protected:
@@ -245,19 +445,185 @@ class MessageHandler{
          */
         static MessageHandler& instance();
 
+        /**
+         * @brief This function selects a capture file to be replayed in place of the embedded system simulation. Frames received
+         * in the capture are fed back to the HMI and frames sent by the HMI are checked against the capture (see \ref ReplayTransport.h)
+         * 
+         * NOTE: Must be called before the first call to \ref instance, as the link is chosen when the Singleton is created
+         * 
+         * @param fileName -> Path of the capture file written by \ref startCapture
+         * @param speed -> Replay speed (1.0 = real time, 10.0 = ten times faster, \ref CAPTURE_REPLAY_MAX_SPEED = no delays)
+         */
+        static void setReplaySource(const std::string &fileName, double speed = 1.0);
+
+        /**
+         * @brief This function sets the range of times between two random goals of the embedded system simulation, so that
+         * load tests and latency measurements can run thousands of goals in a reasonable time
+         * 
+         * NOTE: Must be called before the first call to \ref instance, as the simulation is started when the Singleton is created
+         * 
+         * @param minimum -> Shortest time between two goals in milliseconds
+         * @param maximum -> Longest time between two goals in milliseconds
+         */
+        static void setSimulatedGoalDelay(unsigned int minimum, unsigned int maximum);
+
+        /**
+         * @brief This function selects an embedded system simulation running in another process (see \ref embeddedsim.cpp) in place
+         * of the simulation thread, so that the simulation cannot take down the GUI and the IPC costs are real. The address is either
+         * "shm:NAME" for the shared memory transport (see \ref SharedMemoryTransport.h) or "unix:PATH" for a Unix socket.
+         * 
+         * NOTE: Must be called before the first call to \ref instance, and the simulation must already be running. If the simulation
+         * cannot be reached, the simulation thread is used instead
+         * 
+         * @param address -> Address of the simulation
+         */
+        static void setSimulatorAddress(const std::string &address);
+
+        /**
+         * @brief This function makes the embedded system simulation stream puck positions on the telemetry channel while a game
+         * is active, used to check that telemetry does not delay goals and responses
+         * 
+         * NOTE: Must be called before the first call to \ref instance, as the simulation is started when the Singleton is created
+         * 
+         * @param period -> Time between two telemetry messages in milliseconds (0 = no telemetry)
+         */
+        static void setSimulatedTelemetryPeriod(unsigned int period);
+
+        /**
+         * @brief This function sets how often the link is checked. The link is declared down at most (missedLimit + 1/4) intervals
+         * after the last frame received.
+         * 
+         * NOTE: Must be called before the first call to \ref instance, as the heartbeat thread is started when the Singleton is created
+         * 
+         * @param interval -> Time between two heartbeats on a quiet link in milliseconds (0 = no heartbeats and no link-down detection)
+         * @param missedLimit -> Number of intervals without any frame received after which the link is down
+         */
+        static void setHeartbeatInterval(unsigned int interval, unsigned int missedLimit = 3);
+
+        /**
+         * @brief This function sets how long \ref sendMessage waits for a response before returning in error
+         * 
+         * @param timeout -> Time to wait for a response in milliseconds
+         */
+        static void setResponseTimeout(unsigned int timeout);
+
+        //Methods used for monitoring the link:
+
+        /**
+         * @brief This function sets the function called when the link goes down (false) or comes back up (true)
+         * 
+         * NOTE: The function is called from the threads of the MessageHandler, so the GUI must forward it to its own thread
+         * (for example with QMetaObject::invokeMethod) before touching any widget
+         * 
+         * @param callback -> Function called with the new state of the link
+         */
+        void setLinkStateCallback(std::function<void(bool)> callback);
+
+        /**
+         * @brief Check whether the link with the embedded system is up
+         * 
+         * @return true -> If a frame was received within the link timeout
+         */
+        bool isLinkUp() {return this->linkMonitor.isLinkUp();}
+
+        /**
+         * @brief Get the metrics of the link: round trip time, jitter, heartbeat loss rate and checksum error rate
+         * 
+         * @return linkStatistics -> Metrics of the link
+         */
+        linkStatistics getLinkStatistics() {return this->linkMonitor.getStatistics();}
+
+        /**
+         * @brief Check whether a feature was agreed with the embedded system by the capability handshake
+         * 
+         * @param capability -> One of the ML_CAP defines
+         * @return true -> If both the HMI and the embedded system support the feature
+         */
+        bool hasCapability(unsigned int capability) {return (this->linkCapabilities & capability) == capability;}
+
+        /**
+         * @brief Get the capabilities agreed with the embedded system
+         * 
+         * @return unsigned int -> ML_CAP bitmask (0 for legacy firmware)
+         */
+        unsigned int getCapabilities() {return this->linkCapabilities;}
+
+        /**
+         * @brief Get the protocol version of the embedded system
+         * 
+         * @return unsigned int -> \ref ML_PROTOCOL_VERSION_LEGACY for firmware that predates the capability handshake
+         */
+        unsigned int getProtocolVersion() {return this->linkProtocolVersion;}
+
+        /**
+         * @brief This function converts a board time sent by the embedded system (for example the time of a goal) to the time
+         * on the HMI steady_clock, using the offset and drift of the board clock measured by the heartbeats. The receiving thread
+         * uses it to mark when a goal was emitted for latency measurements (see \ref LatencyProbe.h)
+         * 
+         * NOTE: Goals are placed on the game clock from the board time at which the game was started instead (see
+         * \ref game::boardTimeToGameTime), a difference of two board times that is not affected by the error of the estimate
+         * 
+         * @param boardTimestamp -> Board time in microseconds (see \ref ML_TIMESTAMP_MASK)
+         * @param steadyTime -> Set to the matching time on the HMI steady_clock
+         * @return true -> If the board clock was sampled, false otherwise (steadyTime is then unchanged)
+         */
+        bool boardTicksToSteady(unsigned int boardTimestamp, std::chrono::steady_clock::time_point &steadyTime) {return this->clockSync.boardToSteady(boardTimestamp, steadyTime);}
+
+        /**
+         * @brief Get the estimate of the board clock: offset, drift and uncertainty
+         * 
+         * @return clockSyncStatistics -> Estimate of the board clock
+         */
+        clockSyncStatistics getClockSyncStatistics() {return this->clockSync.getStatistics();}
+
+        //Methods used for recording and replaying traffic:
+
+        /**
+         * @brief This function starts recording every frame sent to and received from the embedded system into a capture file,
+         * along with the time it was seen and its direction. Any capture already running is closed first.
+         * 
+         * @param fileName -> Path of the capture file to create
+         * @return true -> If the capture file was created
+         * @return false -> If the capture file could not be created
+         */
+        bool startCapture(const std::string &fileName);
+
+        /**
+         * @brief This function stops the running capture, if any, and closes the capture file
+         * 
+         */
+        void stopCapture();
+
+        /**
+         * @brief Check whether the link is a replayed capture instead of the embedded system
+         * 
+         * @return true -> If a capture is being replayed
+         */
+        bool isReplaying() {return this->replayTransport != NULL;}
+
+        /**
+         * @brief Get the progress of the replay
+         * 
+         * @return replayStatistics -> Counters of the replay (all zero and finished if no capture is being replayed)
+         */
+        replayStatistics getReplayStatistics();
+
         //Methods Used for communication:
 
         /**
          * @brief This function is the main function to be used throught the code structure for the project and operates by taking a desired message
          * to send and any associated arguements if necessary. The values are put together into a MessagePacket, which is placed on the outgoingQueue
          * for sending. Sending and receiving are handled by threads, and the function is then notified of a response received through
-         * incomingMutex. The received message is taken off of the incomingQueue and processed for results and data returned through a vector.
+         * responseAvailable. The response with the ID of the message is taken off of the incomingQueue and processed for results and data returned through a vector.
          * 
          * @param message -> Message to send to the embedded system according to \ref MessageLibrary.h
          * @param arguements -> Arguments to send along with the message
          * @return std::vector<int> -> Pertinent data associated with the response to the sent message.
-         * IF there was an error, the FIRST element of the vector takes a negative value
+         * IF there was an error, the FIRST element of the vector takes a negative value (-4 if no response was received within the response timeout)
          * IF the transaction was successful, the FIRST element is the ID of the message, and the following elements correspond to any arguements that were returned as part of the message
+         * 
+         * NOTE: If the capabilities must be negotiated again, the handshake is done first. If it gets no answer, the message is not
+         * sent and -4 is returned straight away.
          */
         std::vector<int> sendMessage(std::string message, std::string arguements = "");
 
@@ -271,12 +637,63 @@ class MessageHandler{
          * @return std::vector<int> If the unsolicitedQueue is empty, the firs value in the vector is returned as a negative (-1), which is the ONLY value in the vector
          * If the unsolicitedQueue had a message, the message is removed, and the first value of the vector is returned as the ID of the message received, while the remaining
          * values in the vector are returned as values associated with the message on the queue (Because there is ONLY 1 message type that can be sent unsolicited, it is always
-         * the goal side and then the goal speed in the vector)
+         * the goal side and then the goal speed in the vector, followed by the board time of the goal if \ref ML_CAP_TIMESTAMPS was negotiated)
          * 
-         * Ex. vect<int>[0] = 100 (messageID), vect<int>[0] = 1 (goalSide), vect<int>[0] = 100 (goalSpeed)
+         * Ex. vect<int>[0] = 100 (messageID), vect<int>[0] = 1 (goalSide), vect<int>[0] = 100 (goalSpeed), vect<int>[3] = 1500000 (goalTimestamp, optional)
          */
         std::vector<int> unsolicitedQueueGet();
 
+        /**
+         * @brief This function drops every message waiting on the unsolicitedQueue. It is called when a new game starts, so that a goal
+         * of the game before it, sent before the table was put in the inactive game state, is never counted in the new game
+         * 
+         * @return unsigned long -> Number of messages dropped
+         */
+        unsigned long unsolicitedQueueClear();
+
+        /**
+         * @brief This function sends a message on a logical channel without waiting for a response, for example a debug log.
+         * The message is dropped if the channel is full, so that a slow link never blocks the caller.
+         * 
+         * @param message -> Message to send to the embedded system according to \ref MessageLibrary.h
+         * @param arguements -> Arguments to send along with the message
+         * @param channel -> One of the ML_CHANNEL defines
+         * @return true -> If the message was queued for sending
+         * @return false -> If the channel is full or does not exist, or the embedded system does not support channels
+         * (\ref ML_CAP_CHANNELS) and the channel is not the control channel
+         */
+        bool postMessage(std::string message, std::string arguements, unsigned int channel);
+
+        /**
+         * @brief This function takes the next message received on the telemetry or debug channel, if any. It is polled in the
+         * same way as \ref unsolicitedQueueGet
+         * 
+         * @param channel -> \ref ML_CHANNEL_TELEMETRY or \ref ML_CHANNEL_DEBUG
+         * @param message -> Set to the message received
+         * @return true -> If a message was received on the channel
+         * @return false -> If the channel queue is empty, or the channel is not a telemetry or debug channel
+         */
+        bool channelQueueGet(unsigned int channel, MessagePacket &message);
+
+        /**
+         * @brief Set the number of messages the queue of a channel can hold before its overflow policy applies
+         * 
+         * @param channel -> \ref ML_CHANNEL_EVENTS, \ref ML_CHANNEL_TELEMETRY or \ref ML_CHANNEL_DEBUG
+         * @param capacity -> Maximum number of messages waiting
+         * @return true -> If the capacity was set
+         * @return false -> If the channel has no queue
+         */
+        bool setChannelQueueCapacity(unsigned int channel, unsigned long capacity);
+
+        /**
+         * @brief Get the counters of the queue of a channel (size, high-water mark and drops), used to size the queues and to
+         * check that no goal was dropped during long sessions
+         * 
+         * @param channel -> \ref ML_CHANNEL_EVENTS, \ref ML_CHANNEL_TELEMETRY or \ref ML_CHANNEL_DEBUG
+         * @return queueStatistics -> Counters of the queue (all zero if the channel has no queue)
+         */
+        queueStatistics getChannelQueueStatistics(unsigned int channel);
+
 };
 
 
@@ -23,6 +23,14 @@
  * 
  * NOTE: Responses to a message will have the SAME MSG_ID and MESSAGE, but will differ in terms of arguements
  * 
+ * The MSG_ID may be followed by the logical channel the message travels on, as "|MSG_ID,CHANNEL|>MESSAGE:ARGUMENTS<CHECKSUM|".
+ * Without a channel, unsolicited messages (MSG_ID = ML_UNSOLICITED_MESSAGE_ID) travel on ML_CHANNEL_EVENTS and all other
+ * messages travel on ML_CHANNEL_CONTROL, so the channel is only written when it differs from this default.
+ * 
+ * When the link starts, the Raspberry PI sends its protocol version and capabilities with M_RPI_GET_CAPABILITIES, and the embedded
+ * system answers with its own. Only the capabilities both sides have (ML_CAP_*) are used for the life of the link. Firmware older
+ * than the handshake answers with an error, and is treated as protocol version ML_PROTOCOL_VERSION_LEGACY without any capability.
+ * 
  * @copyright Copyright (c) 2020
  * 
  */
@@ -49,6 +57,33 @@
 #define ML_PLAYER_ONE_SIDE  0                               //!< Defines the side of the table where a human player will always play
 #define ML_AI_SIDE          1                               //!< Defines the side of the table where a the AI and accesability systems are located
 
+//Values used to define the logical channels sharing the link, in order of priority (highest first):
+#define ML_CHANNEL_CONTROL  0                               //!< Channel of the messages sent by the Raspberry PI and their responses
+#define ML_CHANNEL_EVENTS   1                               //!< Channel of unsolicited game events, such as goals
+#define ML_CHANNEL_TELEMETRY 2                              //!< Channel of bulk telemetry streams, where only fresh data matters
+#define ML_CHANNEL_DEBUG    3                               //!< Channel of debug log messages
+#define ML_CHANNEL_COUNT    4                               //!< Number of logical channels
+
+//Values used to identify messages:
+#define ML_UNSOLICITED_MESSAGE_ID 100                       //!< Message ID of messages sent by the embedded system without a request (IDs 0 to 99 are used by requests)
+#define ML_HEARTBEAT_MESSAGE_ID 101                         //!< Message ID of the heartbeats used to check the link, and of their answers
+#define ML_HANDSHAKE_MESSAGE_ID 102                         //!< Message ID of the capability handshake, and of its answer
+
+//Values used to negotiate the protocol at link startup:
+#define ML_PROTOCOL_VERSION_LEGACY 1                        //!< Protocol version of firmware that does not answer the capability handshake
+#define ML_PROTOCOL_VERSION 2                               //!< Protocol version implemented by this library
+#define ML_CAP_CHANNELS     0x0001                          //!< Frames may name a logical channel other than the default one
+#define ML_CAP_HEARTBEAT    0x0002                          //!< Heartbeats (ML_HEARTBEAT_MESSAGE_ID) are echoed back
+#define ML_CAP_TELEMETRY    0x0004                          //!< Telemetry streams are sent on ML_CHANNEL_TELEMETRY
+#define ML_CAP_BINARY_FRAMING 0x0008                        //!< Reserved for binary frames
+#define ML_CAP_BATCHING     0x0010                          //!< Reserved for several messages per frame
+#define ML_CAP_LARGE_IDS    0x0020                          //!< Reserved for message IDs above ML_HEARTBEAT_MESSAGE_ID
+#define ML_CAP_TIMESTAMPS   0x0040                          //!< Goal data and game state changes carry the board time (see ML_TIMESTAMP_MASK)
+#define ML_CAP_SUPPORTED    (ML_CAP_CHANNELS | ML_CAP_HEARTBEAT | ML_CAP_TELEMETRY | ML_CAP_TIMESTAMPS) //!< Capabilities implemented by this library
+
+//Values used for the timestamps of the embedded system:
+#define ML_TIMESTAMP_MASK   0x7FFFFFFF                      //!< Board time is counted in microseconds and wraps at 2^31 (about 35 minutes), so that it fits a positive int
+
 //Below, we define some macros to convert the defines above into strings when passed as parameters:
 #define STRING(token)       #token                          //!< Intermediate step to get the value stored in the define to convert to a string
 #define TO_STRING(token)    STRING(token)                   //!< Macro to call on define to convert the define's CONTENTS to a string
@@ -66,11 +101,13 @@
 #define M_RPI_GET_TABLE_MODE "GET; TABLE MODE"               //!< Getter => Standard = 0, Accessability = 1, AI = 2 for defining the mode of play for the table
 #define M_RPI_GET_TABLE_LIGHTING "GET; LIGHTING VALUE"       //!< Getter => 24-bit RGB value for defining the lighting on the table
 #define M_RPI_GET_TABLE_AIR_SPEED "GET; TABLE AIR SPEED"     //!< Getter => Integer ranging from 0 to 100 for setting the air speed for puck levitation
+#define M_RPI_GET_HEARTBEAT "GET; HEARTBEAT"                 //!< Getter => Sequence number of the heartbeat, echoed back to measure the link (sent with ML_HEARTBEAT_MESSAGE_ID), followed by the board time of the answer with ML_CAP_TIMESTAMPS: [SEQUENCE, TIMESTAMP]
+#define M_RPI_GET_CAPABILITIES "GET; CAPABILITIES"           //!< Getter => Sent with [PROTOCOL_VERSION, ML_CAP bitmask] of the Raspberry PI, answered with those of the embedded system
 
 //Setters:
 #define M_RPI_SET_AI_DIFFICULTY "SET; AI DIFFICULTY"         //!< Setter => Integer ranging from 1 to 10 for AI Difficulty
 #define M_RPI_SET_AI_ACTIVE_STATE "SET; AI STATE"            //!< Setter => Inactive = 0, Active = 1 for defining if the table AI is active
-#define M_RPI_SET_GAME_ACTIVE_STATE "SET; GAME STATE"        //!< Setter => Inactive = 0, Active = 1 ==> If Acitve, goal data will be sent when a goal is scored
+#define M_RPI_SET_GAME_ACTIVE_STATE "SET; GAME STATE"        //!< Setter => Inactive = 0, Active = 1 ==> If Acitve, goal data will be sent when a goal is scored (answered with [TIMESTAMP] of the change with ML_CAP_TIMESTAMPS)
 #define M_RPI_SET_TABLE_MODE "SET; TABLE MODE"               //!< Setter => Standard = 0, Accessability = 1, AI = 2 for defining the mode of play for the table
 #define M_RPI_SET_TABLE_LIGHTING "SET; LIGHTING VALUE"       //!< Setter => 24-bit RGB value for defining the lighting on the table
 #define M_RPI_SET_TABLE_AIR_SPEED "SET; TABLE AIR SPEED"     //!< Setter => Integer ranging from 0 to 100 for setting the air speed for puck levitation
@@ -83,7 +120,8 @@
 //Getters:
 
 //Setters:
-#define M_EMB_SET_GOAL_DATA "SET; GOAL DATA"                //!< Setter => Includes SIDE of goal and puck speed on entry: [SIDE, SPEED]
+#define M_EMB_SET_GOAL_DATA "SET; GOAL DATA"                //!< Setter => Includes SIDE of goal and puck speed on entry: [SIDE, SPEED], followed by the board time of the goal with ML_CAP_TIMESTAMPS: [SIDE, SPEED, TIMESTAMP]
+#define M_EMB_SET_PUCK_POSITION "SET; PUCK POSITION"        //!< Setter => Telemetry of the puck position on the table in mm: [X, Y]
 
 
 #endif /*MESSAGE_LIBRARY_H*/
\ No newline at end of file
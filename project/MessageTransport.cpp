@@ -0,0 +1,216 @@
+/**
+ * @file MessageTransport.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the PipeTransport and SocketTransport classes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "MessageTransport.h"
+
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+
+//Waits for a file descriptor to become readable, retrying waits that were interrupted by a signal
+static int waitDescriptor(int descriptor, int timeout){
+
+    struct pollfd line;
+    line.fd = descriptor;
+    line.events = POLLIN;
+    line.revents = 0;
+
+    int ready;
+    do{
+        ready = poll(&line, 1, timeout);
+    } while(ready < 0 && errno == EINTR);
+
+    return ready;
+
+}
+
+
+PipeTransport::PipeTransport(int readDescriptor, int writeDescriptor){
+
+    this->readDescriptor = readDescriptor;
+    this->writeDescriptor = writeDescriptor;
+
+}
+
+
+bool PipeTransport::send(const std::string &frame){
+
+    const char *data = frame.c_str();
+    size_t remaining = frame.length();
+
+    //A single write may be split by the kernel, so keep writing until the whole frame is on the line
+    while(remaining > 0){
+
+        ssize_t written = write(this->writeDescriptor, data, remaining);
+
+        if(written < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+
+        data += written;
+        remaining -= written;
+    }
+
+    return true;
+
+}
+
+
+int PipeTransport::receive(char *buffer, unsigned int length){
+
+    ssize_t bytesRead;
+
+    //Retry reads that were interrupted by a signal before any data arrived
+    do{
+        bytesRead = read(this->readDescriptor, buffer, length);
+    } while(bytesRead < 0 && errno == EINTR);
+
+    return (int)bytesRead;
+
+}
+
+
+int PipeTransport::waitReadable(int timeout){
+
+    return waitDescriptor(this->readDescriptor, timeout);
+
+}
+
+
+SocketTransport::SocketTransport(int socketDescriptor){
+
+    this->socketDescriptor = socketDescriptor;
+
+}
+
+
+SocketTransport::~SocketTransport(){
+
+    if(this->socketDescriptor >= 0){
+        close(this->socketDescriptor);
+    }
+
+}
+
+
+//Fills in the address of a Unix socket, returns false if the path does not fit
+static bool unixAddress(const std::string &path, struct sockaddr_un &address){
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if(path.length() >= sizeof(address.sun_path)){
+        return false;
+    }
+
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return true;
+
+}
+
+
+int SocketTransport::connectTo(const std::string &path){
+
+    struct sockaddr_un address;
+    if(!unixAddress(path, address)){
+        return -1;
+    }
+
+    int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(descriptor < 0){
+        return -1;
+    }
+
+    if(connect(descriptor, (struct sockaddr *)&address, sizeof(address)) < 0){
+        close(descriptor);
+        return -1;
+    }
+
+    return descriptor;
+
+}
+
+
+int SocketTransport::listenOn(const std::string &path){
+
+    struct sockaddr_un address;
+    if(!unixAddress(path, address)){
+        return -1;
+    }
+
+    int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(descriptor < 0){
+        return -1;
+    }
+
+    //A socket file left behind by a simulation that crashed would make bind() fail
+    unlink(path.c_str());
+
+    if(bind(descriptor, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(descriptor, 1) < 0){
+        close(descriptor);
+        return -1;
+    }
+
+    return descriptor;
+
+}
+
+
+bool SocketTransport::send(const std::string &frame){
+
+    const char *data = frame.c_str();
+    size_t remaining = frame.length();
+
+    while(remaining > 0){
+
+        //MSG_NOSIGNAL reports a closed peer as an error instead of killing the process with SIGPIPE
+        ssize_t written = ::send(this->socketDescriptor, data, remaining, MSG_NOSIGNAL);
+
+        if(written < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+
+        data += written;
+        remaining -= written;
+    }
+
+    return true;
+
+}
+
+
+int SocketTransport::receive(char *buffer, unsigned int length){
+
+    ssize_t bytesRead;
+
+    do{
+        bytesRead = recv(this->socketDescriptor, buffer, length, 0);
+    } while(bytesRead < 0 && errno == EINTR);
+
+    return (int)bytesRead;
+
+}
+
+
+int SocketTransport::waitReadable(int timeout){
+
+    return waitDescriptor(this->socketDescriptor, timeout);
+
+}
@@ -0,0 +1,171 @@
+/**
+ * @file MessageTransport.h
+ * @author Matthew Bertuzzi
+ * @brief Header file used to declare the MessageTransport interface and the PipeTransport and SocketTransport classes.
+ * The MessageTransport interface hides the physical link used by the MessageHandler, so that the same sending and receiving
+ * threads can talk to the (simulated) embedded system over pipes, a Unix socket or shared memory, replay a recorded capture
+ * file, or use any other link without changes to the message handling code.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * NOTE: Transports move raw bytes only. Splitting the byte stream back into frames is done by the MessageHandler
+ * (see \ref MessagePacket::extractFrame)
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef MESSAGE_TRANSPORT_H
+#define MESSAGE_TRANSPORT_H
+
+#include <string>
+#include <unistd.h>
+
+
+/**
+ * @brief This class is the interface for the link between the Raspberry PI and the embedded system. The MessageHandler
+ * writes full frames with \ref send and reads raw bytes with \ref receive from its threads.
+ *
+ */
+class MessageTransport{
+
+    public:
+
+        /**
+         * @brief Destroy the Message Transport object
+         *
+         */
+        virtual ~MessageTransport(){
+        }
+
+        /**
+         * @brief This function sends a full frame of the format "|MSG_ID|>MESSAGE:ARGUMENTS<CHECKSUM|" over the link
+         *
+         * @param frame -> Frame to send
+         * @return true -> If the whole frame was written to the link
+         * @return false -> If the link reported an error
+         */
+        virtual bool send(const std::string &frame) = 0;
+
+        /**
+         * @brief This function blocks until bytes are available on the link and then reads up to length of them
+         *
+         * @param buffer -> Buffer to read the bytes into
+         * @param length -> Size of the buffer
+         * @return int -> Number of bytes read, or a value <= 0 if the link reported an error or was closed
+         */
+        virtual int receive(char *buffer, unsigned int length) = 0;
+
+        /**
+         * @brief This function waits until bytes are available on the link, so that a reader can do other work between messages
+         *
+         * NOTE: Transports that cannot wait with a timeout always report bytes as available, so \ref receive blocks instead
+         *
+         * @param timeout -> Longest time to wait in milliseconds (-1 = wait forever, 0 = do not wait)
+         * @return int -> A value > 0 if bytes are available, 0 if the timeout expired, or a value < 0 if the link reported an error
+         */
+        virtual int waitReadable(int timeout){
+            (void)timeout;
+            return 1;
+        }
+
+};
+
+
+/**
+ * @brief This class implements the MessageTransport interface over a pair of file descriptors, which is how the
+ * simulated USART Tx and Rx lines are connected to the embedded system simulation
+ *
+ */
+class PipeTransport : public MessageTransport{
+
+    private:
+
+        /**
+         * @brief File descriptor that is read from (Rx line)
+         *
+         */
+        int readDescriptor;
+
+        /**
+         * @brief File descriptor that is written to (Tx line)
+         *
+         */
+        int writeDescriptor;
+
+    public:
+
+        /**
+         * @brief Construct a new Pipe Transport object
+         *
+         * @param readDescriptor -> File descriptor used as the Rx line
+         * @param writeDescriptor -> File descriptor used as the Tx line
+         */
+        PipeTransport(int readDescriptor, int writeDescriptor);
+
+        bool send(const std::string &frame);
+
+        int receive(char *buffer, unsigned int length);
+
+        int waitReadable(int timeout);
+
+};
+
+
+/**
+ * @brief This class implements the MessageTransport interface over a connected Unix stream socket, used to talk to an
+ * embedded system simulation running in another process. The simulation listens on a socket path and the HMI connects to it.
+ *
+ */
+class SocketTransport : public MessageTransport{
+
+    private:
+
+        /**
+         * @brief File descriptor of the connected socket, used as both the Rx and Tx lines
+         *
+         */
+        int socketDescriptor;
+
+    public:
+
+        /**
+         * @brief Construct a new Socket Transport object, which takes ownership of a connected socket
+         *
+         * @param socketDescriptor -> File descriptor of the connected socket
+         */
+        SocketTransport(int socketDescriptor);
+
+        /**
+         * @brief Destroy the Socket Transport object and close the socket
+         *
+         */
+        ~SocketTransport();
+
+        /**
+         * @brief This function connects to a simulation listening on a socket path
+         *
+         * @param path -> Path of the Unix socket
+         * @return int -> File descriptor of the connected socket, or -1 if the connection failed
+         */
+        static int connectTo(const std::string &path);
+
+        /**
+         * @brief This function creates a socket listening on a socket path, replacing any stale socket file left at the path
+         *
+         * @param path -> Path of the Unix socket
+         * @return int -> File descriptor of the listening socket (to pass to accept()), or -1 if the socket could not be created
+         */
+        static int listenOn(const std::string &path);
+
+        bool send(const std::string &frame);
+
+        int receive(char *buffer, unsigned int length);
+
+        int waitReadable(int timeout);
+
+};
+
+
+#endif /*MESSAGE_TRANSPORT_H*/
@@ -0,0 +1,227 @@
+/**
+ * @file ReplayTransport.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the ReplayTransport class
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "ReplayTransport.h"
+#include "MessagePacket.h"
+
+#include <string.h>
+
+
+//Heartbeats and capability handshakes are link maintenance rather than traffic of the HMI, so they are skipped in both directions
+static bool isLinkMaintenance(const std::string &frame){
+    unsigned int messageID = MessagePacket(frame).getMessageID();
+    return messageID == ML_HEARTBEAT_MESSAGE_ID || messageID == ML_HANDSHAKE_MESSAGE_ID;
+}
+
+
+ReplayTransport::ReplayTransport(const std::string &fileName, double speed){
+
+    this->speed = speed;
+    this->hasNextRxRecord = false;
+    this->txBeforeNextRx = 0;
+    this->txRecordsSeen = 0;
+    this->txRecordsSent = 0;
+
+    this->statistics.framesReplayed = 0;
+    this->statistics.framesMatched = 0;
+    this->statistics.framesMismatched = 0;
+    this->statistics.framesUnexpected = 0;
+    this->statistics.finished = false;
+
+    //The Rx and Tx frames are walked with separate readers so that the HMI may send ahead of the recorded responses
+    this->captureOpen = this->rxReader.open(fileName) && this->txReader.open(fileName);
+
+    //The replay starts now, at the start of the recorded session
+    this->anchorTimeStamp = 0;
+    this->anchorTime = std::chrono::steady_clock::now();
+
+    if(this->captureOpen){
+        this->advanceRx();
+    }
+    else{
+        this->statistics.finished = true;
+    }
+
+}
+
+
+bool ReplayTransport::isOpen(){
+    return this->captureOpen;
+}
+
+
+void ReplayTransport::advanceRx(){
+
+    captureRecord record;
+
+    this->hasNextRxRecord = false;
+
+    //Skip over the Tx records, they are consumed by send(), but remember how many came before the next Rx record
+    while(this->rxReader.next(record)){
+
+        if(isLinkMaintenance(record.frame)){
+            continue;
+        }
+
+        if(record.direction == CAPTURE_DIRECTION_TX){
+            this->txRecordsSeen++;
+            continue;
+        }
+
+        this->nextRxRecord = record;
+        this->txBeforeNextRx = this->txRecordsSeen;
+        this->hasNextRxRecord = true;
+        return;
+    }
+
+    this->statistics.finished = true;
+
+}
+
+
+std::chrono::steady_clock::duration ReplayTransport::scaled(unsigned long long recordedMicroseconds){
+
+    //At max speed, frames are never delayed
+    if(this->speed <= CAPTURE_REPLAY_MAX_SPEED){
+        return std::chrono::steady_clock::duration::zero();
+    }
+
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(recordedMicroseconds / this->speed));
+
+}
+
+
+std::string ReplayTransport::renumbered(const std::string &frame){
+
+    MessagePacket recordedPacket(frame);
+
+    //Unsolicited messages have no request, and a corrupted frame is replayed as it was recorded
+    if(recordedPacket.getMessageID() >= ML_UNSOLICITED_MESSAGE_ID || !recordedPacket.validateChecksum()){
+        return frame;
+    }
+
+    //Every request recorded before the response has been sent again, so the last ID sent for its recorded ID is the one it answers
+    std::map<unsigned int, unsigned int>::iterator sent = this->sentMessageIDs.find(recordedPacket.getMessageID());
+    if(sent == this->sentMessageIDs.end() || sent->second == recordedPacket.getMessageID()){
+        return frame;
+    }
+
+    //Build the frame again with the ID sent, which also calculates its checksum again
+    MessagePacket replayedPacket(recordedPacket.getMessageString(), sent->second, recordedPacket.getChannel());
+    return replayedPacket.getFullMessage();
+
+}
+
+
+bool ReplayTransport::send(const std::string &frame){
+
+    std::lock_guard<std::mutex> lock(this->replayMutex);
+
+    captureRecord record;
+
+    //Find the next recorded Tx frame
+    bool found = false;
+    while(this->txReader.next(record)){
+        if(record.direction == CAPTURE_DIRECTION_TX && !isLinkMaintenance(record.frame)){
+            found = true;
+            break;
+        }
+    }
+
+    if(!found){
+        this->statistics.framesUnexpected++;
+        return true;
+    }
+
+    //The message ID and checksum depend on when the capture was started, so only the message and arguements are compared
+    MessagePacket sentPacket(frame);
+    MessagePacket recordedPacket(record.frame);
+
+    if(sentPacket.getMessageString() == recordedPacket.getMessageString()){
+        this->statistics.framesMatched++;
+    }
+    else{
+        this->statistics.framesMismatched++;
+    }
+
+    //If the HMI sent later than the recording says it should have, the rest of the replay is shifted accordingly
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if(record.timeStamp >= this->anchorTimeStamp && now > this->anchorTime + this->scaled(record.timeStamp - this->anchorTimeStamp)){
+        this->anchorTimeStamp = record.timeStamp;
+        this->anchorTime = now;
+    }
+
+    //Responses recorded with the ID of this request are delivered with the ID it was sent with
+    this->sentMessageIDs[recordedPacket.getMessageID()] = sentPacket.getMessageID();
+
+    this->txRecordsSent++;
+    this->replayCondition.notify_all();
+
+    return true;
+
+}
+
+
+int ReplayTransport::receive(char *buffer, unsigned int length){
+
+    std::unique_lock<std::mutex> lock(this->replayMutex);
+
+    //Wait until the next Rx frame is available and everything that was sent before it in the recording has been sent again
+    while(this->pendingBytes.empty()){
+
+        if(!this->hasNextRxRecord){
+            //The capture is over, behave like an idle line
+            this->replayCondition.wait(lock);
+            continue;
+        }
+
+        if(this->txRecordsSent < this->txBeforeNextRx){
+            this->replayCondition.wait(lock);
+            continue;
+        }
+
+        //Pace the frame according to the time between it and the last frame of the replay
+        std::chrono::steady_clock::time_point due = this->anchorTime;
+        if(this->nextRxRecord.timeStamp > this->anchorTimeStamp){
+            due += this->scaled(this->nextRxRecord.timeStamp - this->anchorTimeStamp);
+        }
+
+        if(std::chrono::steady_clock::now() < due){
+            this->replayCondition.wait_until(lock, due);
+            continue;
+        }
+
+        if(this->nextRxRecord.timeStamp > this->anchorTimeStamp){
+            this->anchorTimeStamp = this->nextRxRecord.timeStamp;
+            this->anchorTime = due;
+        }
+        this->pendingBytes = this->renumbered(this->nextRxRecord.frame);
+        this->statistics.framesReplayed++;
+
+        this->advanceRx();
+    }
+
+    //Copy as much of the frame as fits into the buffer, the rest is returned on the next call
+    unsigned int count = this->pendingBytes.length() < length ? this->pendingBytes.length() : length;
+    memcpy(buffer, this->pendingBytes.data(), count);
+    this->pendingBytes.erase(0, count);
+
+    return (int)count;
+
+}
+
+
+replayStatistics ReplayTransport::getStatistics(){
+
+    std::lock_guard<std::mutex> lock(this->replayMutex);
+    return this->statistics;
+
+}
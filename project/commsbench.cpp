@@ -0,0 +1,326 @@
+/**
+ * @file commsbench.cpp
+ * @author Matthew Bertuzzi
+ * @brief This file is responsible for benchmarking the communication classes implemented for communicating
+ * between the Raspberry PI and the embedded system, or a simulated embedded system
+ *
+ * The benchmarks cover building and parsing MessagePackets, checksums, splitting the received byte stream into frames,
+ * the opcode dispatch of the simulated embedded system, and a full sendMessage round trip against the simulation,
+ * which responds as soon as a message arrives. The raw round trip of a frame over each transport (pipes, Unix socket and
+ * shared memory) is also measured against an echo thread.
+ *
+ * If the COMMSBENCH_CAPTURE environment variable names a capture file (see \ref MessageCapture.h), the recorded frames
+ * are also decoded as a throughput benchmark of a real session.
+ *
+ * The benchmarks are built with CommsBench.pro and use Google Benchmark, so results can be written as JSON to compare runs:
+ *
+ * ./CommsBench --benchmark_out=comms.json --benchmark_out_format=json
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <sys/socket.h>
+#include "MessagePacket.h"
+#include "MessageHandler.h"
+#include "MessageLibrary.h"
+#include "MessageCapture.h"
+#include "EmbeddedSimulator.h"
+#include "MessageTransport.h"
+#include "SharedMemoryTransport.h"
+
+
+//Full frame of a typical unsolicited goal message
+static const std::string goalFrame = MessagePacket(std::string(M_EMB_SET_GOAL_DATA) + ":1,87", 100).getFullMessage();
+
+//One message of every kind the Raspberry PI sends, used for the dispatch benchmark
+static const char *dispatchMessages[] = {
+    M_RPI_GET_AI_DIFFICULTY ":",
+    M_RPI_GET_AI_ACTIVE_STATE ":",
+    M_RPI_GET_GAME_ACTIVE_STATE ":",
+    M_RPI_GET_TABLE_MODE ":",
+    M_RPI_GET_TABLE_LIGHTING ":",
+    M_RPI_GET_TABLE_AIR_SPEED ":",
+    M_RPI_SET_AI_DIFFICULTY ":5",
+    M_RPI_SET_AI_ACTIVE_STATE ":" TO_STRING(ML_INACTIVE),
+    M_RPI_SET_GAME_ACTIVE_STATE ":" TO_STRING(ML_INACTIVE),
+    M_RPI_SET_TABLE_MODE ":" TO_STRING(ML_STANDARD),
+    M_RPI_SET_TABLE_LIGHTING ":16777215",
+    M_RPI_SET_TABLE_AIR_SPEED ":50",
+    "INVALID MESSAGE:"
+};
+
+
+//Parse a full frame into a MessagePacket, as done for every received message
+static void BM_MessagePacketFromString(benchmark::State &state){
+
+    for(auto _ : state){
+        MessagePacket packet(goalFrame);
+        benchmark::DoNotOptimize(packet);
+    }
+
+}
+BENCHMARK(BM_MessagePacketFromString);
+
+
+//Build the frame of a MessagePacket, as done for every sent message
+static void BM_GetFullMessage(benchmark::State &state){
+
+    MessagePacket packet(M_RPI_SET_TABLE_LIGHTING ":16777215", 42);
+
+    for(auto _ : state){
+        std::string frame = packet.getFullMessage();
+        benchmark::DoNotOptimize(frame);
+    }
+
+}
+BENCHMARK(BM_GetFullMessage);
+
+
+//Calculate the checksum of a message string of the given length
+static void BM_CalculateChecksum(benchmark::State &state){
+
+    MessagePacket packet(std::string(state.range(0), 'A'), 0);
+
+    for(auto _ : state){
+        benchmark::DoNotOptimize(packet.calculateChecksum());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+
+}
+BENCHMARK(BM_CalculateChecksum)->Arg(16)->Arg(32)->Arg(64);
+
+
+//Validate the checksum of a received message
+static void BM_ValidateChecksum(benchmark::State &state){
+
+    MessagePacket packet(goalFrame);
+
+    for(auto _ : state){
+        benchmark::DoNotOptimize(packet.validateChecksum());
+    }
+
+}
+BENCHMARK(BM_ValidateChecksum);
+
+
+//Split a stream holding the given number of back-to-back frames, as done by the receiving thread
+static void BM_ExtractFrame(benchmark::State &state){
+
+    std::string stream;
+    for(int i = 0; i < state.range(0); i++){
+        stream += goalFrame;
+    }
+
+    std::string buffer;
+    std::string frame;
+
+    for(auto _ : state){
+        buffer = stream;
+        while(MessagePacket::extractFrame(buffer, frame)){
+            benchmark::DoNotOptimize(frame);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+}
+BENCHMARK(BM_ExtractFrame)->Arg(1)->Arg(8);
+
+
+//Dispatch a received message to its handler in the simulated embedded system, for each message of the library
+static void BM_OpcodeDispatch(benchmark::State &state){
+
+    EmbeddedSimulator simulator;
+    MessagePacket packet(dispatchMessages[state.range(0)], 1);
+
+    for(auto _ : state){
+        MessagePacket response = simulator.respond(packet);
+        benchmark::DoNotOptimize(response);
+    }
+
+    state.SetLabel(dispatchMessages[state.range(0)]);
+
+}
+BENCHMARK(BM_OpcodeDispatch)->DenseRange(0, sizeof(dispatchMessages) / sizeof(dispatchMessages[0]) - 1);
+
+
+//Send a message through the MessageHandler and wait for the response of the simulated embedded system
+static void BM_SendMessageRoundTrip(benchmark::State &state){
+
+    //Create the singleton (and its threads) before timing
+    MessageHandler &handler = MessageHandler::instance();
+
+    for(auto _ : state){
+        std::vector<int> returnVal = handler.sendMessage(M_RPI_GET_TABLE_MODE);
+        if(returnVal[0] < 0){
+            state.SkipWithError("Did not receive expected message response");
+            break;
+        }
+    }
+
+}
+BENCHMARK(BM_SendMessageRoundTrip)->UseRealTime();
+
+
+//Frame that stops the echo thread of the transport benchmark
+static const std::string stopFrame = MessagePacket("STOP:", 0).getFullMessage();
+
+
+//Sends every frame received on a transport back, until the stop frame is received
+static void echoTransport(MessageTransport *link){
+
+    char buffer[256];
+    std::string stream;
+    std::string frame;
+
+    while(1){
+
+        int bytesRead = link->receive(buffer, sizeof(buffer));
+        if(bytesRead <= 0){
+            return;
+        }
+
+        stream.append(buffer, bytesRead);
+
+        while(MessagePacket::extractFrame(stream, frame)){
+
+            if(frame == stopFrame){
+                return;
+            }
+
+            link->send(frame);
+        }
+    }
+
+}
+
+
+//Send a goal frame over a transport and wait for it to be echoed back (0 = pipes, 1 = Unix socket, 2 = shared memory)
+static void BM_TransportRoundTrip(benchmark::State &state){
+
+    MessageTransport *link = NULL;
+    MessageTransport *echoLink = NULL;
+    int pipeForward[2] = {-1, -1};
+    int pipeBackward[2] = {-1, -1};
+
+    if(state.range(0) == 0){
+        if(pipe(pipeForward) < 0 || pipe(pipeBackward) < 0){
+            state.SkipWithError("Could not create the pipes");
+            return;
+        }
+        link = new PipeTransport(pipeBackward[0], pipeForward[1]);
+        echoLink = new PipeTransport(pipeForward[0], pipeBackward[1]);
+    }
+    else if(state.range(0) == 1){
+        int sockets[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) < 0){
+            state.SkipWithError("Could not create the sockets");
+            return;
+        }
+        link = new SocketTransport(sockets[0]);
+        echoLink = new SocketTransport(sockets[1]);
+    }
+    else{
+        SharedMemoryTransport *simulationSide = new SharedMemoryTransport("/commsbench", true);
+        echoLink = simulationSide;
+        link = new SharedMemoryTransport("/commsbench", false);
+        if(!simulationSide->isOpen()){
+            state.SkipWithError("Could not create the shared memory");
+            delete link;
+            delete echoLink;
+            return;
+        }
+    }
+
+    std::thread echoThread(echoTransport, echoLink);
+
+    char buffer[256];
+    std::string stream;
+    std::string frame;
+
+    for(auto _ : state){
+
+        link->send(goalFrame);
+
+        while(!MessagePacket::extractFrame(stream, frame)){
+            int bytesRead = link->receive(buffer, sizeof(buffer));
+            if(bytesRead <= 0){
+                break;
+            }
+            stream.append(buffer, bytesRead);
+        }
+    }
+
+    link->send(stopFrame);
+    echoThread.join();
+
+    delete link;
+    delete echoLink;
+
+    for(unsigned int i = 0; i < 2; i++){
+        if(pipeForward[i] >= 0){
+            close(pipeForward[i]);
+            close(pipeBackward[i]);
+        }
+    }
+
+}
+BENCHMARK(BM_TransportRoundTrip)->DenseRange(0, 2)->UseRealTime();
+
+
+//Decode every frame of a recorded session, if one was given through COMMSBENCH_CAPTURE
+static void BM_CaptureDecode(benchmark::State &state){
+
+    const char *fileName = getenv("COMMSBENCH_CAPTURE");
+    if(fileName == NULL){
+        state.SkipWithError("COMMSBENCH_CAPTURE is not set");
+        return;
+    }
+
+    //Load the Rx frames into a single stream, as if they had arrived on the line back-to-back
+    MessageCaptureReader reader;
+    if(!reader.open(fileName)){
+        state.SkipWithError("Could not open the capture file");
+        return;
+    }
+
+    captureRecord record;
+    std::string stream;
+    long frames = 0;
+    while(reader.next(record)){
+        if(record.direction == CAPTURE_DIRECTION_RX){
+            stream += record.frame;
+            frames++;
+        }
+    }
+
+    std::string buffer;
+    std::string frame;
+
+    for(auto _ : state){
+        buffer = stream;
+        while(MessagePacket::extractFrame(buffer, frame)){
+            MessagePacket packet(frame);
+            benchmark::DoNotOptimize(packet.validateChecksum());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * frames);
+    state.SetBytesProcessed(state.iterations() * stream.length());
+
+}
+BENCHMARK(BM_CaptureDecode);
+
+
+BENCHMARK_MAIN();
@@ -2,8 +2,8 @@
  * @file databasewindow.cpp
  * @author Ali Sarfraz
  * @brief Implementation file used to implement the databasewindow class
- * @version 0.1
- * @date 2020-12-02
+ * @version 0.8
+ * @date 2026-10-19
  *
  * @copyright Copyright (c) 2020
  *
@@ -11,27 +11,36 @@
 #include "databasewindow.h"
 #include "ui_databasewindow.h"
 
-static const char* database_name = "game_records.db"; //!< Const for keeping track of the database.
-
-databaseWindow::databaseWindow(QWidget *parent) :
+databaseWindow::databaseWindow(QWidget *parent, matchStorage *storage, storageWriter *writer, nameIndex *names) :
     QDialog(parent),
-    ui(new Ui::databaseWindow)
+    ui(new Ui::databaseWindow),
+    recompute_pending(false),
+    recompute_job(0)
 {
     ui->setupUi(this);
 
-    // Initialize the database.
-    match_history = QSqlDatabase::addDatabase("QSQLITE");
-    match_history.setDatabaseName(database_name);
+    // The database is kept open by the storage service, and changed by the storage writer.
+    match_history = storage;
+    history_writer = writer;
+
+    // The table shows the games of the searched player.
+    history_model = new historyModel(match_history, this);
+    ui->tableView_history->setModel(history_model);
 
-    // Ensure that the database is present.
+    // Ensure that the database is open.
     // Close the window if not.
-    std::ifstream database_file;
-    database_file.open(database_name);
-    if(!database_file){
+    if ((match_history == nullptr) || (history_writer == nullptr) || !match_history->isOpen()) {
         QMessageBox::critical(this, "Error", "Database does not exist!");
         QTimer::singleShot(0, this, SLOT(close()));
+        return;
+    }
+
+    connect(history_writer, &storageWriter::jobFinished, this, &databaseWindow::ratingsStored);
+
+    // Suggest the stored player names as a name is typed.
+    if (names != nullptr) {
+        names->attach(ui->lineEdit_player_name);
     }
-    database_file.close();
 }
 
 databaseWindow::~databaseWindow()
@@ -45,50 +54,135 @@ void databaseWindow::on_pushButton_search_clicked()
     // Access the string input by the user into the search bar.
     QString player_name = ui->lineEdit_player_name->text();
 
-    // Open the databse file.
-    match_history.open();
-
-    // Perform a query in the database using the provided name as a key.
+    // Show the games of the player, the model reads them from the reader a page at a time.
     // Will search in both Player_A and Player_B slots.
-    QSqlQuery qry;
-    if (!qry.exec("select * from game_data where player_A='" +
-                  player_name +"' OR player_B='" + player_name + "';")){
+    int count = history_model->setPlayer(player_name);
+
+    // Display error if we haven't matched atleast one game with the provided string.
+    if(count == 0){
+        QMessageBox::critical(this, "Error", "No game records found!");
+    }
+}
+
+// Function that computes every rating again from the stored matches.
+void databaseWindow::on_pushButton_recompute_clicked()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Save the matches still waiting first, or the ratings stored after them would leave them out.
+    history_writer->flush();
+
+    // Read every game in the order the matches were played, the games of a match are stored together.
+    sqlite3_stmt* qry = match_history->prepare(match_history->getReader(), "select m.id, m.player_a, m.player_b, g.a_score, g.b_score"
+                                               " from matches m join games g on g.match_id = m.id order by m.id, g.game_number;");
+    if (qry == NULL){
         QMessageBox::critical(this, "Error", "Invalid Syntax!");
-    } else {
-        // Counter to keep track of the number of games matched.
-        int count = 0;
-
-        // Print all the data to the terminal for now...
-        while (qry.next()) {
-            qDebug () << "******************************************************";
-            qDebug () << "Match ID:" << qry.value("ID").toString() << "\n";
-            qDebug () << "Player A Name:" << qry.value("player_A").toString();
-            qDebug () << "Player B Name:" << qry.value("player_B").toString();
-            qDebug () << "Player A Score:" << qry.value("A_score").toInt();
-            qDebug () << "Player B Score:" << qry.value("B_score").toInt();
-
-            // Retrieve the table mode data.
-            auto table_mode = qry.value("table_mode").toInt();
-
-            // Switch on the table mode.
-            switch (table_mode) {
-            case ML_STANDARD:
-                qDebug () << "Table Mode: Standard";
-                break;
-            case ML_ACCESSABILITY:
-                qDebug () << "Table Mode: Accessability";
-                break;
-            case ML_AI:
-                qDebug () << "Table Mode: AI";
-                break;
-            }
-
-            count++;
-         }
-
-        // Display error if we haven't matched atleast one game with the provided string.
-        if(count == 0){
-            QMessageBox::critical(this, "Error", "No game records found!");
+        return;
+    }
+
+    // Players are numbered in the order they are first seen.
+    std::vector<qint64> players;
+    QHash<qint64, unsigned long> indices;
+
+    auto playerIndex = [&](qint64 id){
+        auto found = indices.find(id);
+        if (found != indices.end()) return found.value();
+
+        indices.insert(id, players.size());
+        players.push_back(id);
+        return static_cast<unsigned long>(players.size() - 1);
+    };
+
+    // Each match is rated from the games won by each player, a tied game counting for both.
+    std::vector<ratedMatch> history;
+    ratedMatch current = ratedMatch();
+    qint64 currentID = 0;
+    unsigned long wins_A = 0;
+    unsigned long wins_B = 0;
+    bool inMatch = false;
+
+    auto finishMatch = [&](){
+        if (!inMatch || (current.playerA == current.playerB)) return;
+
+        current.playerAScore = 0.5;
+        if (wins_A > wins_B) current.playerAScore = 1;
+        else if (wins_B > wins_A) current.playerAScore = 0;
+
+        history.push_back(current);
+    };
+
+    while (sqlite3_step(qry) == SQLITE_ROW) {
+        qint64 ID = sqlite3_column_int64(qry, 0);
+
+        // The first game of a new match.
+        if (!inMatch || (ID != currentID)) {
+            finishMatch();
+
+            currentID = ID;
+            current.playerA = playerIndex(sqlite3_column_int64(qry, 1));
+            current.playerB = playerIndex(sqlite3_column_int64(qry, 2));
+            wins_A = 0;
+            wins_B = 0;
+            inMatch = true;
+        }
+
+        auto score_A = sqlite3_column_int(qry, 3);
+        auto score_B = sqlite3_column_int(qry, 4);
+
+        if (score_A >= score_B) wins_A++;
+        if (score_B >= score_A) wins_B++;
+    }
+    sqlite3_reset(qry);
+    finishMatch();
+
+    // Rate the whole history on all cores.
+    ratingEngine engine;
+    std::vector<playerRating> ratings = engine.recompute(history, players.size());
+
+    // Replace the stored ratings on the storage writer, in its transaction, and tell the user once they are stored.
+    auto job = [players, ratings](matchStorage &storage){
+        sqlite3* writer = storage.getWriter();
+
+        if (sqlite3_exec(writer, "UPDATE players SET rating = NULL, deviation = NULL, volatility = NULL, rated_matches = NULL;", NULL, NULL, NULL) != SQLITE_OK) {
+            return false;
+        }
+
+        sqlite3_stmt* update = storage.prepare(writer, "UPDATE players SET rating = ?, deviation = ?, volatility = ?, rated_matches = ? WHERE id = ?;");
+        if (update == NULL) return false;
+
+        for (auto i = 0u; i < players.size(); i++) {
+            sqlite3_bind_double(update, 1, ratings[i].rating);
+            sqlite3_bind_double(update, 2, ratings[i].deviation);
+            sqlite3_bind_double(update, 3, ratings[i].volatility);
+            sqlite3_bind_int64(update, 4, static_cast<sqlite3_int64>(ratings[i].matches));
+            sqlite3_bind_int64(update, 5, players[i]);
+
+            bool updated = (sqlite3_step(update) == SQLITE_DONE);
+            sqlite3_reset(update);
+
+            if (!updated) return false;
         }
-     }
+
+        return true;
+    };
+
+    recompute_summary = "Ratings of " + QString::number(players.size()) + " players computed from "
+            + QString::number(history.size()) + " matches in " + QString::number(timer.elapsed()) + " ms.";
+    recompute_job = history_writer->submit(job);
+    recompute_pending = true;
+}
+
+// Function that reports the recomputed ratings once stored.
+void databaseWindow::ratingsStored(unsigned long job, bool committed)
+{
+    if (!recompute_pending || (job != recompute_job)) return;
+    recompute_pending = false;
+
+    if (!committed) {
+        QMessageBox::critical(this, "Error", "Ratings could not be stored!");
+        return;
+    }
+
+    QMessageBox::information(this, "Ratings", recompute_summary);
 }
@@ -2,8 +2,8 @@
  * @file game.cpp
  * @author Sanjayan Kulendran
  * @brief Implementation file used to implement the Game class
- * @version 1.1
- * @date 2020-11-30
+ * @version 1.6
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -11,14 +11,16 @@
  */
 
 #include "game.h"
+#include "MessageLibrary.h" //Wrapping of the board time
 
 //Game constructor, game must be instantiated with atleast wintype and corresponding threshold (be it time or points)
-game::game(bool gameFinisheshOnScore, unsigned gameWinValue)
+game::game(bool gameFinisheshOnScore, unsigned gameWinValue) :
+    clock(gameFinisheshOnScore ? 0 : 1000UL*gameWinValue)
 {
-    //Initialize all game status values to zero
-    playerAScore = 0;
-    playerBScore = 0;
-    gameFinished = false;
+    //The board time is unknown until the game is started with it
+    boardTimeAligned = false;
+    boardTimeAtStart = 0;
+    gameTimeAtStart = 0;
 
     //If the game finishes on score
     if(gameFinisheshOnScore){
@@ -42,103 +44,147 @@ game::game(bool gameFinisheshOnScore, unsigned gameWinValue)
 
     }
 
+    //Reserve the goal columns, a game on score has at most one goal less than twice the score limit
+    unsigned long goalCapacity = gameWinOnScore ? 2*gameScoreLimit : GAME_GOAL_CAPACITY;
+    goalSpeeds.reserve(goalCapacity);
+    goalTimes.reserve(goalCapacity);
+    goalSides.reserve(goalCapacity);
+    goalEvents.reserve(goalCapacity);
+
 }
 
 
-//Copy constructor for game
-game::game(const game &copyGame){
+//Function that records an event of the game at the current game time
+void game::recordEvent(unsigned char type){
 
-    //Player Scores
-    playerAScore = copyGame.playerAScore;
-    playerBScore = copyGame.playerBScore;
+    gameEvent event = gameEvent();
+    event.type = type;
+    event.time = static_cast<unsigned>(clock.getElapsedTime());
 
-    //Game Status variables
-    gameFinished = copyGame.gameFinished;
-    gameWinOnScore = copyGame.gameWinOnScore;
-    gameUsesAlarm = copyGame.gameUsesAlarm;
-    gameScoreLimit = copyGame.gameScoreLimit;
-    gameTimeLimit = copyGame.gameTimeLimit;
-    gameStartTime = copyGame.gameStartTime;
+    log.append(event);
 
-    //Goal Vector
-    goalList = copyGame.goalList;
-}
+};
 
 
-//Function to start the game throwing an alarm when complete
-void game::startGameWithAlarm(){
+//Function to start or resume the game
+void game::startGame(){
 
-    //Record the starting time
-    gameStartTime = std::time(NULL);
+    //A finished game is never restarted
+    if(log.getState().finished) return;
 
-    //Set a system alarm for the end time (if no time limit, no alarm will be set)
-    alarm(gameTimeLimit);
+    //Record the first start, or a resume after a pause
+    if(!log.getState().started) recordEvent(GAME_EVENT_START);
+    else if(!log.getState().running) recordEvent(GAME_EVENT_RESUME);
 
-    //Indicate that this game uses csignal's alarm
-    gameUsesAlarm = true;
+    //Start counting the game time
+    clock.start();
 
+    //Without the board time, goals are timed when they are added
+    boardTimeAligned = false;
 
 }
 
-//Function to pause the game
-void game::pauseGame(){
+//Function to start or resume the game, aligned with the board time
+void game::startGame(unsigned long boardTimestamp){
 
-    //Clear the pending game alarm, if the game used one
-    if(gameUsesAlarm) alarm(0);
+    //A finished game is never restarted
+    if(log.getState().finished) return;
 
-    //If the game win type is a time limit
-    if(!gameWinOnScore){
+    //Record the first start, or a resume after a pause
+    if(!log.getState().started) recordEvent(GAME_EVENT_START);
+    else if(!log.getState().running) recordEvent(GAME_EVENT_RESUME);
 
-        //The game time limit is the current remainder of time
-        gameTimeLimit = gameTimeLimit - (std::time(NULL) - gameStartTime);
+    //Start counting the game time
+    clock.start();
 
-    }
+    //Remember which board time matches the game time of this running period
+    boardTimeAtStart = boardTimestamp;
+    gameTimeAtStart = clock.getElapsedTime();
+    boardTimeAligned = true;
 
+}
 
-};
+//Function to pause the game
+void game::pauseGame(){
 
-//Function to stop/end the game
-void game::endGame(){
+    //Stop counting the game time, the time counted so far is kept
+    clock.pause();
 
-    //clear any pending alarms
-    if(gameUsesAlarm) alarm(0);
+    //Record the pause, if the game was running
+    if(log.getState().running) recordEvent(GAME_EVENT_PAUSE);
 
-    //If the game win type is a time limit
-    if(!gameWinOnScore){
+};
 
-        //Set the remaining time limit to 0 to prevent further execution
-        gameTimeLimit = 0;
+//Function to stop/end the game
+void game::endGame(){
 
-    }
+    //Stop counting the game time, the elapsed time is kept as the length of the game
+    clock.pause();
 
     //Indicate that the game is completed
-    gameFinished = true;
+    if(!log.getState().finished) recordEvent(GAME_EVENT_END);
 
 };
 
 //Function to add a goal, given the speed and side
 void game::addGoal(unsigned goalSpeed, bool onBSide){
 
+    //Without a board time, the goal is timed when it is added
+    addGoalAtTime(goalSpeed, onBSide, clock.getElapsedTime());
 
-    //Create a new goal with the given information, and add it to game goal vector
-    goalList.push_back(goal(goalSpeed, std::time(NULL), onBSide));
+};
 
-    //If the goal was on the robot side
-    if(onBSide){
+//Function to add a goal, given the speed, side and board time
+void game::addGoal(unsigned goalSpeed, bool onBSide, unsigned long boardTimestamp){
 
-        //Increment Player A's score
-        playerAScore++;
+    //The goal is timed when the embedded system saw it
+    addGoalAtTime(goalSpeed, onBSide, boardTimeToGameTime(boardTimestamp));
 
-    }
-    //Otherwise if it's on the human/Player A side
-    else{
+    //Mark the goal as added for latency measurements, by the board time that names it
+    LatencyProbe::instance().mark(LATENCY_STAGE_ADDED, boardTimestamp);
 
-        //Increment Player B's score
-        playerBScore++;
-    }
+};
+
+//Function that converts a board time into game time
+unsigned long game::boardTimeToGameTime(unsigned long boardTimestamp){
+
+    unsigned long now = clock.getElapsedTime();
+
+    //If the board time of this running period is unknown, the current game time is the best estimate
+    if(!boardTimeAligned) return now;
+
+    //Time since the start of the running period, the board time wraps so the difference is taken modulo the wrap
+    unsigned long sinceStart = ((boardTimestamp - boardTimeAtStart) & ML_TIMESTAMP_MASK)/1000;
+
+    //A goal is never in the future (the board and game clocks start a link delay apart)
+    if(gameTimeAtStart + sinceStart > now) return now;
+
+    return gameTimeAtStart + sinceStart;
+
+};
+
+//Function to add a goal at a given game time
+void game::addGoalAtTime(unsigned goalSpeed, bool onBSide, unsigned long goalTime){
+
+    //Record the goal, the scores and statistics of the players are updated from it (goals on B side are scored by player A)
+    gameEvent event = gameEvent();
+    event.type = GAME_EVENT_GOAL;
+    event.onBSide = onBSide;
+    event.speed = static_cast<int>(goalSpeed);
+    event.time = static_cast<unsigned>(goalTime);
+
+    goalEvents.push_back(static_cast<unsigned>(log.getEventCount()));
+    log.append(event);
+
+    //Add the goal to the end of each goal column
+    goalSpeeds.push_back(static_cast<int>(goalSpeed));
+    goalTimes.push_back(static_cast<unsigned>(goalTime));
+    goalSides.push_back(onBSide);
+
+    const gameState &state = log.getState();
 
     //If we are going by the first to reach a certain score, and either player A or B has reached the thershold
-    if ((gameWinOnScore) && ((playerAScore >= gameScoreLimit) || (playerBScore >= gameScoreLimit))){
+    if ((gameWinOnScore) && ((state.playerAScore >= gameScoreLimit) || (state.playerBScore >= gameScoreLimit))){
 
         //The game has been won, end the game
         endGame();
@@ -150,7 +196,7 @@ void game::addGoal(unsigned goalSpeed, bool onBSide){
 unsigned long game::getPlayerAScore(){
 
     //Return player A's score
-    return playerAScore;
+    return log.getState().playerAScore;
 
 };
 
@@ -158,7 +204,7 @@ unsigned long game::getPlayerAScore(){
 unsigned long game::getPlayerBScore(){
 
     //Return player B's score
-    return playerBScore;
+    return log.getState().playerBScore;
 
 };
 
@@ -175,15 +221,100 @@ bool game::getDoesGameFinishOnScore(){
 bool game::isGameFinished(){
 
     //Return the status of the game
-    return gameFinished;
+    return log.getState().finished;
+
+
+};
+
+//Function that returns the elapsed game time in milliseconds
+unsigned long game::getElapsedTime(){
+
+    //Return the time counted by the game clock
+    return clock.getElapsedTime();
+
+};
+
+//Function that returns the remaining game time in milliseconds
+unsigned long game::getRemainingTime(){
+
+    //Return the time left on the game clock (0 if the game has no time limit)
+    return clock.getRemainingTime();
+
+};
+
+//Function that returns the number of goals in the game
+unsigned long game::getGoalCount(){
+
+    //Every column holds one element per goal
+    return goalSpeeds.size();
+
+};
+
+//Function that returns one goal of the game
+goal game::getGoal(unsigned long index){
+
+    //Put the goal back together from its columns
+    return goal(goalSpeeds[index], goalTimes[index], goalSides[index]);
+
+};
+
+//Function that returns the speed column of the goals
+const int *game::getGoalSpeeds(){
+
+    return goalSpeeds.data();
+
+};
+
+//Function that returns the time column of the goals
+const unsigned *game::getGoalTimes(){
+
+    return goalTimes.data();
+
+};
+
+//Function that returns the side column of the goals
+const std::vector<bool> &game::getGoalSides(){
+
+    return goalSides;
+
+};
+
+//Function that returns the statistics of player A
+goalStatistics game::getPlayerAStatistics(){
+
+    return log.getState().playerAStatistics;
+
+};
+
+//Function that returns the statistics of player B
+goalStatistics game::getPlayerBStatistics(){
+
+    return log.getState().playerBStatistics;
+
+};
+
+//Function to retract a disputed goal
+void game::retractGoal(unsigned long index){
+
+    //Record the correction, the state of the game is then folded again without the goal
+    gameEvent event = gameEvent();
+    event.type = GAME_EVENT_CORRECTION;
+    event.time = static_cast<unsigned>(clock.getElapsedTime());
+    event.target = goalEvents[index];
+
+    log.append(event);
 
+    //Remove the goal from each goal column
+    goalSpeeds.erase(goalSpeeds.begin() + index);
+    goalTimes.erase(goalTimes.begin() + index);
+    goalSides.erase(goalSides.begin() + index);
+    goalEvents.erase(goalEvents.begin() + index);
 
 };
 
-//Function that returns an iterator of the goal list
-std::vector<goal>::iterator game::getGoalList(){
+//Function that gives access to the events of the game
+const gameLog &game::getLog(){
 
-    //Return an iterator from the front of the goal list
-    return goalList.begin();
+    return log;
 
 };
@@ -6,12 +6,18 @@
  * Each goal object results in an increment of one point to the player it is credited to (either player A or player B)
  * No calculations are made as to the winner of the game, all that is set is a flag indicating the game is finished
  * when a player reaches a pre-defined score threshold, or if stopGame() is called
- * If specified at time of construction, the game class will throw a POSIX timer interrupt after a specified number of game seconds
- * (game seconds are counted after startGameWithTimer() is called, and not counted after pauseGame() or endGame()
- * Otherwise this functionality can be ignored to handle game timing externally
+ * The game time is kept by a gameClock with millisecond accuracy (game time is counted after startGame() is called, and not
+ * counted after pauseGame() or endGame()). For a game with a time limit, the owner of the game schedules the end of the game
+ * using getRemainingTime(), and calls endGame() when it is reached
+ * Goals are stored column-wise (speeds, times and sides), and the statistics of the goals of each player are updated on every
+ * goal, so they can be shown without going over the goals again
+ * Every start, goal, pause, resume, correction and end is recorded in a gameLog, and the scores, statistics and status of the
+ * game are the state folded from that log. A disputed goal can be retracted, and any past state of the game rebuilt
+ * A game is move-only: it is handed from the game display to the match and on to storage without its goals and events ever
+ * being copied
  *
- * @version 1.1
- * @date 2020-11-30
+ * @version 1.5
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -22,9 +28,12 @@
 #define GAME_H
 
 #include "goal.h"  //Game is composed of goals
-#include<vector>  //Vector for storing array of goals
-#include<ctime>  //Keep track of the time - remove if removing alarm functions
-#include<unistd.h> // set up timer interrupt
+#include "LatencyProbe.h" //Goals are marked for latency measurements when added
+#include "gameclock.h" //Game is timed by a game clock
+#include "gamelog.h" //Game is recorded as a log of events
+#include<vector>  //Vectors for storing the columns of the goals
+
+#define GAME_GOAL_CAPACITY 64 //!< Number of goals the columns are reserved for when the game has no score limit
 
 #include<iostream> //debug
 
@@ -35,53 +44,77 @@
  * Each goal object results in an increment of one point to the player it is credited to (either player A or player B)
  * No calculations are made as to the winner of the game, all that is set is a flag indicating the game is finished
  * when a player reaches a pre-defined score threshold, or if stopGame() is called
- * If specified at time of construction, the game class will throw a POSIX timer interrupt after a specified number of game seconds
- * (game seconds are counted after startGameWithTimer() is called, and not counted after pauseGame() or endGame()
- * Otherwise this functionality can be ignored to handle game timing externally
+ * The game time is kept by a gameClock with millisecond accuracy (game time is counted after startGame() is called, and not
+ * counted after pauseGame() or endGame()). For a game with a time limit, the owner of the game schedules the end of the game
+ * using getRemainingTime(), and calls endGame() when it is reached
  */
 class game
 {
 
 private:
 
-    //Player Scores
-    unsigned long playerAScore; //!< Stores the score of player A (always >= 0)
-    unsigned long playerBScore; //!< Stores the score of player B (always >= 0)
+    //Game Events (the scores, goal statistics and status of the game are folded from the events)
+    gameLog log; //!< Every event of the game, and the state of the game folded from them
 
     //Game Status variables
-    bool gameFinished; //!< Status of the game, if true, game has finished
     bool gameWinOnScore; //!< Is true if the game wins on a player reaching a certain score
-    bool gameUsesAlarm; //!< Is true if the game object throws a SIGALRM that must be handled
     unsigned long gameScoreLimit; //!< If the game has a score limit, it is stored using this variable
     unsigned long gameTimeLimit; //!< If the game has a time limit, it is stored using this variable (seconds)
-    unsigned long gameStartTime; //!< Stores the UNIX time when the game has started for internal reference
 
-    //Goal Vector
-    std::vector<goal> goalList; //!< A vector of goal objects, storing all the goals in the game
+    //Game Time
+    gameClock clock; //!< Counts the game time while the game is running, and the time remaining if the game has a time limit
+
+    //Board Time Alignment
+    bool boardTimeAligned; //!< Is true if the board time when the game was last started/resumed is known
+    unsigned long boardTimeAtStart; //!< Board time when the game was last started/resumed on the embedded system [us]
+    unsigned long gameTimeAtStart; //!< Game time when the game was last started/resumed [ms]
+
+    //Goal Columns (goal i is made of element i of each column)
+    std::vector<int> goalSpeeds; //!< Speed of each goal in the game (unspecified units)
+    std::vector<unsigned> goalTimes; //!< Time of each goal from the start of the game [ms]
+    std::vector<bool> goalSides; //!< Side of each goal, 'true' if on B side (stored as bits)
+    std::vector<unsigned> goalEvents; //!< Index of the goal event of each goal in the log
 
 public:
 
     /**
      * @brief game - Game constructor, game must be instantiated with atleast wintype and corresponding threshold (time[s] or points)
      * @param doesGameFinishOnScore - True if the game wins on reaching a point threshold, false otherwise
-     * @param gameWinValue - If game finishes on score, this is the score in points, otherwise this is an optional parameter taking time in seconds if using internal alarm functionality
+     * @param gameWinValue - If game finishes on score, this is the score in points, otherwise this is the time limit in seconds (0 for no time limit)
      */
     game(bool doesGameFinishOnScore, unsigned gameWinValue = 0);
 
 
     /**
-     * @brief game - Basic copy constructor for game
-     * @param copyGame
+     * @brief game - Move constructor for game, the goals and events are taken over from the moved game (which is then empty)
+     * @param moveGame
+     */
+    game(game &&moveGame) = default;
+
+    /**
+     * @brief operator= - Move assignment for game, the goals and events are taken over from the moved game (which is then empty)
+     * @param moveGame
+     * @return this game
      */
-    game(const game &copyGame);
+    game &operator=(game &&moveGame) = default;
+
+    //A game is never copied, it is moved from one owner to the next
+    game(const game &) = delete;
+    game &operator=(const game &) = delete;
 
     /**
-     * @brief startGameWithAlarm - Function to start/resume the game with SIGALRM
+     * @brief startGame - Function to start/resume the game clock
      */
-    void startGameWithAlarm();
+    void startGame();
 
     /**
-     * @brief pauseGame - Function to pause the game if using SIGALRM
+     * @brief startGame - Function to start/resume the game clock, aligned with the board time at which the embedded system started/resumed the game
+     * @param boardTimestamp - Board time [us] returned by the embedded system when the game was made active (see ML_TIMESTAMP_MASK)
+     */
+    void startGame(unsigned long boardTimestamp);
+
+    /**
+     * @brief pauseGame - Function to pause the game clock
      */
     void pauseGame();
 
@@ -97,6 +130,14 @@ public:
      */
     void addGoal(unsigned goalSpeed, bool onBSide);
 
+    /**
+     * @brief addGoal - Function to add a goal stamped by the embedded system, the goal time is then independent of when the goal was read
+     * @param goalSpeed - goal speed (unspecified units)
+     * @param onBSide - true if scored on side B, i.e. if Player A has scored
+     * @param boardTimestamp - Board time [us] at which the goal was scored (see ML_TIMESTAMP_MASK)
+     */
+    void addGoal(unsigned goalSpeed, bool onBSide, unsigned long boardTimestamp);
+
     /**
      * @brief getPlayerAScore - Function that returns the score of player A
      * @return Player A score as unsigned int
@@ -122,10 +163,95 @@ public:
     bool isGameFinished();
 
     /**
-     * @brief getGoalList - Function that gives access to the vector of goals
-     * @return vector iterator for goal objects, starting at the first goal score in the game
+     * @brief getElapsedTime - Function that returns the game time counted while the game was running
+     * @return Elapsed game time in milliseconds
+     */
+    unsigned long getElapsedTime();
+
+    /**
+     * @brief getRemainingTime - Function that returns the game time left before the time limit
+     * @return Remaining game time in milliseconds (0 if the game finishes on score, or the time limit was reached)
+     */
+    unsigned long getRemainingTime();
+
+    /**
+     * @brief getGoalCount - Function that returns the number of goals in the game
+     * @return number of goals scored by both players
+     */
+    unsigned long getGoalCount();
+
+    /**
+     * @brief getGoal - Function that returns one goal of the game
+     * @param index - index of the goal, in the order they were scored (must be less than getGoalCount())
+     * @return goal object with the speed, time and side of the goal
+     */
+    goal getGoal(unsigned long index);
+
+    /**
+     * @brief getGoalSpeeds - Function that gives access to the speed column of the goals, for analysis over all the goals
+     * @return pointer to getGoalCount() contiguous goal speeds, in the order they were scored
+     */
+    const int *getGoalSpeeds();
+
+    /**
+     * @brief getGoalTimes - Function that gives access to the time column of the goals, for analysis over all the goals
+     * @return pointer to getGoalCount() contiguous goal times [ms], in the order they were scored
+     */
+    const unsigned *getGoalTimes();
+
+    /**
+     * @brief getGoalSides - Function that gives access to the side column of the goals
+     * @return bit vector with 'true' for each goal on B side, in the order they were scored
+     */
+    const std::vector<bool> &getGoalSides();
+
+    /**
+     * @brief getPlayerAStatistics - Function that returns the statistics of the goals scored by player A, kept up to date on every goal
+     * @return goal count, fastest goal, mean and variance of the speed, and longest streak of player A
+     */
+    goalStatistics getPlayerAStatistics();
+
+    /**
+     * @brief getPlayerBStatistics - Function that returns the statistics of the goals scored by player B, kept up to date on every goal
+     * @return goal count, fastest goal, mean and variance of the speed, and longest streak of player B
+     */
+    goalStatistics getPlayerBStatistics();
+
+    /**
+     * @brief retractGoal - Function to retract a disputed goal (referee correction), the goal is removed and the scores and statistics no longer count it
+     * A correction does not restart a game that was finished
+     * @param index - index of the goal, in the order they were scored (must be less than getGoalCount())
+     */
+    void retractGoal(unsigned long index);
+
+    /**
+     * @brief getLog - Function that gives access to the events of the game, for replay, storage and past states
+     * @return log of the game
+     */
+    const gameLog &getLog();
+
+private:
+
+    /**
+     * @brief addGoalAtTime - Function that adds a goal at a given game time, and updates the scores
+     * @param goalSpeed - goal speed (unspecified units)
+     * @param onBSide - true if scored on side B, i.e. if Player A has scored
+     * @param goalTime - game time of the goal [ms]
+     */
+    void addGoalAtTime(unsigned goalSpeed, bool onBSide, unsigned long goalTime);
+
+    /**
+     * @brief recordEvent - Function that records an event of the game at the current game time
+     * @param type - one of the GAME_EVENT defines (not a goal or correction, which carry more information)
+     */
+    void recordEvent(unsigned char type);
+
+    /**
+     * @brief boardTimeToGameTime - Function that converts a board time of the current running period into game time
+     * @param boardTimestamp - Board time [us]
+     * @return game time [ms], never later than the current game time
      */
-    std::vector<goal>::iterator getGoalList();
+    unsigned long boardTimeToGameTime(unsigned long boardTimestamp);
 
 };
 
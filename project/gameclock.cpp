@@ -0,0 +1,102 @@
+/**
+ * @file gameclock.cpp
+ * @author Sanjayan Kulendran
+ * @brief Implementation file used to implement the gameClock class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "gameclock.h"
+
+//Clock constructor, the clock is stopped at zero until start() is called
+gameClock::gameClock(unsigned long timeLimitMilliseconds)
+{
+    elapsedBeforeStart = std::chrono::steady_clock::duration::zero();
+    startTime = std::chrono::steady_clock::now();
+    timeLimit = std::chrono::milliseconds(timeLimitMilliseconds);
+    running = false;
+}
+
+
+//Function to start or resume the clock
+void gameClock::start(){
+
+    //If the clock is already counting, there is nothing to do
+    if(running) return;
+
+    //Remember when this running period began
+    startTime = std::chrono::steady_clock::now();
+    running = true;
+
+}
+
+
+//Function to pause the clock
+void gameClock::pause(){
+
+    //If the clock is not counting, there is nothing to do
+    if(!running) return;
+
+    //Add the running period that just ended to the time counted so far
+    elapsedBeforeStart += std::chrono::steady_clock::now() - startTime;
+    running = false;
+
+}
+
+
+//Function that returns true if the clock is counting
+bool gameClock::isRunning() const{
+
+    return running;
+
+}
+
+
+//Function that returns true if the clock has a time limit
+bool gameClock::hasTimeLimit() const{
+
+    return timeLimit != std::chrono::steady_clock::duration::zero();
+
+}
+
+
+//Function that returns the elapsed game time in milliseconds
+unsigned long gameClock::getElapsedTime() const{
+
+    std::chrono::steady_clock::duration elapsed = elapsedBeforeStart;
+
+    //Include the current running period, if any
+    if(running) elapsed += std::chrono::steady_clock::now() - startTime;
+
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+
+}
+
+
+//Function that returns the remaining game time in milliseconds
+unsigned long gameClock::getRemainingTime() const{
+
+    //Without a time limit, there is no remaining time to count down
+    if(!hasTimeLimit()) return 0;
+
+    unsigned long limit = static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(timeLimit).count());
+    unsigned long elapsed = getElapsedTime();
+
+    //The remaining time never goes below zero
+    if(elapsed >= limit) return 0;
+
+    return limit - elapsed;
+
+}
+
+
+//Function that returns true if the time limit has been reached
+bool gameClock::isExpired() const{
+
+    return hasTimeLimit() && (getRemainingTime() == 0);
+
+}
@@ -0,0 +1,172 @@
+/**
+ * @file gamelog.cpp
+ * @author Sanjayan Kulendran
+ * @brief Implementation file used to implement the gameLog class
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "gamelog.h"
+
+#include<algorithm>  //Sorting and searching the retracted goals
+
+//Log constructor, the log starts empty with the state of a game not started yet
+gameLog::gameLog()
+{
+    state = gameState();
+
+    //The empty state is the first snapshot
+    snapshots.push_back(state);
+}
+
+
+//Function that folds one event into a state
+void gameLog::applyEvent(gameState &foldState, const gameEvent &event, bool retracted){
+
+    foldState.events++;
+
+    switch(event.type){
+
+    case GAME_EVENT_START:
+    case GAME_EVENT_RESUME:
+        foldState.started = true;
+        foldState.running = !foldState.finished;
+        break;
+
+    case GAME_EVENT_PAUSE:
+        foldState.running = false;
+        break;
+
+    case GAME_EVENT_END:
+        foldState.running = false;
+        foldState.finished = true;
+        break;
+
+    case GAME_EVENT_CORRECTION:
+        //The retracted goal itself is skipped by the fold
+        foldState.corrections++;
+        break;
+
+    case GAME_EVENT_GOAL:
+    {
+        //A retracted goal counts for nothing
+        if(retracted) break;
+
+        //A goal by the same player as the last goal extends the streak, otherwise a new streak begins
+        unsigned long goalCount = foldState.playerAScore + foldState.playerBScore;
+        if((goalCount > 0) && (foldState.lastGoalOnBSide == event.onBSide)) foldState.currentStreak++;
+        else foldState.currentStreak = 1;
+        foldState.lastGoalOnBSide = event.onBSide;
+
+        //Goals on B side are scored by player A
+        if(event.onBSide) foldState.playerAScore++;
+        else foldState.playerBScore++;
+
+        goalStatistics &statistics = event.onBSide ? foldState.playerAStatistics : foldState.playerBStatistics;
+        double speed = static_cast<double>(event.speed);
+
+        statistics.count++;
+        if(event.speed > statistics.maxSpeed) statistics.maxSpeed = event.speed;
+
+        //Welford's method, updates the mean and variance without going over the previous goals again
+        double deviation = speed - statistics.meanSpeed;
+        statistics.meanSpeed += deviation/statistics.count;
+        statistics.speedSquaredDeviations += deviation*(speed - statistics.meanSpeed);
+        if(statistics.count > 1) statistics.speedVariance = statistics.speedSquaredDeviations/(statistics.count - 1);
+
+        if(foldState.currentStreak > statistics.longestStreak) statistics.longestStreak = foldState.currentStreak;
+        break;
+    }
+
+    default:
+        break;
+
+    }
+
+}
+
+
+//Function to append an event to the log
+void gameLog::append(const gameEvent &event){
+
+    events.push_back(event);
+
+    //A correction changes the past, so the state is rebuilt from before the retracted goal, otherwise the event is simply folded in
+    if(event.type == GAME_EVENT_CORRECTION) state = getStateAt(events.size());
+    else applyEvent(state, event, false);
+
+    //Keep a snapshot at every interval
+    if((events.size() % GAME_LOG_SNAPSHOT_INTERVAL) == 0) snapshots.push_back(state);
+
+}
+
+
+//Function that returns the state after all the events
+const gameState &gameLog::getState() const{
+
+    return state;
+
+}
+
+
+//Function that rebuilds the state after a number of events
+gameState gameLog::getStateAt(unsigned long eventCount) const{
+
+    if(eventCount > events.size()) eventCount = events.size();
+
+    //Start from the closest snapshot, a correction on an interval is folded before its snapshot is kept
+    unsigned long start = eventCount/GAME_LOG_SNAPSHOT_INTERVAL;
+    if(start >= snapshots.size()) start = snapshots.size() - 1;
+    std::vector<unsigned long> retracted;
+
+    while(true){
+
+        //Find the goals retracted by the events to fold
+        retracted.clear();
+        unsigned long earliestTarget = eventCount;
+
+        for(unsigned long i = start*GAME_LOG_SNAPSHOT_INTERVAL; i < eventCount; i++){
+            if(events[i].type == GAME_EVENT_CORRECTION){
+                retracted.push_back(events[i].target);
+                if(events[i].target < earliestTarget) earliestTarget = events[i].target;
+            }
+        }
+
+        //If a retracted goal is before the snapshot, the snapshot still counts it, so start from an earlier snapshot
+        if(earliestTarget >= start*GAME_LOG_SNAPSHOT_INTERVAL) break;
+        start = earliestTarget/GAME_LOG_SNAPSHOT_INTERVAL;
+
+    }
+
+    std::sort(retracted.begin(), retracted.end());
+
+    //Fold the events since the snapshot, skipping the retracted goals
+    gameState foldState = snapshots[start];
+
+    for(unsigned long i = start*GAME_LOG_SNAPSHOT_INTERVAL; i < eventCount; i++){
+        applyEvent(foldState, events[i], std::binary_search(retracted.begin(), retracted.end(), i));
+    }
+
+    return foldState;
+
+}
+
+
+//Function that returns the number of events in the log
+unsigned long gameLog::getEventCount() const{
+
+    return events.size();
+
+}
+
+
+//Function that gives access to the events
+const std::vector<gameEvent> &gameLog::getEvents() const{
+
+    return events;
+
+}
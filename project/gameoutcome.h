@@ -2,20 +2,22 @@
 #define GAMEOUTCOME_H
 
 #include<string>
+#include<vector>
+#include "game.h"
 
 /**
- * @brief The gameOutcome struct provides a database-friendly structure to store game data
+ * @brief The matchOutcome struct provides a database-friendly structure to store the games of a match
+ * The details that are the same for every game of the match are stored once, and the games are moved in (never copied)
  */
-struct gameOutcome{
+struct matchOutcome{
 
-    std::string playerAName; ///<Name of player A in the game
-    std::string playerBName; ///<Name of player B in the game
+    std::string playerAName; ///<Name of player A in the match
+    std::string playerBName; ///<Name of player B in the match
     std::string matchID; ///<unique ID to associate each game to a match
-
-    unsigned long playerAScore; ///<final score of player A
-    unsigned long playerBScore; ///<final score of player B
     unsigned long tableMode; ///<table mode configuration
 
+    std::vector<game> games; ///<games of the match, in the order they were played
+
 
 };
 
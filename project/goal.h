@@ -3,9 +3,10 @@
  * @author Sanjayan Kulendran
  * @brief Header file used to declare the Goal class.
  * Simple goal class that stores a goal speed in unspecified units and a boolean representing the side the goal is on
+ * The time of the goal is the game time when it was scored, in milliseconds from the start of the game
  *
- * @version 1.0
- * @date 2020-11-30
+ * @version 1.1
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -26,7 +27,7 @@ private:
 
     int speed; //!< Integer holding the goal speed [m/s]
 
-    unsigned timeStamp; //!< Unsigned integer giving time of goal from the start of the game [s]
+    unsigned timeStamp; //!< Unsigned integer giving time of goal from the start of the game [ms] (paused time is not counted)
 
     bool onBSide; //!< Boolean value indicating whether the goal was on player B side of the table
 
@@ -37,7 +38,7 @@ public:
     /**
      * @brief goal - Constructor taking all goal parameters
      * @param initialSpeed - Speed of goal in unspecified units
-     * @param initialTimeStamp - Time of goal (unspecified, but likely UNIX time in seconds since epoch)
+     * @param initialTimeStamp - Time of goal from the start of the game in milliseconds
      * @param goalIsOnBSide - Boolean value 'true' if the goal was score against player b's side
      */
     goal(int initialSpeed, unsigned initialTimeStamp, bool goalIsOnBSide);
@@ -56,7 +57,7 @@ public:
 
     /**
      * @brief getTime - Getter for goal time
-     * @return - unsigned value giving the time assocaited with the goal
+     * @return - unsigned value giving the time of the goal from the start of the game in milliseconds
      */
     unsigned getTime();
 
@@ -0,0 +1,223 @@
+/**
+ * @file historymodel.cpp
+ * @author Ali Sarfraz
+ * @brief Implementation file used to implement the historyModel class
+ * @version 0.3
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "historymodel.h"
+
+#include "MessageLibrary.h"
+
+// Columns of the table.
+static const char* columnNames[] = {"Match ID", "Player A", "Player B", "A Score", "B Score", "Table Mode"};
+
+// Returns a text column of the current row of a statement.
+static QString columnText(sqlite3_stmt* stmt, int column)
+{
+    return QString::fromUtf8(reinterpret_cast<const char*>(sqlite3_column_text(stmt, column)));
+}
+
+historyModel::historyModel(matchStorage *storage, QObject *parent) :
+    QAbstractTableModel(parent),
+    storage(storage),
+    playerID(0),
+    rows(0),
+    finished(true)
+{
+}
+
+int historyModel::setPlayer(const QString &name)
+{
+    beginResetModel();
+
+    playerID = 0;
+    pageStarts.clear();
+    pages.clear();
+    recentPages.clear();
+    rows = 0;
+    finished = true;
+
+    // Look the player up once by name.
+    sqlite3_stmt* qry = (storage != nullptr) ? storage->prepare(storage->getReader(), "select id, (select max(id) from matches) from players where name = ?;") : NULL;
+
+    if (qry != NULL) {
+        QByteArray player_name = name.toUtf8();
+        sqlite3_bind_text(qry, 1, player_name.constData(), -1, SQLITE_TRANSIENT);
+
+        // The history ends at the last match stored now, so the rows do not move as matches are added.
+        if (sqlite3_step(qry) == SQLITE_ROW) {
+            playerID = sqlite3_column_int64(qry, 0);
+            pageStarts.push_back(std::make_pair(sqlite3_column_int64(qry, 1) + 1, 0));
+            finished = false;
+        }
+        sqlite3_reset(qry);
+    }
+
+    endResetModel();
+
+    // Read the first page.
+    if (canFetchMore(QModelIndex())) {
+        fetchMore(QModelIndex());
+    }
+
+    return rows;
+}
+
+int historyModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows;
+}
+
+int historyModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(sizeof(columnNames) / sizeof(columnNames[0]));
+}
+
+QVariant historyModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (role != Qt::DisplayRole) || (index.row() >= rows)) return QVariant();
+
+    // Only the page of the row is read, if it is not kept.
+    const std::vector<historyRow> &page = getPage(index.row() / HISTORY_PAGE_SIZE);
+    unsigned long offset = static_cast<unsigned long>(index.row() % HISTORY_PAGE_SIZE);
+    if (offset >= page.size()) return QVariant();
+
+    const historyRow &row = page[offset];
+
+    switch (index.column()) {
+    case 0:
+        return row.matchKey;
+    case 1:
+        return row.playerAName;
+    case 2:
+        return row.playerBName;
+    case 3:
+        return row.playerAScore;
+    case 4:
+        return row.playerBScore;
+    case 5:
+        // Switch on the table mode.
+        switch (row.tableMode) {
+        case ML_STANDARD:
+            return QString("Standard");
+        case ML_ACCESSABILITY:
+            return QString("Accessability");
+        case ML_AI:
+            return QString("AI");
+        }
+        return row.tableMode;
+    }
+
+    return QVariant();
+}
+
+QVariant historyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if ((role != Qt::DisplayRole) || (orientation != Qt::Horizontal)) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    if ((section < 0) || (section >= columnCount())) return QVariant();
+
+    return QString(columnNames[section]);
+}
+
+bool historyModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !finished;
+}
+
+void historyModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) return;
+
+    // The next page starts after the last game read.
+    int page = static_cast<int>(pageStarts.size()) - 1;
+    std::vector<historyRow> read;
+    readPage(pageStarts.back(), read);
+
+    // A page that is not full is the last one.
+    if (read.size() < HISTORY_PAGE_SIZE) {
+        finished = true;
+    }
+    else {
+        pageStarts.push_back(std::make_pair(read.back().matchID, read.back().gameNumber));
+    }
+
+    if (read.empty()) return;
+
+    beginInsertRows(QModelIndex(), rows, rows + static_cast<int>(read.size()) - 1);
+    rows += static_cast<int>(read.size());
+    pages[page].swap(read);
+    endInsertRows();
+
+    // Mark the page as the most recently used, dropping the least recently used pages.
+    getPage(page);
+}
+
+const std::vector<historyModel::historyRow> &historyModel::getPage(int page) const
+{
+    auto found = pages.find(page);
+
+    if (found != pages.end()) {
+        // Move the page to the front of the recently used pages.
+        recentPages.remove(page);
+        recentPages.push_front(page);
+    }
+    else {
+        // Read the page again from the key it starts after.
+        found = pages.insert(std::make_pair(page, std::vector<historyRow>())).first;
+        readPage(pageStarts[static_cast<unsigned long>(page)], found->second);
+        recentPages.push_front(page);
+    }
+
+    while (recentPages.size() > HISTORY_CACHED_PAGES) {
+        pages.erase(recentPages.back());
+        recentPages.pop_back();
+    }
+
+    return found->second;
+}
+
+void historyModel::readPage(const std::pair<qint64, int> &after, std::vector<historyRow> &page) const
+{
+    page.clear();
+    page.reserve(HISTORY_PAGE_SIZE);
+
+    // Newest match first, and the games of a match in the order they were played. A page holds games of the match it
+    // starts in and of at most HISTORY_PAGE_SIZE matches after it, which are read in order from both player indexes, so a
+    // page costs the same wherever it is in the history. The union keeps a match the player played against themself once.
+    // Every stored match has a game, so a page is only short at the end.
+    sqlite3_stmt* qry = storage->prepare(storage->getReader(), "select g.match_id, g.game_number, m.match_key, a.name, b.name, g.a_score, g.b_score, m.table_mode"
+                                         " from games g join matches m on m.id = g.match_id"
+                                         " join players a on a.id = m.player_a join players b on b.id = m.player_b"
+                                         " where g.match_id in (select id from matches where player_a = ?1 and id <= ?2"
+                                         " union select id from matches where player_b = ?1 and id <= ?2 order by id desc limit ?4 + 1)"
+                                         " and (g.match_id < ?2 or (g.match_id = ?2 and g.game_number > ?3))"
+                                         " order by g.match_id desc, g.game_number limit ?4;");
+    if (qry == NULL) return;
+
+    sqlite3_bind_int64(qry, 1, playerID);
+    sqlite3_bind_int64(qry, 2, after.first);
+    sqlite3_bind_int(qry, 3, after.second);
+    sqlite3_bind_int(qry, 4, HISTORY_PAGE_SIZE);
+
+    while (sqlite3_step(qry) == SQLITE_ROW) {
+        historyRow row;
+        row.matchID = sqlite3_column_int64(qry, 0);
+        row.gameNumber = sqlite3_column_int(qry, 1);
+        row.matchKey = columnText(qry, 2);
+        row.playerAName = columnText(qry, 3);
+        row.playerBName = columnText(qry, 4);
+        row.playerAScore = sqlite3_column_int(qry, 5);
+        row.playerBScore = sqlite3_column_int(qry, 6);
+        row.tableMode = sqlite3_column_int(qry, 7);
+
+        page.push_back(row);
+    }
+    sqlite3_reset(qry);
+}
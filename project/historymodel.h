@@ -0,0 +1,154 @@
+/**
+ * @file historymodel.h
+ * @author Ali Sarfraz
+ * @brief Header file used to declare the table model of the game history of a player.
+ *
+ * This class shows the games of a player in a table view, newest match first, without reading
+ * the whole history. The games are read a page at a time as the view scrolls to the end of the
+ * rows read so far (canFetchMore and fetchMore). Each page is found from the last game of the
+ * page before it (keyset pagination), through the player indexes of the matches table, so a
+ * page deep in the history is read as quickly as the first one.
+ *
+ * Only a few pages are kept in memory, with the key each page starts after. A page scrolled
+ * back to after it was dropped is read again from its key, so the memory used stays the same
+ * however many games a player has. The history is the one stored when the player was searched,
+ * later matches are shown by searching again.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef HISTORYMODEL_H
+#define HISTORYMODEL_H
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "matchstorage.h"
+
+#define HISTORY_PAGE_SIZE 64 //!< Number of games read at a time
+#define HISTORY_CACHED_PAGES 8 //!< Number of pages of games kept in memory
+
+/**
+ * @brief The historyModel class reads the games of a player a page at a time, for a table view.
+ */
+class historyModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a model with no player.
+     *
+     * @param storage Storage service whose reader handle the games are read with.
+     * @param parent Parent object.
+     */
+    explicit historyModel(matchStorage *storage, QObject *parent = nullptr);
+
+    /**
+     * @brief Shows the games of a player, reading the first page.
+     *
+     * @param name Name of the player.
+     * @return Number of games read so far, 0 if the player has no stored game.
+     */
+    int setPlayer(const QString &name);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Indicates if there are games after the last page read.
+     *
+     * @param parent Unused, the model is a table.
+     * @return True if another page can be read.
+     */
+    bool canFetchMore(const QModelIndex &parent) const override;
+
+    /**
+     * @brief Reads the next page of games, and adds its rows.
+     *
+     * @param parent Unused, the model is a table.
+     */
+    void fetchMore(const QModelIndex &parent) override;
+
+private:
+    /**
+     * @brief One game of the history.
+     */
+    struct historyRow
+    {
+        qint64 matchID; //!< Key of the match
+        int gameNumber; //!< Number of the game in the match
+        QString matchKey; //!< Unique ID of the match
+        QString playerAName; //!< Name of player A
+        QString playerBName; //!< Name of player B
+        int playerAScore; //!< Score of player A
+        int playerBScore; //!< Score of player B
+        int tableMode; //!< Table mode of the match
+    };
+
+    /**
+     * @brief Storage service of the database.
+     */
+    matchStorage *storage;
+
+    /**
+     * @brief Key of the player shown, 0 if none.
+     */
+    qint64 playerID;
+
+    /**
+     * @brief Key of the game each page starts after (match, game), the first page starts after
+     * the last match stored when the player was searched.
+     */
+    std::vector<std::pair<qint64, int> > pageStarts;
+
+    /**
+     * @brief Number of rows read so far.
+     */
+    int rows;
+
+    /**
+     * @brief True once the last game of the player was read.
+     */
+    bool finished;
+
+    /**
+     * @brief Pages kept in memory, by page number.
+     */
+    mutable std::map<int, std::vector<historyRow> > pages;
+
+    /**
+     * @brief Page numbers of the pages kept, most recently used first.
+     */
+    mutable std::list<int> recentPages;
+
+    /**
+     * @brief Returns a page, reading it again if it was dropped, and drops the least recently
+     * used page if too many are kept.
+     *
+     * @param page Page number.
+     * @return Games of the page.
+     */
+    const std::vector<historyRow> &getPage(int page) const;
+
+    /**
+     * @brief Reads the games of the player after a key.
+     *
+     * @param after Key (match, game) of the game before the page.
+     * @param page Set to the games read, at most HISTORY_PAGE_SIZE.
+     */
+    void readPage(const std::pair<qint64, int> &after, std::vector<historyRow> &page) const;
+};
+
+#endif // HISTORYMODEL_H
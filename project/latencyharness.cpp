@@ -0,0 +1,92 @@
+/**
+ * @file latencyharness.cpp
+ * @author Matthew Bertuzzi
+ * @brief This file is responsible for measuring the goal-to-pixel latency of the HMI, from the moment the (simulated)
+ * embedded system sends a goal to the moment the gameDisplay shows the new score.
+ *
+ * A real gameDisplay is run on the offscreen Qt platform, so no screen is required, against the embedded system simulation
+ * configured to score goals quickly. Once the requested number of goals has been displayed, the latency distribution of
+ * every stage (see \ref LatencyProbe.h) is written to the standard output.
+ *
+ * The harness is built with LatencyHarness.pro and is run as:
+ *
+ * ./LatencyHarness [GOALS] [MIN_GOAL_DELAY_MS] [MAX_GOAL_DELAY_MS]
+ *
+ * By default 2000 goals are measured, one every 5 to 15 ms, which takes about 20 seconds.
+ *
+ * NOTE: The gameDisplay takes every goal waiting on each message poll, so the goals scored between two polls are measured
+ * together, and the time a goal waits for the poll is part of its dequeued stage
+ *
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <QApplication>
+#include <QTimer>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+#include "gamedisplay.h"
+#include "game.h"
+#include "player.h"
+#include "usermatchsettings.h"
+#include "tableconfigurationsettings.h"
+#include "MessageHandler.h"
+#include "LatencyProbe.h"
+
+
+int main(int argc, char *argv[]){
+
+    //Run without a screen unless a platform was requested explicitly
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty()){
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication a(argc, argv);
+
+    //Read the number of goals to measure and the range of times between goals
+    unsigned long goalCount = (argc > 1) ? strtoul(argv[1], NULL, 10) : 2000;
+    unsigned int minGoalDelay = (argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 10) : 5;
+    unsigned int maxGoalDelay = (argc > 3) ? (unsigned int)strtoul(argv[3], NULL, 10) : 15;
+
+    //The simulation must be configured before the MessageHandler singleton is created by the settings below
+    MessageHandler::setSimulatedGoalDelay(minGoalDelay, maxGoalDelay);
+    LatencyProbe::instance().enable(goalCount);
+
+    //Play a single timed game that is long enough to never end during the measurement
+    usermatchsettings matchSettings;
+    matchSettings.setGameVictoryType(1);
+    matchSettings.setGameTimeLimit(24 * 60);
+
+    tableconfigurationsettings tableConfig;
+    player playerA("Player A", 0, 0);
+    player playerB("Player B", 0, 0);
+
+    std::vector<game> games;
+    gameDisplay display(games, nullptr, &matchSettings, &tableConfig, &playerA, &playerB);
+    display.show();
+
+    std::cerr<<"Measuring "<<goalCount<<" goals, one every "<<minGoalDelay<<" to "<<maxGoalDelay<<" ms"<<std::endl;
+
+    //Check on the measurement regularly, and report once every goal has been displayed
+    QTimer progressTimer;
+    QObject::connect(&progressTimer, &QTimer::timeout, [&](){
+
+        if(LatencyProbe::instance().getStageCount(LATENCY_STAGE_DISPLAYED) >= goalCount){
+
+            LatencyProbe::instance().disable();
+            LatencyProbe::instance().writeReport(std::cout);
+
+            a.quit();
+        }
+
+    });
+    progressTimer.start(100);
+
+    return a.exec();
+
+}
@@ -0,0 +1,216 @@
+/**
+ * @file livestatistics.h
+ * @author Sanjayan Kulendran
+ * @brief Header file used to declare the liveStatistics class.
+ * The liveStatistics class keeps statistics of the goals of a game that are shown while the game is played: the goals per
+ * minute of each player over a rolling window, the median and 90th percentile of the goal speed of each player, and the
+ * momentum of each player (recent goals count more than older ones)
+ * Each goal is folded into structures of constant size as it is added, so an update costs the same at any point in the
+ * game, and the goals are never gone over again:
+ * - The goals per minute are counted in buckets of game time, the oldest bucket being dropped as the window moves on
+ * - The goal speeds are kept in a speedSketch (a merging t-digest), which gives approximate quantiles from a few dozen
+ *   centroids whatever the number of goals
+ * - The momentum of a player halves every LIVE_STATISTICS_MOMENTUM_HALF_LIFE of game time, and grows by one on every goal
+ * Goals are given with their game time, so the statistics can also be built from the goals of a stored game
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef LIVESTATISTICS_H
+#define LIVESTATISTICS_H
+
+#include "game.h"  //Statistics can be built from the goals of a game
+
+#define LIVE_STATISTICS_WINDOW 60000 //!< Length of the rolling window over which the goals per minute are counted [ms]
+#define LIVE_STATISTICS_BUCKETS 12 //!< Number of buckets the rolling window is split into
+#define LIVE_STATISTICS_MOMENTUM_HALF_LIFE 30000 //!< Game time after which a goal counts half as much to the momentum [ms]
+
+#define SPEED_SKETCH_COMPRESSION 40 //!< Compression of the speed sketch, the sketch keeps at most about this many centroids
+#define SPEED_SKETCH_BUFFER 32 //!< Number of speeds buffered before they are merged into the centroids of the sketch
+
+/**
+ * @brief Live statistics of one player
+ */
+struct livePlayerStatistics
+{
+    unsigned long goals; //!< Number of goals scored
+    double goalsPerMinute; //!< Goals scored per minute over the rolling window
+    double medianSpeed; //!< Median goal speed (0 if no goals)
+    double p90Speed; //!< 90th percentile of the goal speed (0 if no goals)
+    double momentum; //!< Share of the momentum of both players held by this player [%] (50 if neither has momentum)
+};
+
+/**
+ * @brief The goalRateCounter class counts goals over a rolling window of game time, split into buckets
+ */
+class goalRateCounter
+{
+
+private:
+
+    unsigned long buckets[LIVE_STATISTICS_BUCKETS]; //!< Goals counted in each bucket, bucket i holds the buckets numbered i modulo the number of buckets
+    unsigned long currentBucket; //!< Number of the bucket holding the current game time (game time divided by the bucket length)
+    unsigned long windowCount; //!< Goals counted in all the buckets of the window
+    unsigned long currentTime; //!< Latest game time seen [ms]
+
+    /**
+     * @brief advance - Function that moves the window on to a game time, emptying the buckets that leave the window
+     * @param time - game time [ms], earlier times are ignored
+     */
+    void advance(unsigned long time);
+
+public:
+
+    /**
+     * @brief goalRateCounter - Constructor for an empty counter at the start of the game
+     */
+    goalRateCounter();
+
+    /**
+     * @brief addGoal - Function to count a goal
+     * @param time - game time of the goal [ms], goals older than the window are not counted
+     */
+    void addGoal(unsigned long time);
+
+    /**
+     * @brief getGoalsPerMinute - Function that returns the goals per minute over the window ending at a game time
+     * @param time - current game time [ms]
+     * @return goals per minute, over the part of the window already played at the start of the game
+     */
+    double getGoalsPerMinute(unsigned long time);
+
+};
+
+/**
+ * @brief The speedSketch class estimates quantiles of the goal speeds in constant memory (a merging t-digest)
+ * Speeds are buffered, and merged into centroids (mean and weight) once the buffer is full. Centroids near the median may
+ * hold many speeds, while centroids near the smallest and largest speeds hold few, so the tails stay accurate
+ */
+class speedSketch
+{
+
+private:
+
+    double centroidMeans[SPEED_SKETCH_COMPRESSION + SPEED_SKETCH_BUFFER]; //!< Mean of each centroid, in increasing order
+    double centroidWeights[SPEED_SKETCH_COMPRESSION + SPEED_SKETCH_BUFFER]; //!< Number of speeds in each centroid
+    unsigned centroidCount; //!< Number of centroids in use
+    double buffer[SPEED_SKETCH_BUFFER]; //!< Speeds not merged into the centroids yet
+    unsigned bufferCount; //!< Number of speeds in the buffer
+    double totalWeight; //!< Number of speeds in the sketch
+    double minimum; //!< Smallest speed
+    double maximum; //!< Largest speed
+
+    /**
+     * @brief merge - Function that merges the buffered speeds into the centroids
+     */
+    void merge();
+
+public:
+
+    /**
+     * @brief speedSketch - Constructor for an empty sketch
+     */
+    speedSketch();
+
+    /**
+     * @brief add - Function to add a speed to the sketch
+     * @param speed - goal speed (unspecified units)
+     */
+    void add(double speed);
+
+    /**
+     * @brief quantile - Function that estimates a quantile of the speeds
+     * @param fraction - quantile to estimate, from 0 (smallest speed) to 1 (largest speed)
+     * @return estimated speed (0 if the sketch is empty)
+     */
+    double quantile(double fraction);
+
+    /**
+     * @brief getCount - Function that returns the number of speeds in the sketch
+     * @return number of speeds
+     */
+    unsigned long getCount();
+
+};
+
+/**
+ * @brief The liveStatistics class keeps the live statistics of both players of a game, updated on every goal
+ */
+class liveStatistics
+{
+
+private:
+
+    //Goal Rates
+    goalRateCounter playerAGoalRate; //!< Goals of player A (goals on B side) over the rolling window
+    goalRateCounter playerBGoalRate; //!< Goals of player B (goals on A side) over the rolling window
+
+    //Goal Speeds
+    speedSketch playerASpeeds; //!< Speeds of the goals of player A
+    speedSketch playerBSpeeds; //!< Speeds of the goals of player B
+
+    //Momentum
+    double playerAMomentum; //!< Momentum of player A at momentumTime
+    double playerBMomentum; //!< Momentum of player B at momentumTime
+    unsigned long momentumTime; //!< Game time the momentum was last brought up to [ms]
+
+    /**
+     * @brief decayMomentum - Function that brings the momentum of both players up to a game time
+     * @param time - game time [ms], earlier times are ignored
+     */
+    void decayMomentum(unsigned long time);
+
+    /**
+     * @brief getPlayerStatistics - Function that puts together the statistics of one player
+     * @param time - current game time [ms]
+     * @param goalRate - goal rate of the player
+     * @param speeds - goal speeds of the player
+     * @param momentum - momentum of the player
+     * @param otherMomentum - momentum of the other player
+     * @return statistics of the player
+     */
+    livePlayerStatistics getPlayerStatistics(unsigned long time, goalRateCounter &goalRate, speedSketch &speeds, double momentum, double otherMomentum);
+
+public:
+
+    /**
+     * @brief liveStatistics - Constructor for the statistics of a game without goals
+     */
+    liveStatistics();
+
+    /**
+     * @brief addGoal - Function to fold a goal into the statistics
+     * @param time - game time of the goal [ms]
+     * @param speed - goal speed (unspecified units)
+     * @param onBSide - true if scored on side B, i.e. if Player A has scored
+     */
+    void addGoal(unsigned long time, int speed, bool onBSide);
+
+    /**
+     * @brief addGame - Function to fold every goal of a game into the statistics, for games that were already played
+     * @param playedGame - game to read the goals from
+     */
+    void addGame(game &playedGame);
+
+    /**
+     * @brief getPlayerAStatistics - Function that returns the live statistics of player A
+     * @param time - current game time [ms], the rolling window and momentum are taken up to this time
+     * @return statistics of player A
+     */
+    livePlayerStatistics getPlayerAStatistics(unsigned long time);
+
+    /**
+     * @brief getPlayerBStatistics - Function that returns the live statistics of player B
+     * @param time - current game time [ms], the rolling window and momentum are taken up to this time
+     * @return statistics of player B
+     */
+    livePlayerStatistics getPlayerBStatistics(unsigned long time);
+
+};
+
+#endif // LIVESTATISTICS_H
@@ -2,8 +2,8 @@
  * @file mainmenuwindow.cpp
  * @author Mohammad Iqbal, Mohammad Sarfraz, Sanjayan Kulendran, Natalia Bohulevych
  * @brief Implementation file used to implement the mainmenuwindow class
- * @version 0.5
- * @date 2020-12-02
+ * @version 0.13
+ * @date 2026-10-19
  *
  * @copyright Copyright (c) 2020
  *
@@ -14,6 +14,221 @@
 
 static const char* database_name = "game_records.db"; //!< Constant for naming the saved database.
 
+// Reads the rating of a player from the 'players' table, a player without a stored rating keeps the given rating.
+static void readPlayerRating(sqlite3_stmt* stmt, const std::string &name, playerRating &rating)
+{
+    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        rating.rating = sqlite3_column_double(stmt, 0);
+        rating.deviation = sqlite3_column_double(stmt, 1);
+        rating.volatility = sqlite3_column_double(stmt, 2);
+        rating.matches = static_cast<unsigned long>(sqlite3_column_int64(stmt, 3));
+    }
+
+    sqlite3_reset(stmt);
+}
+
+// Writes the rating of a player into the 'players' table.
+static void writePlayerRating(sqlite3_stmt* stmt, const std::string &name, const playerRating &rating)
+{
+    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_double(stmt, 2, rating.rating);
+    sqlite3_bind_double(stmt, 3, rating.deviation);
+    sqlite3_bind_double(stmt, 4, rating.volatility);
+    sqlite3_bind_int64(stmt, 5, static_cast<sqlite3_int64>(rating.matches));
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        qDebug() << "Error: " << sqlite3_errmsg(sqlite3_db_handle(stmt));
+    }
+
+    sqlite3_reset(stmt);
+}
+
+// Adds a player to the 'players' table if not already present, and returns the key of the player (0 if it could not be stored).
+static sqlite3_int64 storePlayer(matchStorage* storage, const std::string &name)
+{
+    sqlite3_int64 id = 0;
+
+    sqlite3_stmt* stmt = storage->prepare(storage->getWriter(), "INSERT OR IGNORE INTO players(name) VALUES(?);");
+    if (stmt == NULL) return 0;
+
+    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+    bool stored = (sqlite3_step(stmt) == SQLITE_DONE);
+    sqlite3_reset(stmt);
+
+    // Look the key up by name, the player may have been stored before.
+    stmt = stored ? storage->prepare(storage->getWriter(), "SELECT id FROM players WHERE name = ?;") : NULL;
+    if (stmt == NULL) return 0;
+
+    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        id = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_reset(stmt);
+
+    return id;
+}
+
+// Binds one goal of a game to the goal parameters of an insert into the 'goals' table, starting at the given parameter.
+static void bindGoal(sqlite3_stmt* stmt, int parameter, game &played, unsigned long index)
+{
+    sqlite3_bind_int64(stmt, parameter, static_cast<sqlite3_int64>(index + 1));
+    sqlite3_bind_int64(stmt, parameter + 1, static_cast<sqlite3_int64>(played.getGoalTimes()[index]));
+    sqlite3_bind_int(stmt, parameter + 2, played.getGoalSpeeds()[index]);
+    sqlite3_bind_int(stmt, parameter + 3, played.getGoalSides()[index] ? 1 : 0);
+}
+
+// Appends the goals of a game to the 'goals' table, STORAGE_GOAL_BATCH goals per insert, and the remaining goals one by one.
+static bool storeGoals(matchStorage &storage, sqlite3_int64 match_id, int game_number, game &played)
+{
+    sqlite3* db = storage.getWriter();
+    unsigned long count = played.getGoalCount();
+    unsigned long index = 0;
+
+    // The match and game are bound once as ?1 and ?2, each goal takes the next four parameters.
+    static const std::string batchSQL = [](){
+        std::string sql = "INSERT INTO goals(match_id, game_number, goal_number, time, speed, side) VALUES";
+        for (int row = 0; row < STORAGE_GOAL_BATCH; row++) {
+            int first = 3 + 4 * row;
+            sql += (row ? ", (?1, ?2, ?" : "(?1, ?2, ?") + std::to_string(first) + ", ?" + std::to_string(first + 1)
+                    + ", ?" + std::to_string(first + 2) + ", ?" + std::to_string(first + 3) + ")";
+        }
+        return sql + ";";
+    }();
+
+    // Full batches of goals.
+    sqlite3_stmt* stmt = (count >= STORAGE_GOAL_BATCH) ? storage.prepare(db, batchSQL.c_str()) : NULL;
+
+    if (stmt != NULL) {
+        sqlite3_bind_int64(stmt, 1, match_id);
+        sqlite3_bind_int(stmt, 2, game_number);
+
+        for (; index + STORAGE_GOAL_BATCH <= count; index += STORAGE_GOAL_BATCH) {
+            for (int row = 0; row < STORAGE_GOAL_BATCH; row++) {
+                bindGoal(stmt, 3 + 4 * row, played, index + row);
+            }
+
+            bool inserted = (sqlite3_step(stmt) == SQLITE_DONE);
+            sqlite3_reset(stmt);
+
+            if (!inserted) return false;
+        }
+    }
+
+    // The goals left over.
+    stmt = (index < count) ? storage.prepare(db, "INSERT INTO goals(match_id, game_number, goal_number, time, speed, side) VALUES(?1, ?2, ?3, ?4, ?5, ?6);") : NULL;
+
+    if (stmt != NULL) {
+        sqlite3_bind_int64(stmt, 1, match_id);
+        sqlite3_bind_int(stmt, 2, game_number);
+
+        for (; index < count; index++) {
+            bindGoal(stmt, 3, played, index);
+
+            bool inserted = (sqlite3_step(stmt) == SQLITE_DONE);
+            sqlite3_reset(stmt);
+
+            if (!inserted) return false;
+        }
+    }
+
+    return index == count;
+}
+
+// Saves a match and the new ratings of its players through the writer handle, run by the storage writer inside its transaction.
+static bool saveMatch(matchStorage &storage, pendingMatch &pending)
+{
+    sqlite3* db = storage.getWriter();
+    sqlite3_stmt* stmt;
+
+    // The parameters that are constant for each game are read once.
+    matchOutcome &outcome = pending.outcome;
+    const std::string &ID = outcome.matchID;
+    const std::string &name_A = outcome.playerAName;
+    const std::string &name_B = outcome.playerBName;
+    auto table_mode = outcome.tableMode;
+
+    // Both players are stored once, and the match refers to them by key.
+    sqlite3_int64 id_A = storePlayer(&storage, name_A);
+    sqlite3_int64 id_B = storePlayer(&storage, name_B);
+    if ((id_A == 0) || (id_B == 0)) return false;
+
+    // Insert the match. The values are bound rather than written into the query, so a player name cannot change the query.
+    sqlite3_int64 match_id = 0;
+    stmt = storage.prepare(db, "INSERT INTO matches(match_key, player_a, player_b, table_mode) VALUES(?, ?, ?, ?);");
+    if (stmt == NULL) return false;
+
+    sqlite3_bind_text(stmt, 1, ID.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 2, id_A);
+    sqlite3_bind_int64(stmt, 3, id_B);
+    sqlite3_bind_int(stmt, 4, table_mode);
+
+    if (sqlite3_step(stmt) == SQLITE_DONE) {
+        match_id = sqlite3_last_insert_rowid(db);
+    }
+    sqlite3_reset(stmt);
+    if (match_id == 0) return false;
+
+    // Insert every game of the match with one prepared statement, kept by the storage service. The match stays bound from
+    // one game to the next.
+    stmt = storage.prepare(db, "INSERT INTO games(match_id, game_number, a_score, b_score) VALUES(?, ?, ?, ?);");
+    if (stmt == NULL) return false;
+
+    sqlite3_bind_int64(stmt, 1, match_id);
+
+    for (auto i = 0u; i < outcome.games.size(); i++) {
+        // Get the scores from the game...
+        sqlite3_bind_int(stmt, 2, static_cast<int>(i + 1));
+        sqlite3_bind_int(stmt, 3, static_cast<int>(outcome.games[i].getPlayerAScore()));
+        sqlite3_bind_int(stmt, 4, static_cast<int>(outcome.games[i].getPlayerBScore()));
+
+        // Check to make sure we dont get any errors.
+        bool inserted = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_reset(stmt);
+
+        if (!inserted) return false;
+    }
+
+    // Append the goals of every game, after the games they belong to.
+    for (auto i = 0u; i < outcome.games.size(); i++) {
+        if (!storeGoals(storage, match_id, static_cast<int>(i + 1), outcome.games[i])) return false;
+    }
+
+    // Rate both players from the games won in the match, as a recompute from the stored games does (a match without games,
+    // or a player against themselves, is not rated).
+    const matchStandings &standings = pending.standings;
+    if ((standings.games == 0) || (name_A == name_B)) return true;
+
+    // Read the current ratings of both players.
+    ratingEngine engine;
+    pending.playerARating = engine.newRating();
+    pending.playerBRating = engine.newRating();
+
+    stmt = storage.prepare(db, "SELECT rating, deviation, volatility, rated_matches FROM players WHERE name = ? AND rating IS NOT NULL;");
+    if (stmt != NULL) {
+        readPlayerRating(stmt, name_A, pending.playerARating);
+        readPlayerRating(stmt, name_B, pending.playerBRating);
+    }
+
+    // Update both ratings from the result of the match.
+    double score_A = 0.5;
+    if (standings.playerAVictories > standings.playerBVictories) score_A = 1;
+    else if (standings.playerBVictories > standings.playerAVictories) score_A = 0;
+
+    engine.rateMatch(pending.playerARating, pending.playerBRating, score_A);
+
+    // Store the new ratings, in the same transaction as the games.
+    stmt = storage.prepare(db, "UPDATE players SET rating = ?2, deviation = ?3, volatility = ?4, rated_matches = ?5 WHERE name = ?1;");
+    if (stmt != NULL) {
+        writePlayerRating(stmt, name_A, pending.playerARating);
+        writePlayerRating(stmt, name_B, pending.playerBRating);
+        pending.rated = true;
+    }
+
+    return true;
+}
+
 MainMenuWindow::MainMenuWindow(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::MainMenuWindow)
@@ -24,12 +239,42 @@ MainMenuWindow::MainMenuWindow(QWidget *parent) :
     playerAObjPtr = new player("playerA", 0, 0);
     playerBObjPtr = new player("playerB", 0, 0);
 
+    // Open the database once for the lifetime of the program.
+    storageObjPtr = new matchStorage(database_name);
+
+    // Matches are saved on the thread of the storage writer, which tells the main menu once each is saved.
+    storageWriterPtr = new storageWriter(storageObjPtr);
+    connect(storageWriterPtr, &storageWriter::jobFinished, this, &MainMenuWindow::matchSaved);
+
+    // The names of the stored players are read by the storage writer, so the main menu shows without waiting for them.
+    playerNamesPtr = new nameIndex();
+    loadedPlayerNames = std::make_shared<std::vector<std::string>>();
+    connect(storageWriterPtr, &storageWriter::jobFinished, this, &MainMenuWindow::playerNamesLoaded);
+
+    std::shared_ptr<std::vector<std::string>> loaded = loadedPlayerNames;
+    playerNamesJob = storageWriterPtr->submit([loaded](matchStorage &storage){
+        sqlite3_stmt* stmt = storage.prepare(storage.getWriter(), "SELECT name FROM players;");
+        if (stmt == NULL) return false;
+
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            loaded->push_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+        }
+        sqlite3_reset(stmt);
+
+        return true;
+    });
+
     ui->setupUi(this);
 }
 
 MainMenuWindow::~MainMenuWindow()
 {
     delete ui;
+
+    // Save the matches still waiting, then close the database, which checkpoints its log.
+    delete storageWriterPtr;
+    delete playerNamesPtr;
+    delete storageObjPtr;
 }
 
 void MainMenuWindow::on_pushButtonUserMatchSettings_clicked()
@@ -50,27 +295,78 @@ void MainMenuWindow::on_pushButtonTableConfig_clicked()
 
 void MainMenuWindow::on_pushButtonPlayerSettings_clicked()
 {
-    playerSettingsWindowPtr = new playersettingswindow(this, this->playerAObjPtr, this->playerBObjPtr);
+    playerSettingsWindowPtr = new playersettingswindow(this, this->playerAObjPtr, this->playerBObjPtr, this->playerNamesPtr);
+    connect(playerSettingsWindowPtr, &playersettingswindow::playersChanged, this, &MainMenuWindow::playerSettingsChanged);
     playerSettingsWindowPtr->show();
 }
 
 void MainMenuWindow::on_pushButtonStartMatch_clicked()
 {
+    //Play a match between the players of the main menu
+    playMatch(this->playerAObjPtr, this->playerBObjPtr);
+}
 
-    //Initialize a temporary game vector
-    std::vector<game> gameVector;
+void MainMenuWindow::on_pushButtonTournament_clicked()
+{
+    //Entrants are seeded by their stored ratings, and matches on this table are played as any other match
+    auto ratingLoader = [this](const std::vector<std::string> &names){ return this->loadRatings(names); };
+    auto matchPlayer = [this](const std::string &nameA, const std::string &nameB){
+        player tournamentPlayerA(nameA, 0, 0);
+        player tournamentPlayerB(nameB, 0, 0);
+        this->showStoredRatings(&tournamentPlayerA, &tournamentPlayerB);
+        return this->playMatch(&tournamentPlayerA, &tournamentPlayerB);
+    };
+
+    //Show the tournament as a modal, the tournament itself is kept by the main menu
+    tournamentDisplay curTournamentDisplay(this->currentTournament, ratingLoader, matchPlayer, this);
+    curTournamentDisplay.setModal(true);
+    curTournamentDisplay.exec();
+}
+
+std::vector<double> MainMenuWindow::loadRatings(const std::vector<std::string> &names)
+{
+    ratingEngine engine;
+    std::vector<double> ratings(names.size(), engine.newRating().rating);
 
-    //Initialize a vector of game structures
-    std::vector<gameOutcome> gameOutcomes;
+    // Save the matches still waiting first, so the ratings read are up to date.
+    storageWriterPtr->flush();
 
-    //Initialize a game outcome
-    gameOutcome currentGameOutcome;
+    // All the ratings are read with one statement on the reader, a player without a stored rating is new.
+    sqlite3_stmt* stmt = storageObjPtr->prepare(storageObjPtr->getReader(), "SELECT rating, deviation, volatility, rated_matches FROM players WHERE name = ? AND rating IS NOT NULL;");
+
+    if (stmt != NULL) {
+        for (auto i = 0u; i < names.size(); i++) {
+            playerRating rating = engine.newRating();
+            readPlayerRating(stmt, names[i], rating);
+            ratings[i] = rating.rating;
+        }
+    }
+
+    return ratings;
+}
+
+void MainMenuWindow::showStoredRatings(player *playerA, player *playerB)
+{
+    std::vector<double> ratings = loadRatings({playerA->getName(), playerB->getName()});
+
+    playerA->setRating(static_cast<int>(std::lround(ratings[0])));
+    playerB->setRating(static_cast<int>(std::lround(ratings[1])));
+}
+
+unsigned char MainMenuWindow::playMatch(player *playerA, player *playerB)
+{
+
+    //Initialize the match, first to the number of game victories of the match settings
+    match currentMatch(MATCH_FIRST_TO, this->matchSettingsObjPtr->getNumberOfGames());
+
+    //Initialize the match outcome
+    matchOutcome currentMatchOutcome;
 
     //Main component of Unique Match ID is UNIX time since epoch
     int matchTime = static_cast<int>(std::time(NULL));
 
     //Assemble match ID string before hashing, composed of time since epoch, player a name, player b name
-    std::string preHashedMatchID = std::to_string(matchTime) + this->playerAObjPtr->getName() + this->playerBObjPtr->getName();
+    std::string preHashedMatchID = std::to_string(matchTime) + playerA->getName() + playerB->getName();
 
     //Create hash object
     std::hash<std::string> matchIDHasher;
@@ -79,76 +375,80 @@ void MainMenuWindow::on_pushButtonStartMatch_clicked()
     std::string currentMatchID = std::to_string(matchIDHasher(preHashedMatchID));
 
     //Initialize new match as modal ( to ensure match is complete before executing storage)
-    matchDisplay curMatchDisplay(gameVector, this, this->matchSettingsObjPtr, this->tableConfigObjPtr,this->playerAObjPtr, this->playerBObjPtr);
+    matchDisplay curMatchDisplay(currentMatch, this, this->matchSettingsObjPtr, this->tableConfigObjPtr, playerA, playerB);
     curMatchDisplay.setModal(true);
     curMatchDisplay.exec();
 
-    //Store the the parameters that are constant for each game
-    currentGameOutcome.matchID = currentMatchID;
-    currentGameOutcome.playerAName = this->playerAObjPtr->getName();
-    currentGameOutcome.playerBName = this->playerBObjPtr->getName();
-    currentGameOutcome.tableMode = this->tableConfigObjPtr->getTableMode();
+    //Store the the parameters that are constant for each game, once for the whole match
+    currentMatchOutcome.matchID = std::move(currentMatchID);
+    currentMatchOutcome.playerAName = playerA->getName();
+    currentMatchOutcome.playerBName = playerB->getName();
+    currentMatchOutcome.tableMode = this->tableConfigObjPtr->getTableMode();
 
-    //For every game in the match
-    for (int i = static_cast<int>(gameVector.size()); i > 0; i--){
+    //Move the games of the match into the outcome, the games themselves are not copied
+    currentMatchOutcome.games = currentMatch.takeGames();
 
-        //Copy the player scores
-        currentGameOutcome.playerAScore = gameVector.back().getPlayerAScore();
-        currentGameOutcome.playerBScore = gameVector.back().getPlayerBScore();
+    // A match without games is not stored.
+    if (currentMatchOutcome.games.empty()) {
+        return currentMatch.getResult();
+    }
 
-        //Add this element to the outcome vector
-        gameOutcomes.push_back(currentGameOutcome);
+    // Hand the match to the storage writer, which saves it on its own thread. The ratings are shown on the players once saved.
+    auto pending = std::make_shared<pendingMatch>();
+    pending->outcome = std::move(currentMatchOutcome);
+    pending->standings = currentMatch.getStandings();
+    pending->rated = false;
 
-        //Remove the element from the match-produced game vector
-        gameVector.pop_back();
+    unsigned long job = storageWriterPtr->submit([pending](matchStorage &storage){ return saveMatch(storage, *pending); });
+    pendingMatches[job] = pending;
 
-    }
+    //New players can be suggested straight away, without waiting for the match to be saved
+    playerNamesPtr->insert(pending->outcome.playerAName);
+    playerNamesPtr->insert(pending->outcome.playerBName);
 
-    // Create/Open the database file using SQLite.
-    char* err;
-    sqlite3* db;
-    sqlite3_stmt* stmt;
-    sqlite3_open(database_name, &db);
+    return currentMatch.getResult();
+}
 
-    // Start by creating a table 'game_data' if not already present in file.
-    std::string cmd = "CREATE TABLE IF NOT EXISTS game_data(ID varchar(100), player_A varchar(100)"
-                      ", player_B varchar(100), A_score INT, B_score INT, table_mode INT);";
-    int rc = sqlite3_exec(db, cmd.c_str(), NULL, NULL, &err);
+void MainMenuWindow::playerNamesLoaded(unsigned long job, bool committed)
+{
+    if (job != playerNamesJob) return;
 
-    // Check to make sure we dont get any errors.
-    if (rc != SQLITE_OK) {
-        qDebug() << "Error: " << err;
-    }
+    //Add the stored names to the names of the players of the matches played since the program started
+    if (committed) playerNamesPtr->load(*loadedPlayerNames);
+    loadedPlayerNames.reset();
 
-    // Insert all values from gameOutcome vector into the database.
-    for(auto i = 0u; i < gameOutcomes.size(); i++){
-        // Get each parameter from the game...
-        auto ID = gameOutcomes.at(i).matchID;
-        auto name_A = gameOutcomes.at(i).playerAName;
-        auto name_B = gameOutcomes.at(i).playerBName;
+    //The storage writer has caught up, so the ratings of the players of the main menu are read without waiting
+    showStoredRatings(this->playerAObjPtr, this->playerBObjPtr);
+}
 
-        auto score_A = gameOutcomes.at(i).playerAScore;
-        auto score_B = gameOutcomes.at(i).playerBScore;
-        auto table_mode = gameOutcomes.at(i).tableMode;
+void MainMenuWindow::playerSettingsChanged()
+{
+    //Show the stored ratings of the players chosen, returning players keep the rating they had
+    showStoredRatings(this->playerAObjPtr, this->playerBObjPtr);
+}
 
-        std::string query = "insert into game_data VALUES('" + ID + "','" + name_A + "', '" + name_B + "', "
-                + std::to_string(score_A) + ", " +std::to_string(score_B) + ", " +std::to_string(table_mode)+ ");";
+void MainMenuWindow::matchSaved(unsigned long job, bool committed)
+{
+    auto found = pendingMatches.find(job);
+    if (found == pendingMatches.end()) return;
 
-        int rc = sqlite3_exec(db, query.c_str(), NULL, NULL, &err);
+    std::shared_ptr<pendingMatch> saved = found->second;
+    pendingMatches.erase(found);
 
-        // Check to make sure we dont get any errors.
-        if (rc != SQLITE_OK) {
-            qDebug() << "Error: " << err;
-        }
-    }
+    if (!committed || !saved->rated) return;
+
+    //Show the new ratings on the players of the main menu that played the match
+    player *players[] = {this->playerAObjPtr, this->playerBObjPtr};
 
-    // Close the database.
-    sqlite3_close(db);
+    for (player *shown : players) {
+        if (shown->getName() == saved->outcome.playerAName) shown->setRating(static_cast<int>(std::lround(saved->playerARating.rating)));
+        else if (shown->getName() == saved->outcome.playerBName) shown->setRating(static_cast<int>(std::lround(saved->playerBRating.rating)));
+    }
 }
 
  //Create databaseWindow object, pass mainmenu pointer
 void MainMenuWindow::on_pushButtonDatabaseWindow_clicked()
 {
-    databaseWindowPtr = new databaseWindow(this);
+    databaseWindowPtr = new databaseWindow(this, this->storageObjPtr, this->storageWriterPtr, this->playerNamesPtr);
     databaseWindowPtr->show();
 }
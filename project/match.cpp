@@ -0,0 +1,164 @@
+/**
+ * @file match.cpp
+ * @author Sanjayan Kulendran
+ * @brief Implementation file used to implement the match class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "match.h"
+
+//Match constructor, the match starts without any games
+match::match(unsigned char type, unsigned long gameCount)
+{
+    //Set the rule of the match, a match has at least one game
+    matchType = type;
+    matchGameCount = (gameCount > 0) ? gameCount : 1;
+
+    //No games played yet
+    standings = matchStandings();
+    result = MATCH_RESULT_UNDECIDED;
+
+    //Reserve the games of the longest match, so the games already played are never moved again
+    games.reserve(getMaximumGames());
+}
+
+
+//Function to add a played game to the match
+void match::addGame(game &&playedGame){
+
+    //Once the match is over, the games left are not played
+    if(result != MATCH_RESULT_UNDECIDED) return;
+
+    unsigned long playerAScore = playedGame.getPlayerAScore();
+    unsigned long playerBScore = playedGame.getPlayerBScore();
+
+    //Update the standings from the final scores of the game
+    standings.games++;
+    standings.playerAGoals += playerAScore;
+    standings.playerBGoals += playerBScore;
+
+    if(playerAScore > playerBScore) standings.playerAVictories++;
+    else if(playerBScore > playerAScore) standings.playerBVictories++;
+    else{
+
+        standings.tiedGames++;
+
+        //In a first to match, a tied game is a victory for both players
+        if(matchType == MATCH_FIRST_TO){
+            standings.playerAVictories++;
+            standings.playerBVictories++;
+        }
+    }
+
+    //The match takes over the game
+    games.push_back(std::move(playedGame));
+
+    updateResult();
+
+};
+
+//Function that decides whether the match is over after a game was added
+void match::updateResult(){
+
+    unsigned long playerAVictories = standings.playerAVictories;
+    unsigned long playerBVictories = standings.playerBVictories;
+
+    if(matchType == MATCH_FIRST_TO){
+
+        //The match goes on until a player has won enough games
+        if((playerAVictories < matchGameCount) && (playerBVictories < matchGameCount)) return;
+
+    }
+    else{
+
+        //The match goes on while the trailing player could still catch up in the games left
+        unsigned long lead = (playerAVictories > playerBVictories) ? playerAVictories - playerBVictories : playerBVictories - playerAVictories;
+        unsigned long gamesLeft = matchGameCount - standings.games;
+
+        if((gamesLeft > 0) && (lead <= gamesLeft)) return;
+
+    }
+
+    //The player with the most victories wins the match
+    if(playerAVictories > playerBVictories) result = MATCH_RESULT_PLAYER_A;
+    else if(playerBVictories > playerAVictories) result = MATCH_RESULT_PLAYER_B;
+    else result = MATCH_RESULT_TIE;
+
+};
+
+//Function that returns true if the match is over
+bool match::isMatchOver(){
+
+    return result != MATCH_RESULT_UNDECIDED;
+
+};
+
+//Function that returns the result of the match
+unsigned char match::getResult(){
+
+    return result;
+
+};
+
+//Function that returns the standings of the match
+matchStandings match::getStandings(){
+
+    return standings;
+
+};
+
+//Function that returns the rule of the match
+unsigned char match::getMatchType(){
+
+    return matchType;
+
+};
+
+//Function that returns the number of games of the rule of the match
+unsigned long match::getMatchGameCount(){
+
+    return matchGameCount;
+
+};
+
+//Function that returns the most games the match can take
+unsigned long match::getMaximumGames(){
+
+    //Every game of a first to match is a victory for at least one player, so the longest match ends with one player a
+    //victory short of the other
+    if(matchType == MATCH_FIRST_TO) return 2*matchGameCount - 1;
+
+    return matchGameCount;
+
+};
+
+//Function that returns the most games that may still be played
+unsigned long match::getGamesRemaining(){
+
+    if(result != MATCH_RESULT_UNDECIDED) return 0;
+
+    //In a first to match, the longest way to the end is for the players to share the victories one game at a time
+    if(matchType == MATCH_FIRST_TO) return (matchGameCount - standings.playerAVictories) + (matchGameCount - standings.playerBVictories) - 1;
+
+    return matchGameCount - standings.games;
+
+};
+
+//Function that gives access to the games of the match
+const std::vector<game> &match::getGames(){
+
+    return games;
+
+};
+
+//Function that moves the games out of the match
+std::vector<game> match::takeGames(){
+
+    return std::move(games);
+
+};
@@ -0,0 +1,150 @@
+/**
+ * @file match.h
+ * @author Sanjayan Kulendran
+ * @brief Header file used to declare the match class.
+ * The match class owns the games of a match between two players, and keeps the standings of the match (games won, tied and
+ * goals scored) up to date as each game is added
+ * A match is played either first to a number of game victories, where a tied game is a victory for both players (as shown
+ * by the match display), or as the best of a number of games, where a tied game is a victory for neither player
+ * The match knows when it is over, including when the games left to play can no longer change its outcome
+ * The match has no display, so it can be used by the match display and by batch simulations alike
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef MATCH_H
+#define MATCH_H
+
+#include "game.h"  //Match is composed of games
+#include<vector>  //Vector for storing the games
+
+#define MATCH_FIRST_TO 0 //!< The match is won by the first player to win a number of games
+#define MATCH_BEST_OF 1 //!< The match is won by the player who wins the most of a number of games
+
+#define MATCH_RESULT_UNDECIDED 0 //!< The match is not over
+#define MATCH_RESULT_PLAYER_A 1 //!< Player A has won the match
+#define MATCH_RESULT_PLAYER_B 2 //!< Player B has won the match
+#define MATCH_RESULT_TIE 3 //!< The match is over without a winner
+
+/**
+ * @brief Standings of a match, updated as each game is added
+ */
+struct matchStandings
+{
+    unsigned long games; //!< Number of games played
+    unsigned long playerAVictories; //!< Number of games won by player A (including tied games in a first to match)
+    unsigned long playerBVictories; //!< Number of games won by player B (including tied games in a first to match)
+    unsigned long tiedGames; //!< Number of games that ended on the same score
+    unsigned long playerAGoals; //!< Number of goals scored by player A over all the games
+    unsigned long playerBGoals; //!< Number of goals scored by player B over all the games
+};
+
+/**
+ * @brief The match class owns the games of a match between two players, and keeps the standings of the match up to date
+ * as each game is added
+ */
+class match
+{
+
+private:
+
+    //Match Rules
+    unsigned char matchType; //!< MATCH_FIRST_TO or MATCH_BEST_OF
+    unsigned long matchGameCount; //!< Number of victories needed (first to), or number of games (best of)
+
+    //Games
+    std::vector<game> games; //!< Games of the match, in the order they were played
+
+    //Standings
+    matchStandings standings; //!< Standings after the games played so far
+    unsigned char result; //!< One of the MATCH_RESULT defines
+
+    /**
+     * @brief updateResult - Function that decides whether the match is over after a game was added
+     */
+    void updateResult();
+
+public:
+
+    /**
+     * @brief match - Match constructor, the match starts without any games
+     * @param type - MATCH_FIRST_TO or MATCH_BEST_OF
+     * @param gameCount - Number of victories needed (first to), or number of games (best of), at least 1
+     */
+    match(unsigned char type, unsigned long gameCount);
+
+    //A match is never copied, its games are moved from one owner to the next
+    match(const match &) = delete;
+    match &operator=(const match &) = delete;
+
+    /**
+     * @brief addGame - Function to add a played game to the match, the standings are updated from its final scores
+     * Games added once the match is over are ignored
+     * @param playedGame - game to move into the match
+     */
+    void addGame(game &&playedGame);
+
+    /**
+     * @brief isMatchOver - Function that indicates if the match is over, either because a player has won or because the
+     * games left can no longer change the outcome
+     * @return boolean that is 'true' if no more games need to be played
+     */
+    bool isMatchOver();
+
+    /**
+     * @brief getResult - Function that returns the result of the match
+     * @return one of the MATCH_RESULT defines
+     */
+    unsigned char getResult();
+
+    /**
+     * @brief getStandings - Function that returns the standings of the match
+     * @return standings after the games played so far
+     */
+    matchStandings getStandings();
+
+    /**
+     * @brief getMatchType - Function that returns the rule of the match
+     * @return MATCH_FIRST_TO or MATCH_BEST_OF
+     */
+    unsigned char getMatchType();
+
+    /**
+     * @brief getMatchGameCount - Function that returns the number of games of the rule of the match
+     * @return number of victories needed (first to), or number of games (best of)
+     */
+    unsigned long getMatchGameCount();
+
+    /**
+     * @brief getMaximumGames - Function that returns the most games the match can take
+     * @return number of games of the longest possible match
+     */
+    unsigned long getMaximumGames();
+
+    /**
+     * @brief getGamesRemaining - Function that returns the most games that may still be played
+     * @return number of games left in the longest possible match (0 once the match is over)
+     */
+    unsigned long getGamesRemaining();
+
+    /**
+     * @brief getGames - Function that gives access to the games of the match
+     * @return vector of the games, in the order they were played
+     */
+    const std::vector<game> &getGames();
+
+    /**
+     * @brief takeGames - Function that moves the games out of the match, for storage (the match then has no games, but keeps
+     * its standings)
+     * @return vector of the games, in the order they were played
+     */
+    std::vector<game> takeGames();
+
+};
+
+#endif // MATCH_H
@@ -4,9 +4,11 @@
  * @brief Header file used to declare the qt5 based matchDisplay class.
  * Simple UI displaying the status of a match (player A and B game wins0
  * Also has a button allowing the direct launching of games, which converts to a close button on completion
+ * The rules and standings of the match are kept by a match object, the display only shows them
+ * The players are shown with the rating they start the match with
  *
- * @version 1.0
- * @date 2020-11-30
+ * @version 1.2
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -26,6 +28,7 @@
 #include "tableconfigurationsettings.h"
 #include "usermatchsettings.h"
 #include "game.h"
+#include "match.h"
 
 
 namespace Ui {
@@ -50,9 +53,9 @@ public:
      * @param tableConfigObjPtr - Pointer to readable table configurations object
      * @param playerAObjPtr - Pointer to readable player object representing Player A
      * @param playerBObjPtr - Pointer to readable player object representing Player B
-     * @param gamesInMatchReturnPointer - Reference to game vector used for passing back data about games in a match
+     * @param currentMatchReference - Reference to the match that the games are played for, it keeps the games and standings
      */
-    explicit matchDisplay(std::vector<game> &gamesInMatchReturnPointer, QWidget *parent = nullptr, usermatchsettings *matchSettingsObjPtr = nullptr, tableconfigurationsettings *tableConfigObjPtr = nullptr,  player *playerAObjPtr = nullptr, player *playerBObjPtr = nullptr);
+    explicit matchDisplay(match &currentMatchReference, QWidget *parent = nullptr, usermatchsettings *matchSettingsObjPtr = nullptr, tableconfigurationsettings *tableConfigObjPtr = nullptr,  player *playerAObjPtr = nullptr, player *playerBObjPtr = nullptr);
 
     /**
      * @brief sDestructor for the class
@@ -69,13 +72,9 @@ private:
 
     Ui::matchDisplay *ui; //!< QT5 autogenerated pointer to ui
 
-    std::vector<game> *gamesInMatch; //!< Pointer to the Vector that stores the amount of games in a match
+    match *currentMatch; //!< Pointer to the match that owns the games and standings
 
-    int firstTo; //!<Integer that stores the amount of games needed for victory (simple calcualtion from best of)
-    int playerAVictories; //!<Integer that counts the amount of victories for player A
-    int playerBVictories; //!<Integer that counts the amount of victories for player A
-
-    bool matchOver; //!<Boolean variable that keeps track of if the match is over
+    std::vector<game> playedGame; //!< Vector the game display returns the game it played into, before it is moved into the match
 
     usermatchsettings *savedMatchSettingsObjPtr; //!< Reference to passed in match settings object
     tableconfigurationsettings *savedTableConfigObjPtr; //!< Reference to passed in table configurations object
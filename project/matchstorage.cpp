@@ -0,0 +1,194 @@
+/**
+ * @file matchstorage.cpp
+ * @author Ali Sarfraz
+ * @brief Implementation file used to implement the matchStorage class
+ * @version 0.4
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "matchstorage.h"
+
+#include <QDebug>
+
+matchStorage::matchStorage(const char* file_name) :
+    writer(NULL),
+    reader(NULL)
+{
+    std::string cache = "PRAGMA cache_size=-" + std::to_string(STORAGE_CACHE_KIB) + ";";
+
+    // Open the writer first, it creates the database file if needed.
+    if (sqlite3_open_v2(file_name, &writer, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL) != SQLITE_OK) {
+        qDebug() << "Error: " << sqlite3_errmsg(writer);
+        sqlite3_close(writer);
+        writer = NULL;
+        return;
+    }
+
+    // Readers do not block the writer in WAL mode, and a commit only needs a full sync at checkpoints.
+    sqlite3_busy_timeout(writer, STORAGE_BUSY_TIMEOUT);
+    execute(writer, "PRAGMA journal_mode=WAL;");
+    execute(writer, "PRAGMA synchronous=NORMAL;");
+    execute(writer, "PRAGMA temp_store=MEMORY;");
+    execute(writer, cache.c_str());
+
+    // Create the tables once, for the lifetime of the program.
+    execute(writer, "CREATE TABLE IF NOT EXISTS players(id INTEGER PRIMARY KEY, name TEXT NOT NULL UNIQUE"
+                    ", rating REAL, deviation REAL, volatility REAL, rated_matches INT);");
+    execute(writer, "CREATE TABLE IF NOT EXISTS matches(id INTEGER PRIMARY KEY, match_key TEXT NOT NULL UNIQUE"
+                    ", player_a INTEGER NOT NULL REFERENCES players(id), player_b INTEGER NOT NULL REFERENCES players(id)"
+                    ", table_mode INT);");
+    execute(writer, "CREATE INDEX IF NOT EXISTS matches_player_a ON matches(player_a);");
+    execute(writer, "CREATE INDEX IF NOT EXISTS matches_player_b ON matches(player_b);");
+    execute(writer, "CREATE TABLE IF NOT EXISTS games(match_id INTEGER NOT NULL REFERENCES matches(id), game_number INT NOT NULL"
+                    ", a_score INT, b_score INT, PRIMARY KEY(match_id, game_number)) WITHOUT ROWID;");
+    execute(writer, "CREATE TABLE IF NOT EXISTS goals(match_id INTEGER NOT NULL, game_number INT NOT NULL, goal_number INT NOT NULL"
+                    ", time INT, speed INT, side INT, PRIMARY KEY(match_id, game_number, goal_number)"
+                    ", FOREIGN KEY(match_id, game_number) REFERENCES games(match_id, game_number)) WITHOUT ROWID;");
+
+    // Convert the tables of an earlier version.
+    migrate();
+
+    // Open the reader on the same file.
+    if (sqlite3_open_v2(file_name, &reader, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK) {
+        qDebug() << "Error: " << sqlite3_errmsg(reader);
+        sqlite3_close(reader);
+        reader = NULL;
+        return;
+    }
+
+    sqlite3_busy_timeout(reader, STORAGE_BUSY_TIMEOUT);
+    execute(reader, "PRAGMA query_only=ON;");
+    execute(reader, cache.c_str());
+}
+
+matchStorage::~matchStorage()
+{
+    // Statements have to be finalized before their handle is closed.
+    for (auto &kept : statements) {
+        sqlite3_finalize(kept.second);
+    }
+    statements.clear();
+
+    sqlite3_close(reader);
+    sqlite3_close(writer);
+}
+
+bool matchStorage::isOpen()
+{
+    return (writer != NULL) && (reader != NULL);
+}
+
+sqlite3* matchStorage::getWriter()
+{
+    return writer;
+}
+
+sqlite3* matchStorage::getReader()
+{
+    return reader;
+}
+
+sqlite3_stmt* matchStorage::prepare(sqlite3* handle, const char* sql)
+{
+    if (handle == NULL) return NULL;
+
+    // Reuse the statement if it was prepared before.
+    std::lock_guard<std::mutex> lock(statementsMutex);
+    auto key = std::make_pair(handle, std::string(sql));
+    auto found = statements.find(key);
+
+    if (found != statements.end()) {
+        sqlite3_reset(found->second);
+        sqlite3_clear_bindings(found->second);
+        return found->second;
+    }
+
+    // Prepare it once, as a statement that is kept for a long time.
+    sqlite3_stmt* stmt = NULL;
+    if (sqlite3_prepare_v3(handle, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, NULL) != SQLITE_OK) {
+        qDebug() << "Error: " << sqlite3_errmsg(handle);
+        sqlite3_finalize(stmt);
+        return NULL;
+    }
+
+    statements[key] = stmt;
+    return stmt;
+}
+
+bool matchStorage::migrate()
+{
+    if (!hasTable("game_data")) {
+        execute(writer, ("PRAGMA user_version=" + std::to_string(STORAGE_SCHEMA_VERSION) + ";").c_str());
+        return true;
+    }
+
+    // The whole conversion is one transaction, so a database is never left half converted.
+    bool migrated = execute(writer, "BEGIN;");
+
+    // Players, in the order they first played.
+    migrated = migrated && execute(writer, "INSERT OR IGNORE INTO players(name) SELECT name FROM"
+                                           " (SELECT player_A AS name, rowid AS stored FROM game_data"
+                                           " UNION ALL SELECT player_B, rowid FROM game_data) ORDER BY stored;");
+
+    // Ratings, for the players that were rated.
+    if (hasTable("player_ratings")) {
+        migrated = migrated && execute(writer, "INSERT OR IGNORE INTO players(name) SELECT name FROM player_ratings;");
+        migrated = migrated && execute(writer, "UPDATE players SET (rating, deviation, volatility, rated_matches) ="
+                                               " (SELECT rating, deviation, volatility, matches FROM player_ratings"
+                                               " WHERE player_ratings.name = players.name)"
+                                               " WHERE name IN (SELECT name FROM player_ratings);");
+    }
+
+    // One match for each match ID, in the order of their first games.
+    migrated = migrated && execute(writer, "INSERT INTO matches(match_key, player_a, player_b, table_mode)"
+                                           " SELECT d.ID, a.id, b.id, d.table_mode FROM game_data d"
+                                           " JOIN players a ON a.name = d.player_A JOIN players b ON b.name = d.player_B"
+                                           " WHERE d.rowid IN (SELECT MIN(rowid) FROM game_data GROUP BY ID) ORDER BY d.rowid;");
+
+    // The games of each match, numbered in the order they were played. The earlier version stored the games of a match from
+    // the last game played to the first, so the last game stored is game 1.
+    migrated = migrated && execute(writer, "INSERT INTO games(match_id, game_number, a_score, b_score)"
+                                           " SELECT m.id, ROW_NUMBER() OVER (PARTITION BY d.ID ORDER BY d.rowid DESC), d.A_score, d.B_score"
+                                           " FROM game_data d JOIN matches m ON m.match_key = d.ID;");
+
+    // Drop the old tables.
+    migrated = migrated && execute(writer, "DROP TABLE game_data;");
+    migrated = migrated && execute(writer, "DROP TABLE IF EXISTS player_ratings;");
+    migrated = migrated && execute(writer, ("PRAGMA user_version=" + std::to_string(STORAGE_SCHEMA_VERSION) + ";").c_str());
+
+    if (!migrated || !execute(writer, "COMMIT;")) {
+        qDebug() << "Error: the game records could not be converted, they are kept as they were";
+        execute(writer, "ROLLBACK;");
+        return false;
+    }
+
+    return true;
+}
+
+bool matchStorage::hasTable(const char* table)
+{
+    sqlite3_stmt* stmt = prepare(writer, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?;");
+    if (stmt == NULL) return false;
+
+    sqlite3_bind_text(stmt, 1, table, -1, SQLITE_TRANSIENT);
+    bool found = (sqlite3_step(stmt) == SQLITE_ROW);
+    sqlite3_reset(stmt);
+
+    return found;
+}
+
+bool matchStorage::execute(sqlite3* handle, const char* sql)
+{
+    char* err = NULL;
+
+    // Check to make sure we dont get any errors.
+    if (sqlite3_exec(handle, sql, NULL, NULL, &err) != SQLITE_OK) {
+        qDebug() << "Error: " << err;
+        sqlite3_free(err);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file matchstorage.h
+ * @author Ali Sarfraz
+ * @brief Header file used to declare the match storage service.
+ *
+ * This class keeps the SQLite database of the game records open for the lifetime of the
+ * program, instead of opening and closing the file for every match or search. The database
+ * is opened once at startup in write-ahead log (WAL) mode, so the history can be read while
+ * a match is being written, and with synchronous=NORMAL, so a commit only syncs the log at
+ * checkpoints rather than on every transaction. The tables are created once at startup.
+ *
+ * The service hands out two handles: a writer handle for every change to the database, and
+ * a read-only handle for searches. Statements prepared on either handle are kept and reused.
+ * The writer handle is used by the storage writer thread (see storagewriter.h) and the reader
+ * by the GUI, so the kept statements are shared between threads under a lock.
+ *
+ * The records are kept in four tables with integer keys:
+ * - players(id, name, rating, deviation, volatility, rated_matches), one row per player name,
+ *   with the rating of the player once rated
+ * - matches(id, match_key, player_a, player_b, table_mode), one row per match, numbered in the
+ *   order the matches were played and indexed by each player for the history of a player
+ * - games(match_id, game_number, a_score, b_score), stored by match so the games of a match
+ *   are read together
+ * - goals(match_id, game_number, goal_number, time, speed, side), stored by game with only
+ *   integer columns (the side is 0 or 1, which takes no space beyond the row header), and
+ *   appended with the games of the match, several goals per insert
+ * A database of an earlier version (a single game_data table repeating the player names on
+ * every game, and a player_ratings table) is converted in place when it is opened.
+ *
+ * @version 0.4
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef MATCHSTORAGE_H
+#define MATCHSTORAGE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "sqlite3.h"
+
+#define STORAGE_CACHE_KIB 8192 //!< Page cache of each handle [KiB]
+#define STORAGE_BUSY_TIMEOUT 2000 //!< Time a handle waits for a lock held by the other handle [ms]
+#define STORAGE_SCHEMA_VERSION 1 //!< Version of the tables, kept in the user_version of the database
+#define STORAGE_GOAL_BATCH 16 //!< Number of goals appended by one insert statement
+
+/**
+ * @brief The matchStorage class opens the database once, and hands out the writer and
+ * reader handles and the statements prepared on them.
+ */
+class matchStorage
+{
+public:
+    /**
+     * @brief Opens (or creates) the database, sets up both handles and creates the tables.
+     *
+     * @param file_name Name of the database file.
+     */
+    explicit matchStorage(const char* file_name);
+
+    /**
+     * @brief Finalizes every kept statement and closes both handles, which checkpoints the
+     * log into the database file.
+     */
+    ~matchStorage();
+
+    // The handles are owned by the service, it is never copied.
+    matchStorage(const matchStorage &) = delete;
+    matchStorage &operator=(const matchStorage &) = delete;
+
+    /**
+     * @brief Indicates if both handles were opened.
+     *
+     * @return True if the database can be used.
+     */
+    bool isOpen();
+
+    /**
+     * @brief Returns the handle used for every change to the database.
+     *
+     * @return Writer handle, or NULL if the database could not be opened.
+     */
+    sqlite3* getWriter();
+
+    /**
+     * @brief Returns the read-only handle used for searches, which does not wait for the writer.
+     *
+     * @return Reader handle, or NULL if the database could not be opened.
+     */
+    sqlite3* getReader();
+
+    /**
+     * @brief Returns a statement prepared on one of the handles. The statement is prepared the
+     * first time and kept, later calls reset it and clear its bindings. The statement belongs
+     * to the service and must not be finalized.
+     *
+     * @param handle Writer or reader handle.
+     * @param sql SQL text of the statement.
+     * @return Statement, or NULL if it could not be prepared.
+     */
+    sqlite3_stmt* prepare(sqlite3* handle, const char* sql);
+
+private:
+    /**
+     * @brief Writer handle.
+     */
+    sqlite3* writer;
+
+    /**
+     * @brief Read-only handle.
+     */
+    sqlite3* reader;
+
+    /**
+     * @brief Statements kept, by handle and SQL text.
+     */
+    std::map<std::pair<sqlite3*, std::string>, sqlite3_stmt*> statements;
+
+    /**
+     * @brief Protects the kept statements, as the handles are used on different threads.
+     */
+    std::mutex statementsMutex;
+
+    /**
+     * @brief Converts the game_data and player_ratings tables of an earlier version into the
+     * players, matches and games tables, in one transaction, and drops them.
+     *
+     * @return True if the database was converted, or did not need to be.
+     */
+    bool migrate();
+
+    /**
+     * @brief Indicates if a table exists on the writer.
+     *
+     * @param table Name of the table.
+     * @return True if the table exists.
+     */
+    bool hasTable(const char* table);
+
+    /**
+     * @brief Runs a statement that returns no rows, and reports any error.
+     *
+     * @param handle Handle to run the statement on.
+     * @param sql SQL text of the statement.
+     * @return True if the statement ran.
+     */
+    bool execute(sqlite3* handle, const char* sql);
+};
+
+#endif // MATCHSTORAGE_H
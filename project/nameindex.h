@@ -0,0 +1,99 @@
+/**
+ * @file nameindex.h
+ * @author Ali Sarfraz
+ * @brief Header file used to declare the index of the player names.
+ *
+ * This class keeps every stored player name in memory, sorted by its lower case form, so the
+ * names starting with what has been typed so far are found with a binary search and shown as
+ * suggestions on every keystroke. Picking a suggestion keeps a returning player from being
+ * stored a second time under a misspelled name.
+ *
+ * The names are loaded from the players table by the storage writer when the program starts,
+ * and a name is added as soon as a match with a new player is handed to the writer. The index
+ * is only used on the GUI thread.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <QLineEdit>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define NAME_SUGGESTION_LIMIT 8 //!< Most names suggested at once
+
+/**
+ * @brief The nameIndex class keeps the player names sorted for prefix search, and shows the
+ * names matching the text of a line edit as it is typed.
+ */
+class nameIndex
+{
+public:
+    /**
+     * @brief Creates an empty index.
+     */
+    nameIndex();
+
+    /**
+     * @brief Adds the names loaded from the database to the index, keeping the names added
+     * while they were loaded.
+     *
+     * @param names Names of the stored players, in any order.
+     */
+    void load(const std::vector<std::string> &names);
+
+    /**
+     * @brief Adds a name to the index, if not already present.
+     *
+     * @param name Name of the player.
+     */
+    void insert(const std::string &name);
+
+    /**
+     * @brief Finds the names that start with a prefix, ignoring case.
+     *
+     * @param prefix Text typed so far.
+     * @param limit Most names returned.
+     * @return Names starting with the prefix, in alphabetical order.
+     */
+    std::vector<std::string> suggest(const std::string &prefix, unsigned long limit = NAME_SUGGESTION_LIMIT);
+
+    /**
+     * @brief Indicates the number of names in the index.
+     *
+     * @return Number of names.
+     */
+    unsigned long size();
+
+    /**
+     * @brief Shows the names starting with the text of a line edit in a popup under it, updated
+     * on every keystroke. The index has to outlive the line edit.
+     *
+     * @param lineEdit Line edit a player name is typed in.
+     */
+    void attach(QLineEdit *lineEdit);
+
+private:
+    /**
+     * @brief Lower case form of each name with the name itself, sorted by lower case form.
+     */
+    std::vector<std::pair<std::string, std::string> > names;
+
+    /**
+     * @brief Returns the lower case form of a name, which the names are sorted and searched by.
+     *
+     * @param name Name to fold.
+     * @return Name in lower case.
+     */
+    static std::string fold(const std::string &name);
+};
+
+#endif // NAMEINDEX_H
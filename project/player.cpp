@@ -41,6 +41,12 @@ void player::setpType(unsigned int type)
     pType = type;
 }
 
+
+void player::setRating(int rating)
+{
+    pRating = rating;
+}
+
 //Getter Methods
 
 std::string player::getName()
@@ -2,8 +2,8 @@
  * @file playersettingswindow.cpp
  * @author Natalia Bohulevych
  * @brief Implementation file used to implement the playersettingswindow class
- * @version 0.4
- * @date 2020-11-28
+ * @version 0.6
+ * @date 2026-10-19
  *
  * @copyright Copyright (c) 2020
  *
@@ -26,8 +26,9 @@ using namespace std;
  * @param parent => Pointer to the calling Qt window
  * @param playerAObjPtr => Pointer to readable parent player A object
  * @param playerBObjPtr => Pointer to readable parent player B object
+ * @param playerNames => Pointer to the index of the stored player names, suggested as the names are typed
  */
-playersettingswindow::playersettingswindow(QWidget *parent, player *playerAObjPtr, player *playerBObjPtr) :
+playersettingswindow::playersettingswindow(QWidget *parent, player *playerAObjPtr, player *playerBObjPtr, nameIndex *playerNames) :
     QDialog(parent),
     ui(new Ui::playersettingswindow)
 {
@@ -44,6 +45,12 @@ playersettingswindow::playersettingswindow(QWidget *parent, player *playerAObjPt
 
     ui->setupUi(this);
 
+    //suggest the names of returning players as they are typed
+    if (playerNames != nullptr)
+    {
+        playerNames->attach(ui->lineEdit_playerAname);
+        playerNames->attach(ui->lineEdit_playerBname);
+    }
 
 //COMBO BOXES
     //block signals
@@ -96,7 +103,7 @@ playersettingswindow::~playersettingswindow()
 
 /**
  * @brief Function for when user clicks "OK" buttun in GUI window. Copies over changes made to
- * temporary player objects to passed (parent) player objects
+ * temporary player objects to passed (parent) player objects, and tells the main menu
  */
 void playersettingswindow::on_buttonBox_accepted()
 {
@@ -104,6 +111,9 @@ void playersettingswindow::on_buttonBox_accepted()
     parentPlayerBPtr->setName(tempPlayerBPtr->getName());
     parentPlayerAPtr->setpType(tempPlayerAPtr->getType());
     parentPlayerBPtr->setpType(tempPlayerBPtr->getType());
+
+    //the ratings of the players are read by the main menu
+    emit playersChanged();
 }
 
 /**
@@ -9,10 +9,11 @@
  * player objects that are passed to it, in the context of this project, this
  * would be the tplayer objects held by the main menu window. Should the user hit
  * accept on the GUI interface, the chosen settings will be applied to the passed player
- * objects.
+ * objects. The names of returning players are suggested as they are typed, and the
+ * main menu is told once the players are changed, so it can read their stored ratings.
  *
- * @version 0.2
- * @date 2020-12-02
+ * @version 0.4
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -24,6 +25,7 @@
 
 #include <QDialog>
 #include "player.h"
+#include "nameindex.h"
 
 namespace Ui {
 /**
@@ -39,9 +41,15 @@ class playersettingswindow : public QDialog
     Q_OBJECT
 
 public:
-    explicit playersettingswindow(QWidget *parent = nullptr, player *playerAObjPtr = nullptr, player *playerBObjPtr = nullptr);
+    explicit playersettingswindow(QWidget *parent = nullptr, player *playerAObjPtr = nullptr, player *playerBObjPtr = nullptr, nameIndex *playerNames = nullptr);
     ~playersettingswindow();
 
+signals:
+    /**
+     * @brief Emitted once the chosen settings have been applied to the passed player objects
+     */
+    void playersChanged();
+
 private slots:
     void on_buttonBox_accepted();
 
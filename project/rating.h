@@ -0,0 +1,122 @@
+/**
+ * @file rating.h
+ * @author Sanjayan Kulendran
+ * @brief Header file used to declare the ratingEngine class.
+ * The ratingEngine rates players with the Glicko-2 system: each player has a rating, a rating deviation (how uncertain the
+ * rating is) and a volatility (how erratic the results of the player are). Every finished match is one rating period, in which
+ * both players are updated from the ratings they had before the match
+ * The ratings can also be computed again from the full match history, for example after the parameters were changed. The
+ * matches are grouped into levels, where a match is one level after the last matches of both its players, so the matches of
+ * a level have no player in common and are rated in parallel, with the same result as rating them one after the other
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef RATING_H
+#define RATING_H
+
+#include<vector>  //Vectors for the match history and ratings
+
+#define RATING_INITIAL 1500.0 //!< Rating of a new player
+#define RATING_INITIAL_DEVIATION 350.0 //!< Rating deviation of a new player
+#define RATING_INITIAL_VOLATILITY 0.06 //!< Volatility of a new player
+#define RATING_TAU 0.5 //!< System constant limiting how quickly the volatility changes (0.3 to 1.2)
+#define RATING_SCALE 173.7178 //!< Factor between the Glicko scale and the Glicko-2 scale
+#define RATING_CONVERGENCE 0.000001 //!< Tolerance of the volatility iteration
+
+/**
+ * @brief Parameters of the rating system
+ */
+struct ratingParameters
+{
+    double initialRating; //!< Rating of a new player
+    double initialDeviation; //!< Rating deviation of a new player
+    double initialVolatility; //!< Volatility of a new player
+    double tau; //!< System constant limiting how quickly the volatility changes
+};
+
+/**
+ * @brief Rating of one player
+ */
+struct playerRating
+{
+    double rating; //!< Rating, on the Glicko scale (a new player is at 1500)
+    double deviation; //!< Rating deviation, the rating is within about two deviations of the true strength
+    double volatility; //!< Expected fluctuation of the rating
+    unsigned long matches; //!< Number of matches rated
+};
+
+/**
+ * @brief One match of the history, as needed for rating
+ */
+struct ratedMatch
+{
+    unsigned long playerA; //!< Index of player A in the ratings
+    unsigned long playerB; //!< Index of player B in the ratings
+    double playerAScore; //!< 1 if player A won, 0 if player B won, 0.5 for a tie
+};
+
+/**
+ * @brief The ratingEngine class updates the Glicko-2 ratings of the players of a match, and computes the ratings of every
+ * player from a match history
+ */
+class ratingEngine
+{
+
+private:
+
+    ratingParameters parameters; //!< Parameters of the rating system
+
+    /**
+     * @brief updatePlayer - Function that computes the rating of a player after a match
+     * @param player - rating of the player before the match
+     * @param opponent - rating of the opponent before the match
+     * @param score - 1 if the player won, 0 if the opponent won, 0.5 for a tie
+     * @return rating of the player after the match
+     */
+    playerRating updatePlayer(const playerRating &player, const playerRating &opponent, double score) const;
+
+public:
+
+    /**
+     * @brief ratingEngine - Constructor for an engine with the default parameters (see the RATING defines)
+     */
+    ratingEngine();
+
+    /**
+     * @brief ratingEngine - Constructor for an engine with given parameters
+     * @param engineParameters - parameters of the rating system
+     */
+    ratingEngine(const ratingParameters &engineParameters);
+
+    /**
+     * @brief newRating - Function that returns the rating of a player who has not played yet
+     * @return initial rating
+     */
+    playerRating newRating() const;
+
+    /**
+     * @brief rateMatch - Function that updates the ratings of both players of a finished match
+     * @param playerA - rating of player A, updated
+     * @param playerB - rating of player B, updated
+     * @param playerAScore - 1 if player A won, 0 if player B won, 0.5 for a tie
+     */
+    void rateMatch(playerRating &playerA, playerRating &playerB, double playerAScore) const;
+
+    /**
+     * @brief recompute - Function that computes the ratings of every player from the full match history
+     * @param history - matches in the order they were played
+     * @param playerCount - number of players, every index in the history must be less than this
+     * @param threadCount - number of threads to rate with (0 for one per core)
+     * @return rating of every player, by index
+     */
+    std::vector<playerRating> recompute(const std::vector<ratedMatch> &history, unsigned long playerCount, unsigned threadCount = 0) const;
+
+};
+
+#endif // RATING_H
@@ -0,0 +1,159 @@
+/**
+ * @file storagewriter.h
+ * @author Ali Sarfraz
+ * @brief Header file used to declare the background storage writer.
+ *
+ * This class writes to the database on its own thread, so saving a match never holds up the
+ * GUI, even when the SD card is slow to sync. Writes are handed to it as persistence jobs on
+ * a bounded queue: a job is never dropped, and the GUI only waits when the queue is full.
+ *
+ * The writer takes every job waiting on the queue and commits them together in one
+ * transaction (group commit), so matches finishing close together on several windows share
+ * one sync of the file. Each job runs in its own savepoint, so a job that fails is undone
+ * on its own without undoing the others. A signal is sent back to the GUI once each job is
+ * committed, and the queue is flushed before the writer is destroyed.
+ *
+ * Every change to the database goes through the writer, which is the only user of the
+ * writer handle of the storage service.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef STORAGEWRITER_H
+#define STORAGEWRITER_H
+
+#include <QObject>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "matchstorage.h"
+
+#define STORAGE_QUEUE_CAPACITY 16 //!< Number of jobs that may wait for the writer before submitting waits
+#define STORAGE_GROUP_LIMIT 64 //!< Most jobs committed in one transaction
+
+/**
+ * @brief A persistence job, run on the writer thread inside a transaction. It makes its
+ * changes through the writer handle of the storage service, and returns false to undo them.
+ */
+typedef std::function<bool(matchStorage &storage)> storageJob;
+
+/**
+ * @brief The storageWriter class runs persistence jobs on a background thread, committing
+ * the jobs waiting together, and signals when each job is committed.
+ */
+class storageWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Starts the writer thread.
+     *
+     * @param storage Storage service whose writer handle the jobs use.
+     * @param capacity Number of jobs that may wait (at least 1).
+     */
+    explicit storageWriter(matchStorage *storage, unsigned long capacity = STORAGE_QUEUE_CAPACITY);
+
+    /**
+     * @brief Commits every job still waiting, then stops the writer thread.
+     */
+    ~storageWriter();
+
+    /**
+     * @brief Puts a job on the queue, waiting for room if the queue is full.
+     *
+     * @param job Job to run.
+     * @return Number of the job, as given by the jobFinished signal.
+     */
+    unsigned long submit(storageJob job);
+
+    /**
+     * @brief Waits until every job submitted so far has been committed.
+     */
+    void flush();
+
+signals:
+    /**
+     * @brief Sent on the GUI thread once a job has been committed or undone.
+     *
+     * @param job Number of the job.
+     * @param committed True if the changes of the job were committed.
+     */
+    void jobFinished(unsigned long job, bool committed);
+
+private:
+    /**
+     * @brief Storage service written to.
+     */
+    matchStorage *storage;
+
+    /**
+     * @brief Jobs waiting, with their numbers.
+     */
+    std::deque<std::pair<unsigned long, storageJob> > jobs;
+
+    /**
+     * @brief Maximum number of jobs waiting.
+     */
+    unsigned long capacity;
+
+    /**
+     * @brief Number given to the next job submitted.
+     */
+    unsigned long nextJob;
+
+    /**
+     * @brief Number of jobs committed or undone so far.
+     */
+    unsigned long finishedJobs;
+
+    /**
+     * @brief True once the writer is asked to stop.
+     */
+    bool stopping;
+
+    /**
+     * @brief Protects the queue and the counts, as jobs are submitted and run on different threads.
+     */
+    std::mutex queueMutex;
+
+    /**
+     * @brief Signalled when a job is submitted or the writer is asked to stop.
+     */
+    std::condition_variable jobAvailable;
+
+    /**
+     * @brief Signalled when jobs are taken off the queue or finished.
+     */
+    std::condition_variable jobsTaken;
+
+    /**
+     * @brief Writer thread.
+     */
+    std::thread writerThread;
+
+    /**
+     * @brief Body of the writer thread: takes the waiting jobs and commits them together,
+     * until asked to stop with no job left.
+     */
+    void run();
+
+    /**
+     * @brief Runs a group of jobs in one transaction, each in its own savepoint.
+     *
+     * @param group Jobs to run.
+     * @param results Set to whether each job was committed.
+     */
+    void commitGroup(std::vector<std::pair<unsigned long, storageJob> > &group, std::vector<bool> &results);
+};
+
+#endif // STORAGEWRITER_H
@@ -0,0 +1,191 @@
+/**
+ * @file tournamentdisplay.cpp
+ * @author Sanjayan Kulendran
+ * @brief Implementation file used to implent the qt5 based tournamentDisplay class.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+
+#include "tournamentdisplay.h"
+#include "ui_tournamentdisplay.h"
+
+#include <QMessageBox>
+#include <set>
+
+//Names of the brackets, in the order of the TOURNAMENT_BRACKET defines
+static const char *bracketNames[] = {"Winners", "Losers", "Final", "Round"};
+
+tournamentDisplay::tournamentDisplay(std::unique_ptr<tournament> &currentTournamentReference, std::function<std::vector<double>(const std::vector<std::string> &)> ratingLoader, std::function<unsigned char(const std::string &, const std::string &)> matchPlayer, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::tournamentDisplay)
+{
+    ui->setupUi(this);
+
+    //Save the tournament and the functions of the caller
+    currentTournament = &currentTournamentReference;
+    loadRatings = ratingLoader;
+    playMatch = matchPlayer;
+
+    //Formats, in the order of the TOURNAMENT defines
+    ui->comboBoxFormat->addItem("Single Elimination");
+    ui->comboBoxFormat->addItem("Double Elimination");
+    ui->comboBoxFormat->addItem("Round Robin");
+
+    //Show the tournament in progress, if any
+    showTournament();
+}
+
+tournamentDisplay::~tournamentDisplay()
+{
+    delete ui;
+}
+
+void tournamentDisplay::on_pushButtonCreate_clicked()
+{
+    //Read the entrants, one name per line, skipping empty lines and names entered twice
+    std::vector<std::string> names;
+    std::set<std::string> enteredNames;
+    QStringList lines = ui->plainTextEditEntrants->toPlainText().split('\n');
+
+    for(int i = 0; i < lines.size(); i++){
+        std::string name = lines[i].trimmed().toStdString();
+        if(!name.empty() && enteredNames.insert(name).second) names.push_back(name);
+    }
+
+    if(names.size() < 2){
+        QMessageBox::warning(this, "Tournament", "A tournament needs at least two entrants.");
+        return;
+    }
+
+    //Creating a tournament replaces the one in progress
+    if(*currentTournament && !(*currentTournament)->isTournamentOver()){
+        if(QMessageBox::question(this, "Tournament", "Replace the tournament in progress?") != QMessageBox::Yes) return;
+    }
+
+    //Seed the entrants by their ratings, and queue the first matches on the tables
+    std::vector<double> ratings = loadRatings(names);
+    currentTournament->reset(new tournament(static_cast<unsigned char>(ui->comboBoxFormat->currentIndex()), names, ratings, static_cast<unsigned long>(ui->spinBoxTables->value())));
+
+    showTournament();
+}
+
+void tournamentDisplay::on_pushButtonPlay_clicked()
+{
+    unsigned long matchIndex = getSelectedMatch();
+    if(matchIndex == TOURNAMENT_NONE) return;
+
+    //Play the match through the match display, a match left before it was over stays on its table
+    const tournamentMatch &selected = (*currentTournament)->getMatch(matchIndex);
+    unsigned char result = playMatch((*currentTournament)->getEntrant(selected.entrants[0]).name, (*currentTournament)->getEntrant(selected.entrants[1]).name);
+
+    if(result != MATCH_RESULT_UNDECIDED) (*currentTournament)->reportResult(matchIndex, result);
+
+    showTournament();
+}
+
+void tournamentDisplay::on_pushButtonPlayerAWon_clicked()
+{
+    reportSelected(MATCH_RESULT_PLAYER_A);
+}
+
+void tournamentDisplay::on_pushButtonPlayerBWon_clicked()
+{
+    reportSelected(MATCH_RESULT_PLAYER_B);
+}
+
+void tournamentDisplay::on_listWidgetTables_currentRowChanged(int row)
+{
+    //The buttons only act on a table with a match
+    (void)row;
+    bool hasMatch = (getSelectedMatch() != TOURNAMENT_NONE);
+
+    ui->pushButtonPlay->setEnabled(hasMatch);
+    ui->pushButtonPlayerAWon->setEnabled(hasMatch);
+    ui->pushButtonPlayerBWon->setEnabled(hasMatch);
+}
+
+unsigned long tournamentDisplay::getSelectedMatch()
+{
+    int row = ui->listWidgetTables->currentRow();
+    if(!*currentTournament || (row < 0)) return TOURNAMENT_NONE;
+
+    return (*currentTournament)->getTableMatch(static_cast<unsigned long>(row));
+}
+
+void tournamentDisplay::reportSelected(unsigned char result)
+{
+    unsigned long matchIndex = getSelectedMatch();
+    if(matchIndex == TOURNAMENT_NONE) return;
+
+    (*currentTournament)->reportResult(matchIndex, result);
+
+    showTournament();
+}
+
+void tournamentDisplay::showTournament()
+{
+    int selectedRow = ui->listWidgetTables->currentRow();
+
+    ui->listWidgetTables->clear();
+    ui->listWidgetStandings->clear();
+
+    //Without a tournament, only the entrants can be entered
+    if(!*currentTournament){
+        ui->labelStatus->setText("Enter the entrants to create a tournament");
+        on_listWidgetTables_currentRowChanged(-1);
+        return;
+    }
+
+    tournament &shown = **currentTournament;
+
+    //Output the match on each table
+    for(unsigned long table = 0; table < shown.getTableCount(); table++){
+
+        QString text = "Table " + QString::number(table + 1) + ": ";
+        unsigned long matchIndex = shown.getTableMatch(table);
+
+        if(matchIndex == TOURNAMENT_NONE) text += "free";
+        else{
+            const tournamentMatch &played = shown.getMatch(matchIndex);
+            text += QString::fromStdString(shown.getEntrant(played.entrants[0]).name) + " vs " + QString::fromStdString(shown.getEntrant(played.entrants[1]).name);
+            text += " (" + QString(bracketNames[played.bracket]) + " " + QString::number(played.round) + ")";
+        }
+
+        ui->listWidgetTables->addItem(text);
+    }
+
+    //Output the standings
+    std::vector<unsigned long> standings = shown.getStandings();
+
+    for(unsigned long i = 0; i < standings.size(); i++){
+
+        const tournamentEntrant &entrant = shown.getEntrant(standings[i]);
+        QString text = QString::number(i + 1) + ". " + QString::fromStdString(entrant.name) + " (seed " + QString::number(entrant.seed) + ") ";
+
+        if(shown.getFormat() == TOURNAMENT_ROUND_ROBIN) text += QString::number(entrant.points) + " points";
+        else text += QString::number(entrant.wins) + "-" + QString::number(entrant.losses) + (entrant.eliminated ? " out" : "");
+
+        ui->listWidgetStandings->addItem(text);
+    }
+
+    //Output the status of the tournament
+    if(shown.isTournamentOver()){
+        unsigned long champion = shown.getChampion();
+        ui->labelStatus->setText("Champion: " + QString::fromStdString(shown.getEntrant(champion).name));
+    }
+    else{
+        ui->labelStatus->setText(QString::number(shown.getMatchesLeft()) + " matches left, " + QString::number(shown.getReadyCount()) + " waiting for a table");
+    }
+
+    //Keep the selected table, or select the first table
+    if(selectedRow < 0) selectedRow = 0;
+    if(selectedRow >= ui->listWidgetTables->count()) selectedRow = ui->listWidgetTables->count() - 1;
+    ui->listWidgetTables->setCurrentRow(selectedRow);
+    on_listWidgetTables_currentRowChanged(selectedRow);
+}
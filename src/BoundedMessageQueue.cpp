@@ -0,0 +1,128 @@
+/**
+ * @file BoundedMessageQueue.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the BoundedMessageQueue class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "BoundedMessageQueue.h"
+
+
+BoundedMessageQueue::BoundedMessageQueue(unsigned long capacity, unsigned int policy){
+
+    this->capacity = (capacity > 0) ? capacity : 1;
+    this->policy = policy;
+    this->highWaterMark = 0;
+    this->dropped = 0;
+    this->blocked = 0;
+
+}
+
+
+void BoundedMessageQueue::setCapacity(unsigned long capacity){
+
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    this->capacity = (capacity > 0) ? capacity : 1;
+
+    //A larger capacity may let a waiting writer through
+    this->spaceAvailable.notify_all();
+
+}
+
+
+void BoundedMessageQueue::setPolicy(unsigned int policy){
+
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    this->policy = policy;
+
+    //A writer waiting under the BLOCK policy must now apply the new policy
+    this->spaceAvailable.notify_all();
+
+}
+
+
+void BoundedMessageQueue::push(const MessagePacket &message){
+
+    std::unique_lock<std::mutex> lock(this->queueMutex);
+
+    if(this->messages.size() >= this->capacity){
+
+        if(this->policy == QUEUE_POLICY_BLOCK){
+
+            this->blocked++;
+
+            while(this->messages.size() >= this->capacity && this->policy == QUEUE_POLICY_BLOCK){
+                this->spaceAvailable.wait(lock);
+            }
+        }
+
+        if(this->policy == QUEUE_POLICY_KEEP_LATEST){
+
+            //Only the newest data matters, so everything waiting is stale
+            this->dropped += this->messages.size();
+            this->messages.clear();
+        }
+        else{
+
+            while(this->messages.size() >= this->capacity){
+                this->messages.pop_front();
+                this->dropped++;
+            }
+        }
+    }
+
+    this->messages.push_back(message);
+
+    if(this->messages.size() > this->highWaterMark){
+        this->highWaterMark = this->messages.size();
+    }
+
+}
+
+
+bool BoundedMessageQueue::tryPop(MessagePacket &message){
+
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    if(this->messages.empty()){
+        return false;
+    }
+
+    message = this->messages.front();
+    this->messages.pop_front();
+
+    this->spaceAvailable.notify_one();
+
+    return true;
+
+}
+
+
+unsigned long BoundedMessageQueue::clear(){
+
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    unsigned long cleared = this->messages.size();
+    this->messages.clear();
+
+    this->spaceAvailable.notify_all();
+
+    return cleared;
+
+}
+
+
+queueStatistics BoundedMessageQueue::getStatistics(){
+
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    queueStatistics statistics = {this->messages.size(), this->capacity, this->highWaterMark, this->dropped, this->blocked};
+    return statistics;
+
+}
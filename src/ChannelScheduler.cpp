@@ -0,0 +1,179 @@
+/**
+ * @file ChannelScheduler.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the ChannelScheduler class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "ChannelScheduler.h"
+
+
+//Default capacity and quota of every channel, in order of priority
+static const unsigned int defaultCapacity[ML_CHANNEL_COUNT] = {16, 64, 32, 32};
+static const unsigned int defaultQuota[ML_CHANNEL_COUNT] = {8, 8, 4, 1};
+
+
+ChannelScheduler::ChannelScheduler(){
+
+    for(unsigned int i = 0; i < ML_CHANNEL_COUNT; i++){
+        this->channelCapacity[i] = defaultCapacity[i];
+        this->channelQuota[i] = defaultQuota[i];
+        this->channelCredit[i] = defaultQuota[i];
+    }
+
+}
+
+
+void ChannelScheduler::setChannelLimits(unsigned int channel, unsigned int capacity, unsigned int quota){
+
+    if(channel >= ML_CHANNEL_COUNT){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->schedulerMutex);
+
+    this->channelCapacity[channel] = (capacity > 0) ? capacity : 1;
+    this->channelQuota[channel] = (quota > 0) ? quota : 1;
+    this->channelCredit[channel] = this->channelQuota[channel];
+
+    //A larger capacity may let waiting writers through
+    this->spaceAvailable.notify_all();
+
+}
+
+
+bool ChannelScheduler::push(unsigned int channel, const std::string &frame, bool wait){
+
+    if(channel >= ML_CHANNEL_COUNT){
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(this->schedulerMutex);
+
+    if(this->channelFrames[channel].size() >= this->channelCapacity[channel]){
+
+        if(!wait){
+            return false;
+        }
+
+        //Flow control: the writer is held back until the channel has room
+        while(this->channelFrames[channel].size() >= this->channelCapacity[channel]){
+            this->spaceAvailable.wait(lock);
+        }
+    }
+
+    this->channelFrames[channel].push_back(frame);
+    this->frameAvailable.notify_one();
+
+    return true;
+
+}
+
+
+bool ChannelScheduler::selectChannel(unsigned int &channel){
+
+    bool waiting = false;
+
+    //The highest priority channel with frames waiting and quota left is served first
+    for(unsigned int i = 0; i < ML_CHANNEL_COUNT; i++){
+
+        if(this->channelFrames[i].empty()){
+            continue;
+        }
+
+        waiting = true;
+
+        if(this->channelCredit[i] > 0){
+            channel = i;
+            return true;
+        }
+    }
+
+    if(!waiting){
+        return false;
+    }
+
+    //Every waiting channel has used its quota, so a new round begins
+    for(unsigned int i = 0; i < ML_CHANNEL_COUNT; i++){
+        this->channelCredit[i] = this->channelQuota[i];
+    }
+
+    for(unsigned int i = 0; i < ML_CHANNEL_COUNT; i++){
+        if(!this->channelFrames[i].empty()){
+            channel = i;
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+
+void ChannelScheduler::takeFrame(unsigned int channel, std::string &frame){
+
+    frame.swap(this->channelFrames[channel].front());
+    this->channelFrames[channel].pop_front();
+    this->channelCredit[channel]--;
+
+    this->spaceAvailable.notify_all();
+
+}
+
+
+unsigned int ChannelScheduler::pop(std::string &frame){
+
+    std::unique_lock<std::mutex> lock(this->schedulerMutex);
+
+    unsigned int channel = 0;
+    while(!this->selectChannel(channel)){
+        this->frameAvailable.wait(lock);
+    }
+
+    this->takeFrame(channel, frame);
+
+    return channel;
+
+}
+
+
+bool ChannelScheduler::tryPop(std::string &frame, unsigned int &channel){
+
+    std::lock_guard<std::mutex> lock(this->schedulerMutex);
+
+    if(!this->selectChannel(channel)){
+        return false;
+    }
+
+    this->takeFrame(channel, frame);
+
+    return true;
+
+}
+
+
+unsigned long ChannelScheduler::getPending(unsigned int channel){
+
+    std::lock_guard<std::mutex> lock(this->schedulerMutex);
+    return (channel < ML_CHANNEL_COUNT) ? this->channelFrames[channel].size() : 0;
+
+}
+
+
+bool ChannelScheduler::isEmpty(){
+
+    std::lock_guard<std::mutex> lock(this->schedulerMutex);
+
+    for(unsigned int i = 0; i < ML_CHANNEL_COUNT; i++){
+        if(!this->channelFrames[i].empty()){
+            return false;
+        }
+    }
+
+    return true;
+
+}
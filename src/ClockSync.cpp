@@ -0,0 +1,203 @@
+/**
+ * @file ClockSync.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the ClockSync class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "ClockSync.h"
+#include "MessageLibrary.h"
+
+
+ClockSync::ClockSync(){
+
+    this->reset();
+
+}
+
+
+void ClockSync::reset(){
+
+    std::lock_guard<std::mutex> lock(this->syncMutex);
+
+    this->samples.clear();
+
+    this->lastBoardTime = 0;
+    this->lastBoardTimeUnwrapped = 0;
+    this->estimatedOffset = 0;
+    this->estimatedDrift = 0;
+
+    this->statistics.synchronized = false;
+    this->statistics.offset = 0;
+    this->statistics.drift = 0;
+    this->statistics.uncertainty = 0;
+    this->statistics.samples = 0;
+
+}
+
+
+bool ClockSync::sampleDue(std::chrono::steady_clock::time_point now){
+
+    std::lock_guard<std::mutex> lock(this->syncMutex);
+
+    //A burst of samples gives a first estimate quickly, after which the drift only needs an occasional sample
+    if(this->statistics.samples < CLOCK_SYNC_BURST){
+        return true;
+    }
+
+    return now - this->lastSampleTime >= std::chrono::milliseconds(CLOCK_SYNC_PERIOD);
+
+}
+
+
+void ClockSync::addSample(std::chrono::steady_clock::time_point sent, std::chrono::steady_clock::time_point received, uint32_t boardTime){
+
+    std::lock_guard<std::mutex> lock(this->syncMutex);
+
+    if(this->statistics.samples == 0){
+        this->epoch = sent;
+        this->lastBoardTime = boardTime;
+        this->lastBoardTimeUnwrapped = boardTime;
+    }
+
+    //Heartbeats are answered in order, so the board timer moved forward since the last sample (wrapping at most once)
+    uint32_t elapsed = (boardTime - this->lastBoardTime) & ML_TIMESTAMP_MASK;
+    this->lastBoardTimeUnwrapped += elapsed;
+    this->lastBoardTime = boardTime;
+
+    clockSample sample;
+    double sentTime = std::chrono::duration<double, std::micro>(sent - this->epoch).count();
+    double receivedTime = std::chrono::duration<double, std::micro>(received - this->epoch).count();
+
+    //The board time is taken as the middle of the round trip, which is off by at most half the round trip
+    sample.hmiTime = (sentTime + receivedTime) / 2;
+    sample.offset = (double)this->lastBoardTimeUnwrapped - sample.hmiTime;
+    sample.roundTrip = receivedTime - sentTime;
+
+    this->samples.push_back(sample);
+    if(this->samples.size() > CLOCK_SYNC_WINDOW){
+        this->samples.pop_front();
+    }
+
+    this->lastSampleTime = received;
+    this->statistics.samples++;
+    this->statistics.synchronized = true;
+
+    this->estimate();
+
+}
+
+
+void ClockSync::estimate(){
+
+    //Samples delayed in a queue on either side have a long round trip and a wrong offset, so only the samples with a round
+    //trip close to the shortest one are used
+    double shortestRoundTrip = this->samples.front().roundTrip;
+    for(unsigned int i = 0; i < this->samples.size(); i++){
+        if(this->samples[i].roundTrip < shortestRoundTrip){
+            shortestRoundTrip = this->samples[i].roundTrip;
+        }
+    }
+
+    double threshold = (2 * shortestRoundTrip > shortestRoundTrip + 100) ? 2 * shortestRoundTrip : shortestRoundTrip + 100;
+
+    //Least squares fit of the offset over time: the slope is the drift
+    double count = 0;
+    double sumTime = 0;
+    double sumOffset = 0;
+    double firstTime = 0;
+    double lastTime = 0;
+    double bestOffset = 0;
+
+    for(unsigned int i = 0; i < this->samples.size(); i++){
+
+        const clockSample &sample = this->samples[i];
+
+        if(sample.roundTrip == shortestRoundTrip){
+            bestOffset = sample.offset;
+        }
+
+        if(sample.roundTrip > threshold){
+            continue;
+        }
+
+        if(count == 0){
+            firstTime = sample.hmiTime;
+        }
+        lastTime = sample.hmiTime;
+
+        count++;
+        sumTime += sample.hmiTime;
+        sumOffset += sample.offset;
+    }
+
+    if(count >= 2 && lastTime - firstTime >= CLOCK_SYNC_MIN_SPAN * 1000.0){
+
+        double meanTime = sumTime / count;
+        double meanOffset = sumOffset / count;
+        double covariance = 0;
+        double variance = 0;
+
+        for(unsigned int i = 0; i < this->samples.size(); i++){
+
+            const clockSample &sample = this->samples[i];
+
+            if(sample.roundTrip > threshold){
+                continue;
+            }
+
+            covariance += (sample.hmiTime - meanTime) * (sample.offset - meanOffset);
+            variance += (sample.hmiTime - meanTime) * (sample.hmiTime - meanTime);
+        }
+
+        this->estimatedDrift = covariance / variance;
+        this->estimatedOffset = meanOffset - this->estimatedDrift * meanTime;
+    }
+    else{
+        //Too short to see any drift, the most accurate sample gives the offset
+        this->estimatedDrift = 0;
+        this->estimatedOffset = bestOffset;
+    }
+
+    this->statistics.offset = this->estimatedOffset + this->estimatedDrift * this->samples.back().hmiTime;
+    this->statistics.drift = this->estimatedDrift * 1e6;
+    this->statistics.uncertainty = shortestRoundTrip / 2;
+
+}
+
+
+bool ClockSync::boardToSteady(uint32_t boardTime, std::chrono::steady_clock::time_point &steadyTime){
+
+    std::lock_guard<std::mutex> lock(this->syncMutex);
+
+    if(!this->statistics.synchronized){
+        return false;
+    }
+
+    //The board time may be before or after the last sample, so the nearest match of the wrapped value is used
+    int64_t difference = (boardTime - this->lastBoardTime) & ML_TIMESTAMP_MASK;
+    if(difference > (int64_t)(ML_TIMESTAMP_MASK / 2)){
+        difference -= (int64_t)ML_TIMESTAMP_MASK + 1;
+    }
+
+    double board = (double)(this->lastBoardTimeUnwrapped + difference);
+
+    //board = hmi + offset + drift * hmi
+    double hmiTime = (board - this->estimatedOffset) / (1 + this->estimatedDrift);
+
+    steadyTime = this->epoch + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(hmiTime));
+    return true;
+
+}
+
+
+clockSyncStatistics ClockSync::getStatistics(){
+
+    std::lock_guard<std::mutex> lock(this->syncMutex);
+    return this->statistics;
+
+}
@@ -0,0 +1,188 @@
+/**
+ * @file LatencyProbe.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the LatencyProbe class
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "LatencyProbe.h"
+
+#include <algorithm>
+
+
+//Names of the stages, used in the report
+static const char *stageNames[LATENCY_STAGE_COUNT] = {"emitted", "received", "dequeued", "added", "displayed"};
+
+
+LatencyProbe::LatencyProbe(){
+
+    this->enabled = false;
+    this->sampleCount = 0;
+
+    for(unsigned int i = 0; i < LATENCY_STAGE_COUNT; i++){
+        this->stageCount[i] = 0;
+    }
+
+}
+
+
+LatencyProbe& LatencyProbe::instance(){
+
+    //Function-local statics are initialized once in a thread-safe manner
+    static LatencyProbe probe;
+    return probe;
+
+}
+
+
+void LatencyProbe::enable(unsigned long capacity){
+
+    std::lock_guard<std::mutex> lock(this->probeMutex);
+
+    //Allocate every sample before recording, so that marking a stage never allocates
+    this->samples.assign(capacity, latencySample());
+    this->sampleCount = 0;
+
+    for(unsigned int i = 0; i < LATENCY_STAGE_COUNT; i++){
+        this->stageCount[i] = 0;
+    }
+
+    this->enabled = true;
+
+}
+
+
+void LatencyProbe::disable(){
+
+    this->enabled = false;
+
+}
+
+
+void LatencyProbe::record(unsigned int stage, unsigned long goalTimestamp, std::chrono::steady_clock::time_point stageTime){
+
+    if(stage >= LATENCY_STAGE_COUNT){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->probeMutex);
+
+    //Goals in flight are among the last ones recorded, so the search starts from the newest goal
+    unsigned long oldest = (this->sampleCount > LATENCY_MATCH_WINDOW) ? this->sampleCount - LATENCY_MATCH_WINDOW : 0;
+    latencySample *sample = NULL;
+
+    for(unsigned long i = this->sampleCount; i > oldest; i--){
+        if(this->samples[i - 1].goalTimestamp == goalTimestamp){
+            sample = &this->samples[i - 1];
+            break;
+        }
+    }
+
+    //A goal seen for the first time starts a new sample, while there is room for it
+    if(sample == NULL){
+
+        if(this->sampleCount >= this->samples.size()){
+            return;
+        }
+
+        sample = &this->samples[this->sampleCount++];
+        sample->goalTimestamp = goalTimestamp;
+    }
+
+    //A stage is only counted once per goal, so an exact mark is kept over a later estimate
+    if(sample->stageTime[stage] == std::chrono::steady_clock::time_point()){
+        sample->stageTime[stage] = stageTime;
+        this->stageCount[stage]++;
+    }
+
+}
+
+
+unsigned long LatencyProbe::getStageCount(unsigned int stage){
+
+    std::lock_guard<std::mutex> lock(this->probeMutex);
+    return (stage < LATENCY_STAGE_COUNT) ? this->stageCount[stage] : 0;
+
+}
+
+
+//Writes one line of the report for the given latencies (microseconds), which are sorted in place
+static void writeDistribution(std::ostream &out, const std::string &name, std::vector<long long> &latencies){
+
+    if(latencies.empty()){
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    long long total = 0;
+    for(std::vector<long long>::const_iterator it = latencies.cbegin(); it != latencies.cend(); it++){
+        total += *it;
+    }
+
+    unsigned long n = latencies.size();
+
+    out<<name
+       <<" count="<<n
+       <<" mean="<<(total / (long long)n)
+       <<" p50="<<latencies[(n - 1) * 50 / 100]
+       <<" p90="<<latencies[(n - 1) * 90 / 100]
+       <<" p99="<<latencies[(n - 1) * 99 / 100]
+       <<" max="<<latencies[n - 1]
+       <<" (us)"<<std::endl;
+
+}
+
+
+void LatencyProbe::writeStages(std::ostream &out, unsigned int from, unsigned int to, const std::string &suffix){
+
+    std::chrono::steady_clock::time_point unmarked;
+    std::vector<long long> latencies;
+    latencies.reserve(this->sampleCount);
+
+    //A goal missing either stage, for example one that was dropped or retracted in between, is left out
+    for(unsigned long goal = 0; goal < this->sampleCount; goal++){
+
+        const latencySample &sample = this->samples[goal];
+
+        if(sample.stageTime[from] != unmarked && sample.stageTime[to] != unmarked){
+            latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(sample.stageTime[to] - sample.stageTime[from]).count());
+        }
+    }
+
+    writeDistribution(out, std::string(stageNames[from]) + "->" + stageNames[to] + suffix, latencies);
+
+}
+
+
+void LatencyProbe::writeReport(std::ostream &out){
+
+    std::lock_guard<std::mutex> lock(this->probeMutex);
+
+    //Only the stages marked for at least one goal are reported
+    std::vector<unsigned int> stages;
+
+    for(unsigned int stage = 0; stage < LATENCY_STAGE_COUNT; stage++){
+        if(this->stageCount[stage] > 0){
+            stages.push_back(stage);
+        }
+    }
+
+    if(stages.size() < 2){
+        out<<"No complete goals were recorded"<<std::endl;
+        return;
+    }
+
+    //Latency of each stage relative to the previous marked stage
+    for(unsigned int i = 1; i < stages.size(); i++){
+        this->writeStages(out, stages[i - 1], stages[i], "");
+    }
+
+    //Latency of the whole pipeline
+    this->writeStages(out, stages.front(), stages.back(), " (end-to-end)");
+
+}
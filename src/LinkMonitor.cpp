@@ -0,0 +1,168 @@
+/**
+ * @file LinkMonitor.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the LinkMonitor class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "LinkMonitor.h"
+
+#include <math.h>
+
+
+LinkMonitor::LinkMonitor(){
+
+    this->statistics.linkUp = true;
+    this->statistics.roundTripTime = 0;
+    this->statistics.jitter = 0;
+    this->statistics.roundTripSamples = 0;
+    this->statistics.heartbeatsSent = 0;
+    this->statistics.heartbeatsSuppressed = 0;
+    this->statistics.heartbeatsLost = 0;
+    this->statistics.lossRate = 0;
+    this->statistics.framesReceived = 0;
+    this->statistics.checksumErrors = 0;
+    this->statistics.checksumErrorRate = 0;
+    this->statistics.linkDownEvents = 0;
+
+    //The link is given a whole timeout to show a sign of life
+    this->lastReceived = std::chrono::steady_clock::now();
+    this->lastHeartbeat = this->lastReceived;
+
+    this->heartbeatSequence = 0;
+    this->heartbeatOutstanding = false;
+    this->lastRoundTrip = 0;
+
+}
+
+
+void LinkMonitor::addRoundTrip(double microseconds){
+
+    //Smoothed as done by TCP (RFC 6298) for the round trip time and by RTP (RFC 3550) for the jitter
+    if(this->statistics.roundTripSamples == 0){
+        this->statistics.roundTripTime = microseconds;
+    }
+    else{
+        this->statistics.roundTripTime += (microseconds - this->statistics.roundTripTime) / 8;
+        this->statistics.jitter += (fabs(microseconds - this->lastRoundTrip) - this->statistics.jitter) / 16;
+    }
+
+    this->lastRoundTrip = microseconds;
+    this->statistics.roundTripSamples++;
+
+}
+
+
+bool LinkMonitor::frameReceived(bool checksumValid){
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->lastReceived = std::chrono::steady_clock::now();
+
+    this->statistics.framesReceived++;
+    if(!checksumValid){
+        this->statistics.checksumErrors++;
+    }
+    this->statistics.checksumErrorRate = (double)this->statistics.checksumErrors / this->statistics.framesReceived;
+
+    if(!this->statistics.linkUp){
+        this->statistics.linkUp = true;
+        return true;
+    }
+
+    return false;
+
+}
+
+
+void LinkMonitor::roundTrip(std::chrono::steady_clock::duration roundTrip){
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+    this->addRoundTrip(std::chrono::duration<double, std::micro>(roundTrip).count());
+
+}
+
+
+bool LinkMonitor::heartbeatDue(std::chrono::steady_clock::time_point now, std::chrono::steady_clock::duration interval, unsigned int &sequence, bool force){
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    if(now - this->lastHeartbeat < interval){
+        return false;
+    }
+
+    this->lastHeartbeat = now;
+
+    //Traffic received during the interval already shows the link is alive
+    if(!force && now - this->lastReceived < interval){
+        this->statistics.heartbeatsSuppressed++;
+        return false;
+    }
+
+    if(this->heartbeatOutstanding){
+        this->statistics.heartbeatsLost++;
+    }
+
+    this->heartbeatSequence++;
+    this->heartbeatOutstanding = true;
+    this->heartbeatSentTime = now;
+    this->statistics.heartbeatsSent++;
+    this->statistics.lossRate = (double)this->statistics.heartbeatsLost / this->statistics.heartbeatsSent;
+
+    sequence = this->heartbeatSequence;
+    return true;
+
+}
+
+
+bool LinkMonitor::heartbeatAnswered(unsigned int sequence, std::chrono::steady_clock::time_point &sentTime){
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    //Answers to heartbeats already counted as lost are ignored
+    if(!this->heartbeatOutstanding || sequence != this->heartbeatSequence){
+        return false;
+    }
+
+    this->heartbeatOutstanding = false;
+    this->addRoundTrip(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - this->heartbeatSentTime).count());
+
+    sentTime = this->heartbeatSentTime;
+    return true;
+
+}
+
+
+bool LinkMonitor::linkTimedOut(std::chrono::steady_clock::time_point now, std::chrono::steady_clock::duration timeout){
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    if(this->statistics.linkUp && now - this->lastReceived > timeout){
+        this->statistics.linkUp = false;
+        this->statistics.linkDownEvents++;
+        return true;
+    }
+
+    return false;
+
+}
+
+
+bool LinkMonitor::isLinkUp(){
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+    return this->statistics.linkUp;
+
+}
+
+
+linkStatistics LinkMonitor::getStatistics(){
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+    return this->statistics;
+
+}
@@ -32,6 +32,7 @@ MessagePacket::MessagePacket(std::string messageString, unsigned int messageID){
 
     this->messageID = messageID;
     this->messageString = messageString;
+    this->channel = MessagePacket::defaultChannel(messageID);
 
     //Calculate the checksum of the passed message
     this->checksum = this->calculateChecksum();
@@ -39,6 +40,29 @@ MessagePacket::MessagePacket(std::string messageString, unsigned int messageID){
 }
 
 
+MessagePacket::MessagePacket(std::string messageString, unsigned int messageID, unsigned int channel){
+
+    this->messageID = messageID;
+    this->messageString = messageString;
+    this->channel = channel;
+
+    //Calculate the checksum of the passed message
+    this->checksum = this->calculateChecksum();
+
+}
+
+
+unsigned int MessagePacket::defaultChannel(unsigned int messageID){
+
+    if(messageID == ML_UNSOLICITED_MESSAGE_ID){
+        return ML_CHANNEL_EVENTS;
+    }
+
+    return ML_CHANNEL_CONTROL;
+
+}
+
+
 MessagePacket::MessagePacket(std::string data){
     
     //Create a string to compare when parsing
@@ -55,6 +79,12 @@ MessagePacket::MessagePacket(std::string data){
     std::istringstream mID(token);
     mID >> this->messageID;
 
+    //The message ID may be followed by the channel of the message, otherwise the default channel of the ID is used
+    char separator;
+    if(!(mID >> separator) || separator != ',' || !(mID >> this->channel) || this->channel >= ML_CHANNEL_COUNT){
+        this->channel = MessagePacket::defaultChannel(this->messageID);
+    }
+
     //Now we need to get the messageString from the packet passed:
     getline(stream, token, '>'); //Discard first '>' token
     getline(stream, token, '<'); //Keep '<' token and store within messageString
@@ -89,7 +119,43 @@ bool MessagePacket::validateChecksum(){
 
 std::string MessagePacket::getFullMessage(){
 
+    //The channel is only written when it differs from the default, so frames stay readable by older embedded systems
+    std::string id = std::to_string(this->messageID);
+    if(this->channel != MessagePacket::defaultChannel(this->messageID)){
+        id += "," + std::to_string(this->channel);
+    }
+
     //Combine the attributes of the message packet to produce a string
-    return "|" + std::to_string(this->messageID) + "|>" + this->messageString + "<" + std::to_string(this->checksum) + "|";
+    return "|" + id + "|>" + this->messageString + "<" + std::to_string(this->checksum) + "|";
+
+}
+
+
+bool MessagePacket::extractFrame(std::string &buffer, std::string &frame){
+
+    //Discard anything in front of the start of the frame
+    std::string::size_type start = buffer.find('|');
+    if(start == std::string::npos){
+        buffer.clear();
+        return false;
+    }
 
-}
\ No newline at end of file
+    //A frame holds exactly three '|' characters: around the message ID, and after the checksum
+    std::string::size_type idEnd = buffer.find('|', start + 1);
+    if(idEnd == std::string::npos){
+        buffer.erase(0, start);
+        return false;
+    }
+
+    std::string::size_type end = buffer.find('|', idEnd + 1);
+    if(end == std::string::npos){
+        buffer.erase(0, start);
+        return false;
+    }
+
+    frame.assign(buffer, start, end - start + 1);
+    buffer.erase(0, end + 1);
+
+    return true;
+
+}
@@ -0,0 +1,295 @@
+/**
+ * @file SharedMemoryTransport.cpp
+ * @author Matthew Bertuzzi
+ * @brief Implementation file used to implement the SharedMemoryTransport class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "SharedMemoryTransport.h"
+
+#include <new>
+#include <thread>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+
+//The futex words are shared between processes, so the non-private futex operations are used
+static void futexWait(std::atomic<uint32_t> *word, uint32_t expected, int timeout){
+
+    struct timespec duration;
+    struct timespec *durationPointer = NULL;
+
+    if(timeout >= 0){
+        duration.tv_sec = timeout / 1000;
+        duration.tv_nsec = (long)(timeout % 1000) * 1000000L;
+        durationPointer = &duration;
+    }
+
+    //Returns straight away if the word no longer holds the expected value, so a wake-up is never missed
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT, expected, durationPointer, NULL, 0);
+
+}
+
+
+static void futexWake(std::atomic<uint32_t> *word){
+
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE, 1, NULL, NULL, 0);
+
+}
+
+
+//On a single core, spinning only delays the writer that the reader is waiting for, so the reader sleeps straight away
+static unsigned int spinCount(){
+
+    static const unsigned int count = (std::thread::hardware_concurrency() > 1) ? SHARED_MEMORY_SPIN_COUNT : 0;
+    return count;
+
+}
+
+
+SharedMemoryTransport::SharedMemoryTransport(const std::string &name, bool create){
+
+    this->link = NULL;
+    this->txRing = NULL;
+    this->rxRing = NULL;
+    this->name = name;
+    this->owner = false;
+
+    int descriptor;
+
+    if(create){
+        //A shared memory object left behind by a simulation that crashed is replaced
+        shm_unlink(name.c_str());
+        descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    else{
+        descriptor = shm_open(name.c_str(), O_RDWR, 0);
+    }
+
+    if(descriptor < 0){
+        return;
+    }
+
+    if(create && ftruncate(descriptor, sizeof(sharedLink)) < 0){
+        close(descriptor);
+        shm_unlink(name.c_str());
+        return;
+    }
+
+    void *memory = mmap(NULL, sizeof(sharedLink), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+
+    if(memory == MAP_FAILED){
+        if(create){
+            shm_unlink(name.c_str());
+        }
+        return;
+    }
+
+    sharedLink *mapped = (sharedLink *)memory;
+
+    if(create){
+
+        //The rings are built in place, and only published once they are ready
+        new (&mapped->rings[0]) sharedRing();
+        new (&mapped->rings[1]) sharedRing();
+
+        for(unsigned int i = 0; i < 2; i++){
+            mapped->rings[i].head = 0;
+            mapped->rings[i].tail = 0;
+            mapped->rings[i].dataSignal = 0;
+            mapped->rings[i].spaceSignal = 0;
+            mapped->rings[i].readerWaiting = 0;
+            mapped->rings[i].writerWaiting = 0;
+        }
+
+        mapped->version = SHARED_MEMORY_VERSION;
+        std::atomic_thread_fence(std::memory_order_release);
+        mapped->magic = SHARED_MEMORY_MAGIC;
+
+        this->owner = true;
+    }
+    else if(mapped->magic != SHARED_MEMORY_MAGIC || mapped->version != SHARED_MEMORY_VERSION){
+        munmap(memory, sizeof(sharedLink));
+        return;
+    }
+
+    this->link = mapped;
+
+    //The HMI writes ring 0 and reads ring 1, the simulation does the opposite
+    this->txRing = &mapped->rings[create ? 1 : 0];
+    this->rxRing = &mapped->rings[create ? 0 : 1];
+
+}
+
+
+SharedMemoryTransport::~SharedMemoryTransport(){
+
+    if(this->link != NULL){
+        munmap(this->link, sizeof(sharedLink));
+    }
+
+    if(this->owner){
+        shm_unlink(this->name.c_str());
+    }
+
+}
+
+
+bool SharedMemoryTransport::send(const std::string &frame){
+
+    if(this->link == NULL){
+        return false;
+    }
+
+    sharedRing *ring = this->txRing;
+    const char *data = frame.c_str();
+    uint32_t remaining = (uint32_t)frame.length();
+
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+
+    while(remaining > 0){
+
+        uint32_t space = SHARED_MEMORY_RING_SIZE - (head - ring->tail.load(std::memory_order_acquire));
+
+        if(space == 0){
+
+            //The ring is full, so sleep until the reader frees some space
+            uint32_t signal = ring->spaceSignal.load(std::memory_order_seq_cst);
+            ring->writerWaiting.store(1, std::memory_order_seq_cst);
+
+            if(head - ring->tail.load(std::memory_order_seq_cst) == SHARED_MEMORY_RING_SIZE){
+                futexWait(&ring->spaceSignal, signal, -1);
+            }
+
+            ring->writerWaiting.store(0, std::memory_order_relaxed);
+            continue;
+        }
+
+        //Copy as much as fits, in two parts if the free space wraps around the end of the ring
+        uint32_t count = (remaining < space) ? remaining : space;
+        uint32_t offset = head & (SHARED_MEMORY_RING_SIZE - 1);
+        uint32_t firstPart = (count < SHARED_MEMORY_RING_SIZE - offset) ? count : SHARED_MEMORY_RING_SIZE - offset;
+
+        memcpy(ring->data + offset, data, firstPart);
+        memcpy(ring->data, data + firstPart, count - firstPart);
+
+        head += count;
+        data += count;
+        remaining -= count;
+
+        ring->head.store(head, std::memory_order_release);
+
+        //Only wake the reader with a system call if it is actually sleeping. This is done for every part written, as a
+        //frame larger than the free space can only be finished once the reader has made room
+        ring->dataSignal.fetch_add(1, std::memory_order_seq_cst);
+        if(ring->readerWaiting.load(std::memory_order_seq_cst)){
+            futexWake(&ring->dataSignal);
+        }
+    }
+
+    return true;
+
+}
+
+
+bool SharedMemoryTransport::waitForData(int timeout){
+
+    sharedRing *ring = this->rxRing;
+    uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+
+    //A reply usually arrives within a few microseconds, so the ring is checked for a short while before paying for a sleep
+    //and a wake-up in the kernel
+    unsigned int spins = spinCount();
+    for(unsigned int i = 0; i < spins; i++){
+        if(ring->head.load(std::memory_order_acquire) != tail){
+            return true;
+        }
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while(ring->head.load(std::memory_order_acquire) == tail){
+
+        int remaining = timeout;
+
+        if(timeout >= 0){
+
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+
+            int elapsed = (int)((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000);
+            if(elapsed >= timeout){
+                return false;
+            }
+
+            remaining = timeout - elapsed;
+        }
+
+        uint32_t signal = ring->dataSignal.load(std::memory_order_seq_cst);
+        ring->readerWaiting.store(1, std::memory_order_seq_cst);
+
+        if(ring->head.load(std::memory_order_seq_cst) == tail){
+            futexWait(&ring->dataSignal, signal, remaining);
+        }
+
+        ring->readerWaiting.store(0, std::memory_order_relaxed);
+    }
+
+    return true;
+
+}
+
+
+int SharedMemoryTransport::receive(char *buffer, unsigned int length){
+
+    if(this->link == NULL){
+        return -1;
+    }
+
+    this->waitForData(-1);
+
+    sharedRing *ring = this->rxRing;
+    uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint32_t available = ring->head.load(std::memory_order_acquire) - tail;
+
+    uint32_t count = (available < length) ? available : length;
+    uint32_t offset = tail & (SHARED_MEMORY_RING_SIZE - 1);
+    uint32_t firstPart = (count < SHARED_MEMORY_RING_SIZE - offset) ? count : SHARED_MEMORY_RING_SIZE - offset;
+
+    memcpy(buffer, ring->data + offset, firstPart);
+    memcpy(buffer + firstPart, ring->data, count - firstPart);
+
+    ring->tail.store(tail + count, std::memory_order_release);
+
+    //Only wake the writer with a system call if it is actually sleeping on a full ring
+    ring->spaceSignal.fetch_add(1, std::memory_order_seq_cst);
+    if(ring->writerWaiting.load(std::memory_order_seq_cst)){
+        futexWake(&ring->spaceSignal);
+    }
+
+    return (int)count;
+
+}
+
+
+int SharedMemoryTransport::waitReadable(int timeout){
+
+    if(this->link == NULL){
+        return -1;
+    }
+
+    return this->waitForData(timeout) ? 1 : 0;
+
+}
@@ -0,0 +1,159 @@
+/**
+ * @file commsreplay.cpp
+ * @author Matthew Bertuzzi
+ * @brief This file is responsible for checking that a capture started in the middle of a session can be replayed
+ *
+ * A session is first played against the simulated embedded system in a child process: a few requests are sent before the
+ * capture is started, so the recorded message IDs do not start at zero, then the table settings are set and read back and a
+ * short game is played while the traffic is captured. The capture is then replayed in place of the simulation (see
+ * \ref ReplayTransport.h), and the same requests must get their recorded answers, with every sent frame matching the capture.
+ *
+ * Each part runs in its own process, as the link of the MessageHandler is chosen when its Singleton is created.
+ *
+ * The check is built with CommsReplay.pro and is run as:
+ *
+ * ./CommsReplay [CAPTURE_FILE] [REQUESTS_BEFORE_CAPTURE]
+ *
+ * It exits with 0 if the checks pass, and 1 otherwise.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "MessageHandler.h"
+#include "MessageLibrary.h"
+#include "ReplayTransport.h"
+
+
+#define REPLAY_CHECK_AIR_SPEEDS 5                           //!< Number of air speeds set during the captured session
+#define REPLAY_CHECK_GOALS 5                                //!< Number of goals read during the captured session
+
+
+//Play the part of the session that is the same whether it is captured or replayed, returning the number of failed requests
+static int playSession(MessageHandler &handler, bool verbose){
+
+    int failures = 0;
+
+    //Set the air speed a few times, then read the last one back
+    for(int i = 0; i < REPLAY_CHECK_AIR_SPEEDS; i++){
+        std::vector<int> returnVal = handler.sendMessage(M_RPI_SET_TABLE_AIR_SPEED, std::to_string(10 + i));
+        if(returnVal[0] < 0) failures++;
+    }
+
+    std::vector<int> returnVal = handler.sendMessage(M_RPI_GET_TABLE_AIR_SPEED);
+    if(returnVal[0] < 0 || returnVal.size() < 2 || returnVal[1] != 10 + REPLAY_CHECK_AIR_SPEEDS - 1){
+        failures++;
+    }
+
+    //Play a short game, the goals are unsolicited
+    if(handler.sendMessage(M_RPI_SET_GAME_ACTIVE_STATE, TO_STRING(ML_ACTIVE))[0] < 0) failures++;
+
+    int goals = 0;
+    for(int attempt = 0; goals < REPLAY_CHECK_GOALS && attempt < 5000; attempt++){
+        if(handler.unsolicitedQueueGet()[0] < 0) usleep(1000);
+        else goals++;
+    }
+    if(goals < REPLAY_CHECK_GOALS) failures++;
+
+    if(handler.sendMessage(M_RPI_SET_GAME_ACTIVE_STATE, TO_STRING(ML_INACTIVE))[0] < 0) failures++;
+
+    if(verbose){
+        std::cout<<"Goals read: "<<goals<<std::endl;
+    }
+
+    return failures;
+
+}
+
+
+//Capture the session against the simulation, after some requests were sent without capturing them
+static int captureSession(const std::string &fileName, int requestsBefore){
+
+    MessageHandler::setSimulatedGoalDelay(5, 10);
+    MessageHandler &handler = MessageHandler::instance();
+
+    for(int i = 0; i < requestsBefore; i++){
+        handler.sendMessage(M_RPI_GET_TABLE_MODE);
+    }
+
+    if(!handler.startCapture(fileName)){
+        std::cout<<"ERROR> Could not create capture file "<<fileName<<std::endl;
+        return 1;
+    }
+
+    int failures = playSession(handler, false);
+    handler.stopCapture();
+
+    if(failures > 0){
+        std::cout<<"ERROR> "<<failures<<" requests failed while capturing"<<std::endl;
+    }
+
+    return (failures > 0) ? 1 : 0;
+
+}
+
+
+int main(int argc, char *argv[]){
+
+    //Read the capture file to use and the number of requests sent before the capture starts
+    std::string fileName = (argc > 1) ? argv[1] : "/tmp/commsreplay.cap";
+    int requestsBefore = (argc > 2) ? atoi(argv[2]) : 7;
+
+    //Capture the session in a child process, with a MessageHandler of its own talking to the simulation
+    pid_t child = fork();
+    if(child < 0){
+        std::cout<<"ERROR> Could not start the captured session"<<std::endl;
+        return 1;
+    }
+
+    if(child == 0){
+        //The threads of the MessageHandler never stop, so the child does not wait for them
+        std::cout.flush();
+        _exit(captureSession(fileName, requestsBefore));
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0){
+        std::cout<<"ERROR> The session could not be captured"<<std::endl;
+        return 1;
+    }
+
+    std::cout<<"Captured "<<fileName<<" after "<<requestsBefore<<" requests"<<std::endl;
+
+    //Replay the capture as fast as the requests are sent, a missing answer fails quickly
+    MessageHandler::setResponseTimeout(500);
+    MessageHandler::setReplaySource(fileName, CAPTURE_REPLAY_MAX_SPEED);
+    MessageHandler &handler = MessageHandler::instance();
+
+    if(!handler.isReplaying()){
+        std::cout<<"ERROR> Could not replay "<<fileName<<std::endl;
+        return 1;
+    }
+
+    int failures = playSession(handler, true);
+    replayStatistics statistics = handler.getReplayStatistics();
+
+    std::cout<<"Failed requests: "<<failures<<std::endl;
+    std::cout<<"Frames replayed: "<<statistics.framesReplayed<<std::endl;
+    std::cout<<"Frames matched: "<<statistics.framesMatched<<std::endl;
+    std::cout<<"Frames mismatched: "<<statistics.framesMismatched<<std::endl;
+    std::cout<<"Frames unexpected: "<<statistics.framesUnexpected<<std::endl;
+
+    bool passed = failures == 0 && statistics.finished && statistics.framesMismatched == 0 && statistics.framesUnexpected == 0;
+    std::cout<<(passed ? "PASSED" : "FAILED")<<std::endl;
+
+    //The threads of the MessageHandler never stop, so the process does not wait for them
+    std::cout.flush();
+    _exit(passed ? 0 : 1);
+
+}
@@ -0,0 +1,102 @@
+/**
+ * @file embeddedsim.cpp
+ * @author Matthew Bertuzzi
+ * @brief This file is responsible for running the embedded system simulation as its own process, so that the HMI talks to
+ * it over a real IPC link rather than the pipes of the simulation thread. A crash of the simulation can then no longer take
+ * down the GUI, and the HMI process can be benchmarked on its own.
+ *
+ * The simulation is built with EmbeddedSim.pro, started first, and then selected in the HMI with
+ * \ref MessageHandler::setSimulatorAddress (or the CAREHOCKEY_SIMULATOR environment variable of the HMI). It is run as:
+ *
+ * ./EmbeddedSim shm:NAME|unix:PATH [MIN_GOAL_DELAY_MS] [MAX_GOAL_DELAY_MS] [TELEMETRY_PERIOD_MS]
+ *
+ * shm:NAME => Shared memory rings (see \ref SharedMemoryTransport.h), the fastest link, for a single HMI run
+ * unix:PATH => Unix socket, a new HMI can connect each time the previous one disconnects
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/socket.h>
+
+#include "EmbeddedSimulator.h"
+#include "MessageTransport.h"
+#include "SharedMemoryTransport.h"
+
+
+int main(int argc, char *argv[]){
+
+    if(argc < 2){
+        std::cerr<<"Usage: "<<argv[0]<<" shm:NAME|unix:PATH [MIN_GOAL_DELAY_MS] [MAX_GOAL_DELAY_MS] [TELEMETRY_PERIOD_MS]"<<std::endl;
+        return 1;
+    }
+
+    std::string address = argv[1];
+    unsigned int minGoalDelay = (argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 10) : 1000;
+    unsigned int maxGoalDelay = (argc > 3) ? (unsigned int)strtoul(argv[3], NULL, 10) : 5000;
+    unsigned int telemetryPeriod = (argc > 4) ? (unsigned int)strtoul(argv[4], NULL, 10) : 0;
+
+    //Seed RNG for determining when a goal has been scored:
+    srand(time(NULL));
+
+    if(address.compare(0, 4, "shm:") == 0){
+
+        SharedMemoryTransport link(address.substr(4), true);
+
+        if(!link.isOpen()){
+            std::cerr<<"ERROR> Could not create the shared memory "<<address.substr(4)<<std::endl;
+            return 1;
+        }
+
+        std::cerr<<"Simulating the embedded system on "<<address<<std::endl;
+
+        //The shared memory cannot tell when the HMI goes away, so a single session is simulated until the process is stopped
+        EmbeddedSimulator simulator;
+        simulator.setGoalDelay(minGoalDelay, maxGoalDelay);
+        simulator.setTelemetryPeriod(telemetryPeriod);
+
+        simulator.run(link);
+        return 0;
+    }
+    else if(address.compare(0, 5, "unix:") == 0){
+
+        int listenDescriptor = SocketTransport::listenOn(address.substr(5));
+
+        if(listenDescriptor < 0){
+            std::cerr<<"ERROR> Could not listen on "<<address.substr(5)<<std::endl;
+            return 1;
+        }
+
+        std::cerr<<"Simulating the embedded system on "<<address<<std::endl;
+
+        while(1){
+
+            int descriptor = accept(listenDescriptor, NULL, NULL);
+            if(descriptor < 0){
+                continue;
+            }
+
+            //Every HMI session starts with the table in its power-on state
+            SocketTransport link(descriptor);
+
+            EmbeddedSimulator simulator;
+            simulator.setGoalDelay(minGoalDelay, maxGoalDelay);
+            simulator.setTelemetryPeriod(telemetryPeriod);
+
+            simulator.run(link);
+
+            std::cerr<<"HMI disconnected, waiting for the next connection"<<std::endl;
+        }
+    }
+
+    std::cerr<<"ERROR> Unknown address "<<address<<", expected shm:NAME or unix:PATH"<<std::endl;
+    return 1;
+
+}
@@ -2,8 +2,8 @@
  * @file gamedisplay.cpp
  * @author Sanjayan Kulendran
  * @brief Implementation file used to Implement the qt5 based gameDisplay class.
- * @version 1.1
- * @date 2020-11-30
+ * @version 1.6
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -42,11 +42,8 @@ gameDisplay::gameDisplay(std::vector<game> &gameReturnPointer, QWidget *parent,
     //If the game victory type integer is 0, the game finishes on score (consider changing this for consistency)
     if (matchSettingsObjPtr->getGameVictoryType() == 0){
 
-        //Create a new score based game
-        currentGame = new game(true, matchSettingsObjPtr->getScoreThreshold());
-
-        //Initizalize the game timer to zero (in score based we are going up)
-        gameTime = 0;
+        //Create a new score based game (in score based the game clock is shown going up)
+        currentGame.reset(new game(true, matchSettingsObjPtr->getScoreThreshold()));
 
         //Set the game display to reflect that it is score-threshold based
         ui->timerLabel->setText("Time Elapsed");
@@ -59,11 +56,8 @@ gameDisplay::gameDisplay(std::vector<game> &gameReturnPointer, QWidget *parent,
     //Otherwise, the game finishes on a timer
     else{
 
-        //Create a timer based game (kept true while game objects are finalized)
-        currentGame = new game(false, matchSettingsObjPtr->getGameTimeLimit());
-
-        //Initialize the game timer to the time limit
-        gameTime = 60*(static_cast<int>(matchSettingsObjPtr->getGameTimeLimit()));
+        //Create a timer based game, the time limit of the match settings is in minutes (the game clock is shown going down)
+        currentGame.reset(new game(false, 60*matchSettingsObjPtr->getGameTimeLimit()));
 
         //Hide goals to victory
         ui->pointGoalNumber->hide();
@@ -95,11 +89,23 @@ gameDisplay::gameDisplay(std::vector<game> &gameReturnPointer, QWidget *parent,
     //Start the timer with the poll interval value
     messagePollTimer->start(messagePollInterval);
 
+    //Setup the timer ending the game, it fires once with millisecond accuracy rather than on the display updates
+    gameEndTimer = new QTimer(this);
+    gameEndTimer->setSingleShot(true);
+    gameEndTimer->setTimerType(Qt::PreciseTimer);
+
+    //Setup the connection between the timer and the game end function
+    connect(gameEndTimer, SIGNAL(timeout()), this, SLOT(gameTimeExpired()));
+
     //Game is unpaused
     gamePaused = false;
 
-    //Send signal to start the table emulator
-    MessageHandler::instance().sendMessage(M_RPI_SET_GAME_ACTIVE_STATE, TO_STRING(ML_ACTIVE));
+    //Drop any goal the table sent for the game before, before it was made inactive
+    tableActive = false;
+    MessageHandler::instance().unsolicitedQueueClear();
+
+    //Send signal to start the table emulator, and start the game clock (and the end of the game if it has a time limit)
+    startTable();
 
 
 }
@@ -110,22 +116,21 @@ void gameDisplay::displayUpdate(){
     //If the game is not finished or paused
     if ((currentGame->isGameFinished() != true ) && (!gamePaused)){
 
+        //Second count shown on the clock
+        unsigned long gameTime;
+
         //If the game finishes on score
         if (currentGame->getDoesGameFinishOnScore()){
 
-            //Increment the timer by the display update interval value
-            gameTime = gameTime + displayUpdateInterval/1000;
+            //Show the elapsed game time, in whole seconds
+            gameTime = currentGame->getElapsedTime()/1000;
 
         }
         //Otherwise, if the game finishes on a timer
         else{
 
-            //Decrement the timer by the display update interval value ( minimum value of 0)
-            if (0 > ( gameTime - displayUpdateInterval/1000)) gameTime = 0;
-            else gameTime -= displayUpdateInterval/1000;
-
-            //If the game time has dipped below/is zero then end the game
-            if(static_cast<int>(gameTime) == 0) currentGame->endGame();
+            //Show the remaining game time, rounded up so that zero is only shown once the time is over
+            gameTime = (currentGame->getRemainingTime() + 999)/1000;
 
         }
 
@@ -141,6 +146,12 @@ void gameDisplay::displayUpdate(){
         ui->pAlcdNumber->display(static_cast<int>(currentGame->getPlayerAScore()));
         ui->pBlcdNumber->display(static_cast<int>(currentGame->getPlayerBScore()));
 
+        //Mark the goals shown for latency measurements
+        markDisplayedGoals();
+
+        //Update the live statistics
+        showStatistics();
+
     }
 
     //Otherwise, If the game is finished
@@ -150,6 +161,12 @@ void gameDisplay::displayUpdate(){
         ui->pAlcdNumber->display(static_cast<int>(currentGame->getPlayerAScore()));
         ui->pBlcdNumber->display(static_cast<int>(currentGame->getPlayerBScore()));
 
+        //Mark the goals shown for latency measurements
+        markDisplayedGoals();
+
+        //Show the final statistics
+        showStatistics();
+
         //If player A had the higher score
         if( currentGame->getPlayerAScore() > currentGame->getPlayerBScore()){
 
@@ -201,24 +218,130 @@ void gameDisplay::displayUpdate(){
 }
 
 
+void gameDisplay::gameTimeExpired(){
+
+    //The timer may fire slightly early, in which case it is started again for the time left
+    if (currentGame->isGameFinished() || gamePaused) return;
+
+    if (currentGame->getRemainingTime() > 0){
+        scheduleGameEnd();
+        return;
+    }
+
+    //The time is over, end the game and stop the table sending goals
+    currentGame->endGame();
+    stopTable();
+
+    //Show the result straight away rather than on the next display update
+    displayUpdate();
+
+}
+
+
+void gameDisplay::startTable(){
+
+    //Make the game active on the table
+    std::vector<int> returnVal = MessageHandler::instance().sendMessage(M_RPI_SET_GAME_ACTIVE_STATE, TO_STRING(ML_ACTIVE));
+    tableActive = true;
+
+    //If the table answered with its board time, the goals it stamps are placed on the game clock from there
+    if (!(returnVal[0] < 0) && (returnVal.size() > 1)) currentGame->startGame(static_cast<unsigned long>(returnVal[1]));
+    else currentGame->startGame();
+
+    scheduleGameEnd();
+
+}
+
+
+void gameDisplay::stopTable(){
+
+    //Only tell the table once, whichever of pause, end of game or exit comes first
+    if (!tableActive) return;
+
+    //Make the game inactive on the table
+    MessageHandler::instance().sendMessage(M_RPI_SET_GAME_ACTIVE_STATE, TO_STRING(ML_INACTIVE));
+    tableActive = false;
+
+}
+
+
+void gameDisplay::scheduleGameEnd(){
+
+    //Only games finishing on a timer have an end to schedule
+    if (currentGame->getDoesGameFinishOnScore()) return;
+
+    gameEndTimer->start(static_cast<int>(currentGame->getRemainingTime()));
+
+}
+
+
+void gameDisplay::showStatistics(){
+
+    unsigned long gameTime = currentGame->getElapsedTime();
+
+    livePlayerStatistics playerAStatistics = statistics.getPlayerAStatistics(gameTime);
+    livePlayerStatistics playerBStatistics = statistics.getPlayerBStatistics(gameTime);
+
+    //Show the goals per minute, the median and 90th percentile speeds, and the momentum of each player
+    QString statisticsFormat("Goals/min: %1\nSpeed median: %2  p90: %3\nMomentum: %4%");
+
+    ui->pAStatisticsLabel->setText(statisticsFormat.arg(playerAStatistics.goalsPerMinute, 0, 'f', 1)
+                                   .arg(playerAStatistics.medianSpeed, 0, 'f', 0)
+                                   .arg(playerAStatistics.p90Speed, 0, 'f', 0)
+                                   .arg(playerAStatistics.momentum, 0, 'f', 0));
+    ui->pBStatisticsLabel->setText(statisticsFormat.arg(playerBStatistics.goalsPerMinute, 0, 'f', 1)
+                                   .arg(playerBStatistics.medianSpeed, 0, 'f', 0)
+                                   .arg(playerBStatistics.p90Speed, 0, 'f', 0)
+                                   .arg(playerBStatistics.momentum, 0, 'f', 0));
+
+}
+
+
+void gameDisplay::markDisplayedGoals(){
+
+    //Mark every goal shown for the first time by this update, by the board time that names it
+    for (unsigned long goalTimestamp : undisplayedGoals){
+        LatencyProbe::instance().mark(LATENCY_STAGE_DISPLAYED, goalTimestamp);
+    }
+
+    undisplayedGoals.clear();
+
+}
+
+
 void gameDisplay::updateScore(){
 
-    //If the game is not finished, or paused
-    if ((currentGame->isGameFinished() != true ) && (!gamePaused)){
+    //Take every goal waiting while the game is not finished, or paused
+    while ((currentGame->isGameFinished() != true ) && (!gamePaused)){
 
         //Check to see if goal is scored (through communication singleton table emulator)
         std::vector<int> returnVal = MessageHandler::instance().unsolicitedQueueGet();
 
-        //If there is something to read
+        //Stop once there is nothing left to read
+        if (returnVal[0] == -1) break;
+
+        //If the message read is a goal
         if(!(returnVal[0] < 0)){
 
-            //Assign the relevant goal to the game
-            currentGame->addGoal(returnVal[2], static_cast<bool>(returnVal[1]));
+            //Assign the relevant goal to the game, at the time the table saw it if the goal is stamped with the board time
+            if (returnVal.size() > 3){
+                currentGame->addGoal(returnVal[2], static_cast<bool>(returnVal[1]), static_cast<unsigned long>(returnVal[3]));
+
+                //Remember the goal until the score is shown, for latency measurements
+                if (LatencyProbe::instance().isEnabled()) undisplayedGoals.push_back(static_cast<unsigned long>(returnVal[3]));
+            }
+            else currentGame->addGoal(returnVal[2], static_cast<bool>(returnVal[1]));
+
+            //Fold the goal into the live statistics, at the game time it was given
+            statistics.addGoal(currentGame->getGoalTimes()[currentGame->getGoalCount() - 1], returnVal[2], static_cast<bool>(returnVal[1]));
 
             //Assign this speed to the respective speed meter
             if (returnVal[1]) ui->pASpeedlcdNumber->display(static_cast<int>(returnVal[2]));
             else ui->pBSpeedlcdNumber->display(static_cast<int>(returnVal[2]));
 
+            //If this goal won the game, stop the table sending goals nobody reads
+            if (currentGame->isGameFinished()) stopTable();
+
         }
 
     }
@@ -240,8 +363,12 @@ void gameDisplay::on_playPausepushButton_clicked(bool checked)
     //Name the button accordingly
     if (gamePaused){
 
+        //Pause the game clock, and the end of the game with it
+        currentGame->pauseGame();
+        gameEndTimer->stop();
+
         //Pause the table emulator
-        MessageHandler::instance().sendMessage(M_RPI_SET_GAME_ACTIVE_STATE, TO_STRING(ML_INACTIVE));
+        stopTable();
 
         ui->playPausepushButton->setText("Resume");
         //Colour the exit button
@@ -251,8 +378,8 @@ void gameDisplay::on_playPausepushButton_clicked(bool checked)
 
     else {
 
-        //Restart the table emulator
-        MessageHandler::instance().sendMessage(M_RPI_SET_GAME_ACTIVE_STATE, TO_STRING(ML_ACTIVE));
+        //Restart the table emulator, resume the game clock, and schedule the end of the game for the time that was left
+        startTable();
 
         //Colour the exit button
         ui->playPausepushButton->setStyleSheet("background-color:yellow");
@@ -264,18 +391,25 @@ void gameDisplay::on_playPausepushButton_clicked(bool checked)
 void gameDisplay::on_exitButton_clicked()
 {
 
-    //Stop the table emulator
-    MessageHandler::instance().sendMessage(M_RPI_SET_GAME_ACTIVE_STATE, TO_STRING(ML_INACTIVE));
+    //Stop the table emulator, if the game was not already over
+    stopTable();
 
     //Delete the timers
     delete gameTimeUpdater;
     delete messagePollTimer;
+    delete gameEndTimer;
+
+    //Stop the game clock, so that the game keeps the time it was played for
+    currentGame->pauseGame();
+
+    //The game is moved out below, so check whether it was concluded first
+    bool gameFinished = currentGame->isGameFinished();
 
-    //Push the game onto the vector
-    gameVector->push_back(*currentGame);
+    //Move the game onto the vector, its goals and events are not copied
+    gameVector->push_back(std::move(*currentGame));
 
     //If the game was concluded before close was pressed, exit the game display with an accept
-    if (currentGame->isGameFinished()) gameDisplay::accept();
+    if (gameFinished) gameDisplay::accept();
 
     //Otherwise, end the game with a reject
     else gameDisplay::reject();
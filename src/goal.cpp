@@ -3,8 +3,8 @@
  * @author Sanjayan Kulendran
  * @brief Implementation file used to implement the Goal class.
  *
- * @version 1.0
- * @date 2020-11-30
+ * @version 1.1
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
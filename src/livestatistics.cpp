@@ -0,0 +1,338 @@
+/**
+ * @file livestatistics.cpp
+ * @author Sanjayan Kulendran
+ * @brief Implementation file used to implement the liveStatistics class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "livestatistics.h"
+
+#include<algorithm>  //Sorting the buffered speeds
+#include<cmath>  //Scale function of the sketch and decay of the momentum
+
+#define LIVE_STATISTICS_BUCKET_LENGTH (LIVE_STATISTICS_WINDOW/LIVE_STATISTICS_BUCKETS) //!< Game time covered by one bucket [ms]
+
+static const double pi = 3.14159265358979323846;
+
+//Function that returns the weight up to which a centroid starting after weightSoFar may grow: the centroid may span one unit of
+//the scale function k(q) = d/(2 pi) asin(2q - 1), which allows large centroids near the median and small centroids in the tails
+static double sketchWeightLimit(double weightSoFar, double totalWeight){
+
+    double scale = SPEED_SKETCH_COMPRESSION/(2*pi);
+    double k = scale*std::asin(2*(weightSoFar/totalWeight) - 1) + 1;
+
+    //Past the end of the scale, the centroid may take every remaining speed
+    if(k >= scale*pi/2) return totalWeight;
+
+    return totalWeight*(std::sin(k/scale) + 1)/2;
+
+}
+
+//Counter constructor, no goals counted yet
+goalRateCounter::goalRateCounter()
+{
+    for(unsigned i = 0; i < LIVE_STATISTICS_BUCKETS; i++) buckets[i] = 0;
+
+    currentBucket = 0;
+    windowCount = 0;
+    currentTime = 0;
+}
+
+
+//Function that moves the window on to a game time
+void goalRateCounter::advance(unsigned long time){
+
+    //The window never moves back
+    if(time <= currentTime) return;
+    currentTime = time;
+
+    unsigned long bucket = time/LIVE_STATISTICS_BUCKET_LENGTH;
+    if(bucket <= currentBucket) return;
+
+    //Empty the buckets that leave the window, at most the whole window
+    unsigned long steps = bucket - currentBucket;
+    if(steps > LIVE_STATISTICS_BUCKETS) steps = LIVE_STATISTICS_BUCKETS;
+
+    for(unsigned long i = 1; i <= steps; i++){
+        unsigned long index = (currentBucket + i) % LIVE_STATISTICS_BUCKETS;
+        windowCount -= buckets[index];
+        buckets[index] = 0;
+    }
+
+    currentBucket = bucket;
+
+}
+
+
+//Function to count a goal
+void goalRateCounter::addGoal(unsigned long time){
+
+    advance(time);
+
+    //A goal stamped by the board may be a little older than the latest time seen, it is counted unless it has left the window
+    unsigned long bucket = time/LIVE_STATISTICS_BUCKET_LENGTH;
+    if(bucket + LIVE_STATISTICS_BUCKETS <= currentBucket) return;
+
+    buckets[bucket % LIVE_STATISTICS_BUCKETS]++;
+    windowCount++;
+
+}
+
+
+//Function that returns the goals per minute over the window
+double goalRateCounter::getGoalsPerMinute(unsigned long time){
+
+    advance(time);
+
+    //The window starts at the oldest bucket kept, or at the start of the game
+    unsigned long windowStart = 0;
+    if(currentBucket >= LIVE_STATISTICS_BUCKETS - 1) windowStart = (currentBucket - (LIVE_STATISTICS_BUCKETS - 1))*LIVE_STATISTICS_BUCKET_LENGTH;
+
+    //Right after the start of the game, the rate is taken over at least one bucket so that a single goal does not look like a flood
+    unsigned long windowLength = currentTime - windowStart;
+    if(windowLength < LIVE_STATISTICS_BUCKET_LENGTH) windowLength = LIVE_STATISTICS_BUCKET_LENGTH;
+
+    return windowCount*60000.0/windowLength;
+
+}
+
+
+//Sketch constructor, the sketch starts empty
+speedSketch::speedSketch()
+{
+    centroidCount = 0;
+    bufferCount = 0;
+    totalWeight = 0;
+    minimum = 0;
+    maximum = 0;
+}
+
+
+//Function to add a speed to the sketch
+void speedSketch::add(double speed){
+
+    //Keep the range of the speeds, the smallest and largest quantiles are interpolated towards them
+    if((totalWeight == 0) || (speed < minimum)) minimum = speed;
+    if((totalWeight == 0) || (speed > maximum)) maximum = speed;
+
+    buffer[bufferCount++] = speed;
+    totalWeight++;
+
+    //Merge the buffer once it is full
+    if(bufferCount == SPEED_SKETCH_BUFFER) merge();
+
+}
+
+
+//Function that merges the buffered speeds into the centroids
+void speedSketch::merge(){
+
+    if(bufferCount == 0) return;
+
+    std::sort(buffer, buffer + bufferCount);
+
+    //Merge the sorted speeds and centroids into one sorted list
+    double means[SPEED_SKETCH_COMPRESSION + 2*SPEED_SKETCH_BUFFER];
+    double weights[SPEED_SKETCH_COMPRESSION + 2*SPEED_SKETCH_BUFFER];
+    unsigned count = 0;
+    unsigned centroid = 0;
+    unsigned buffered = 0;
+
+    while((centroid < centroidCount) || (buffered < bufferCount)){
+
+        if((buffered == bufferCount) || ((centroid < centroidCount) && (centroidMeans[centroid] <= buffer[buffered]))){
+            means[count] = centroidMeans[centroid];
+            weights[count] = centroidWeights[centroid];
+            centroid++;
+        }
+        else{
+            means[count] = buffer[buffered];
+            weights[count] = 1;
+            buffered++;
+        }
+
+        count++;
+    }
+
+    bufferCount = 0;
+
+    //Join neighbouring centroids while the joined centroid stays within its weight limit
+    double weightSoFar = 0;
+    double weightLimit = sketchWeightLimit(0, totalWeight);
+
+    centroidMeans[0] = means[0];
+    centroidWeights[0] = weights[0];
+    centroidCount = 1;
+
+    for(unsigned i = 1; i < count; i++){
+
+        double &currentMean = centroidMeans[centroidCount - 1];
+        double &currentWeight = centroidWeights[centroidCount - 1];
+
+        if(weightSoFar + currentWeight + weights[i] <= weightLimit){
+
+            //Join the next centroid into the current one
+            currentWeight += weights[i];
+            currentMean += (means[i] - currentMean)*weights[i]/currentWeight;
+
+        }
+        else{
+
+            //Start a new centroid
+            weightSoFar += currentWeight;
+            weightLimit = sketchWeightLimit(weightSoFar, totalWeight);
+            centroidMeans[centroidCount] = means[i];
+            centroidWeights[centroidCount] = weights[i];
+            centroidCount++;
+
+        }
+    }
+
+}
+
+
+//Function that estimates a quantile of the speeds
+double speedSketch::quantile(double fraction){
+
+    merge();
+
+    if(centroidCount == 0) return 0;
+    if(centroidCount == 1) return centroidMeans[0];
+
+    if(fraction < 0) fraction = 0;
+    if(fraction > 1) fraction = 1;
+
+    //Each centroid stands for its speeds spread around its mean, so the quantile is interpolated between the centres of the centroids
+    double index = fraction*totalWeight;
+    double centre = centroidWeights[0]/2;
+
+    //Before the first centre, interpolate from the smallest speed
+    if(index < centre) return minimum + (centroidMeans[0] - minimum)*index/centre;
+
+    for(unsigned i = 0; i + 1 < centroidCount; i++){
+
+        double nextCentre = centre + (centroidWeights[i] + centroidWeights[i + 1])/2;
+
+        if(index <= nextCentre) return centroidMeans[i] + (centroidMeans[i + 1] - centroidMeans[i])*(index - centre)/(nextCentre - centre);
+
+        centre = nextCentre;
+    }
+
+    //After the last centre, interpolate to the largest speed
+    double lastMean = centroidMeans[centroidCount - 1];
+    double lastHalfWeight = centroidWeights[centroidCount - 1]/2;
+
+    return lastMean + (maximum - lastMean)*std::min(1.0, (index - centre)/lastHalfWeight);
+
+}
+
+
+//Function that returns the number of speeds in the sketch
+unsigned long speedSketch::getCount(){
+
+    return static_cast<unsigned long>(totalWeight);
+
+}
+
+
+//Statistics constructor, no goals yet
+liveStatistics::liveStatistics()
+{
+    playerAMomentum = 0;
+    playerBMomentum = 0;
+    momentumTime = 0;
+}
+
+
+//Function that brings the momentum up to a game time
+void liveStatistics::decayMomentum(unsigned long time){
+
+    if(time <= momentumTime) return;
+
+    //The momentum halves every half life
+    double decay = std::pow(0.5, static_cast<double>(time - momentumTime)/LIVE_STATISTICS_MOMENTUM_HALF_LIFE);
+    playerAMomentum *= decay;
+    playerBMomentum *= decay;
+    momentumTime = time;
+
+}
+
+
+//Function to fold a goal into the statistics
+void liveStatistics::addGoal(unsigned long time, int speed, bool onBSide){
+
+    decayMomentum(time);
+
+    //A goal older than the momentum time has already decayed a little
+    double momentum = 1;
+    if(time < momentumTime) momentum = std::pow(0.5, static_cast<double>(momentumTime - time)/LIVE_STATISTICS_MOMENTUM_HALF_LIFE);
+
+    //Goals on B side are scored by player A
+    if(onBSide){
+        playerAGoalRate.addGoal(time);
+        playerASpeeds.add(speed);
+        playerAMomentum += momentum;
+    }
+    else{
+        playerBGoalRate.addGoal(time);
+        playerBSpeeds.add(speed);
+        playerBMomentum += momentum;
+    }
+
+}
+
+
+//Function to fold every goal of a game into the statistics
+void liveStatistics::addGame(game &playedGame){
+
+    //Go over the goal columns together
+    unsigned long goalCount = playedGame.getGoalCount();
+    const int *speeds = playedGame.getGoalSpeeds();
+    const unsigned *times = playedGame.getGoalTimes();
+    const std::vector<bool> &sides = playedGame.getGoalSides();
+
+    for(unsigned long i = 0; i < goalCount; i++) addGoal(times[i], speeds[i], sides[i]);
+
+}
+
+
+//Function that puts together the statistics of one player
+livePlayerStatistics liveStatistics::getPlayerStatistics(unsigned long time, goalRateCounter &goalRate, speedSketch &speeds, double momentum, double otherMomentum){
+
+    livePlayerStatistics statistics;
+
+    statistics.goals = speeds.getCount();
+    statistics.goalsPerMinute = goalRate.getGoalsPerMinute(time);
+    statistics.medianSpeed = speeds.quantile(0.5);
+    statistics.p90Speed = speeds.quantile(0.9);
+
+    //The momentum is shown as a share of the momentum of both players
+    if(momentum + otherMomentum > 0) statistics.momentum = 100*momentum/(momentum + otherMomentum);
+    else statistics.momentum = 50;
+
+    return statistics;
+
+}
+
+
+//Function that returns the live statistics of player A
+livePlayerStatistics liveStatistics::getPlayerAStatistics(unsigned long time){
+
+    decayMomentum(time);
+    return getPlayerStatistics(time, playerAGoalRate, playerASpeeds, playerAMomentum, playerBMomentum);
+
+}
+
+
+//Function that returns the live statistics of player B
+livePlayerStatistics liveStatistics::getPlayerBStatistics(unsigned long time){
+
+    decayMomentum(time);
+    return getPlayerStatistics(time, playerBGoalRate, playerBSpeeds, playerBMomentum, playerAMomentum);
+
+}
@@ -1,9 +1,31 @@
 #include "mainmenuwindow.h"
+#include "MessageHandler.h"
 #include <QApplication>
+#include <stdlib.h>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    //Talk to a simulation running in its own process when one is given (for example "shm:/carehockey" or "unix:/tmp/carehockey.sock")
+    const char *simulatorAddress = getenv("CAREHOCKEY_SIMULATOR");
+    if(simulatorAddress != NULL){
+        MessageHandler::setSimulatorAddress(simulatorAddress);
+    }
+
+    //Replay a capture file in place of the embedded system, at the speed given (1.0 = real time, 0 = as fast as possible)
+    const char *replayFile = getenv("CAREHOCKEY_REPLAY");
+    if(replayFile != NULL){
+        const char *replaySpeed = getenv("CAREHOCKEY_REPLAY_SPEED");
+        MessageHandler::setReplaySource(replayFile, (replaySpeed != NULL) ? atof(replaySpeed) : 1.0);
+    }
+
+    //Record every frame sent to and received from the embedded system into a capture file
+    const char *captureFile = getenv("CAREHOCKEY_CAPTURE");
+    if(captureFile != NULL){
+        MessageHandler::instance().startCapture(captureFile);
+    }
+
     MainMenuWindow w;
     w.show();
 
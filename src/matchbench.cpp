@@ -0,0 +1,212 @@
+/**
+ * @file matchbench.cpp
+ * @author Sanjayan Kulendran
+ * @brief This file is responsible for checking that the games of a match are handed over without being copied or leaked
+ *
+ * A long match is played without any display: every game is owned by the player of the game while it is played (as the
+ * gameDisplay does), moved into the match when it ends (as the matchDisplay does), and the games are then moved out of the
+ * match into a matchOutcome and read back for storage (as the MainMenuWindow does). The match is played as the best of GAMES
+ * games, so it stops early once the games left can no longer change its outcome. Every allocation is counted, and the
+ * check fails if a hand-off allocates, or if any allocation is left over once the match is gone.
+ *
+ * The scores are also checked after a goal is retracted at every point of a game, including a correction that falls on a
+ * snapshot of the game log, which is rebuilt from the snapshot before it.
+ *
+ * The check is built with MatchBench.pro and is run as:
+ *
+ * ./MatchBench [GAMES] [SCORE_LIMIT]
+ *
+ * It exits with 0 if the checks pass, and 1 otherwise.
+ *
+ * @version 0.2
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include<cstdlib>
+#include<iostream>
+#include<memory>
+#include<new>
+#include<random>
+#include<vector>
+
+#include "game.h"
+#include "match.h"
+#include "gameoutcome.h"
+
+//Allocation counters, updated by the replaced global operators below (the array forms count as one allocation each)
+static unsigned long allocationCount = 0; //!< Number of allocations made
+static unsigned long liveAllocations = 0; //!< Number of allocations not freed yet
+
+void *operator new(std::size_t size){
+
+    //Count the allocation, a zero size must still give a unique pointer
+    allocationCount++;
+    liveAllocations++;
+    void *memory = std::malloc(size ? size : 1);
+
+    if(memory == nullptr) throw std::bad_alloc();
+    return memory;
+
+}
+
+//The replaced operator new allocates with malloc, so operator delete frees with free. GCC inlines operator delete where it
+//sees the new expression and warns of a mismatch it cannot tell is intended, so the warning is silenced for this function only
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *memory) noexcept{
+
+    //Freeing a null pointer is not an allocation
+    if(memory == nullptr) return;
+
+    liveAllocations--;
+    std::free(memory);
+
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic pop
+#endif
+
+void operator delete(void *memory, std::size_t) noexcept{
+
+    operator delete(memory);
+
+}
+
+void *operator new[](std::size_t size){
+
+    return operator new(size);
+
+}
+
+void operator delete[](void *memory) noexcept{
+
+    operator delete(memory);
+
+}
+
+void operator delete[](void *memory, std::size_t) noexcept{
+
+    operator delete(memory);
+
+}
+
+//Function that retracts the first goal of games of every length, and checks the scores left
+static bool checkCorrections(){
+
+    for(unsigned long goals = 1; goals <= 4*GAME_LOG_SNAPSHOT_INTERVAL; goals++){
+
+        //Every goal but the first is on A side, the correction is event goals + 2 (after the start and the goals)
+        game correctedGame(false);
+        correctedGame.startGame();
+        correctedGame.addGoal(50, true);
+        for(unsigned long i = 1; i < goals; i++) correctedGame.addGoal(50, false);
+
+        correctedGame.retractGoal(0);
+
+        if((correctedGame.getPlayerAScore() + correctedGame.getPlayerBScore() != goals - 1) || (correctedGame.getGoalCount() != goals - 1)){
+            std::cout<<"correction after "<<goals<<" goals leaves the scores "<<correctedGame.getPlayerAScore()<<"-"<<correctedGame.getPlayerBScore()<<std::endl;
+            return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+int main(int argc, char *argv[]){
+
+    //Read the number of games of the match and the score that wins a game
+    unsigned long gameCount = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 1000;
+    unsigned gameScoreLimit = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], NULL, 10)) : 11;
+
+    //Goals are scored at random, with repeatable speeds and sides
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> speeds(10, 120);
+    std::bernoulli_distribution sides(0.5);
+
+    unsigned long liveBeforeMatch = liveAllocations;
+    unsigned long playingAllocations = 0;
+    unsigned long handOffAllocations = 0;
+    unsigned long gamesPlayed = 0;
+    unsigned long goalCount = 0;
+
+    {
+        //The match reserves its games up front
+        match longMatch(MATCH_BEST_OF, gameCount);
+
+        while(!longMatch.isMatchOver()){
+
+            //Play a game owned by the player of the game, as the gameDisplay does
+            unsigned long allocationsBefore = allocationCount;
+            std::unique_ptr<game> currentGame(new game(true, gameScoreLimit));
+
+            currentGame->startGame();
+            while(!currentGame->isGameFinished()){
+                currentGame->addGoal(static_cast<unsigned>(speeds(generator)), sides(generator));
+            }
+            currentGame->pauseGame();
+
+            gamesPlayed++;
+            goalCount += currentGame->getGoalCount();
+            playingAllocations += allocationCount - allocationsBefore;
+
+            //Hand the game over to the match
+            allocationsBefore = allocationCount;
+            longMatch.addGame(std::move(*currentGame));
+            handOffAllocations += allocationCount - allocationsBefore;
+
+        }
+
+        //Hand the games of the match over to storage, with the details of the match stored once
+        matchOutcome outcome;
+        outcome.playerAName = "Player A";
+        outcome.playerBName = "Player B";
+        outcome.matchID = "0";
+        outcome.tableMode = 0;
+
+        unsigned long allocationsBefore = allocationCount;
+        outcome.games = longMatch.takeGames();
+
+        //Read the scores back as storage does
+        unsigned long playerAGames = 0;
+        for(unsigned long i = 0; i < outcome.games.size(); i++){
+            if(outcome.games[i].getPlayerAScore() > outcome.games[i].getPlayerBScore()) playerAGames++;
+        }
+        handOffAllocations += allocationCount - allocationsBefore;
+
+        matchStandings standings = longMatch.getStandings();
+        std::cout<<"games "<<outcome.games.size()<<" of "<<gameCount<<" goals "<<goalCount<<" player A wins "<<playerAGames;
+        std::cout<<" (standings "<<standings.playerAVictories<<"-"<<standings.playerBVictories<<", result "<<static_cast<int>(longMatch.getResult())<<")"<<std::endl;
+    }
+
+    //Once the match is gone, every allocation it made must have been freed
+    unsigned long leakedAllocations = liveAllocations - liveBeforeMatch;
+
+    std::cout<<"allocations per game "<<static_cast<double>(playingAllocations)/gamesPlayed<<std::endl;
+    std::cout<<"allocations per goal "<<static_cast<double>(playingAllocations)/goalCount<<std::endl;
+    std::cout<<"allocations in hand-offs "<<handOffAllocations<<std::endl;
+    std::cout<<"allocations leaked "<<leakedAllocations<<std::endl;
+
+    //Retracted goals must leave the right scores
+    bool correctionsPassed = checkCorrections();
+    std::cout<<"corrections "<<(correctionsPassed ? "match" : "do not match")<<std::endl;
+
+    //The hand-offs must only move the games, and nothing may be leaked
+    if((handOffAllocations != 0) || (leakedAllocations != 0) || !correctionsPassed){
+        std::cout<<"FAIL"<<std::endl;
+        return 1;
+    }
+
+    std::cout<<"PASS"<<std::endl;
+    return 0;
+
+}
@@ -3,8 +3,8 @@
  * @author Sanjayan Kulendran
  * @brief Implementation file used to implent the qt5 based matchDisplay class.
  *
- * @version 1.0
- * @date 2020-11-30
+ * @version 1.3
+ * @date 2026-10-19
  *
  *
  * @copyright Copyright (c) 2020
@@ -15,29 +15,30 @@
 #include "matchdisplay.h"
 #include "ui_matchdisplay.h"
 
-matchDisplay::matchDisplay(std::vector<game> &gamesInMatchReturnPointer, QWidget *parent, usermatchsettings *matchSettingsObjPtr , tableconfigurationsettings *tableConfigObjPtr,  player *playerAObjPtr, player *playerBObjPtr) :
+matchDisplay::matchDisplay(match &currentMatchReference, QWidget *parent, usermatchsettings *matchSettingsObjPtr , tableconfigurationsettings *tableConfigObjPtr,  player *playerAObjPtr, player *playerBObjPtr) :
     QDialog(parent),
     ui(new Ui::matchDisplay)
 {
     ui->setupUi(this);
 
-    //Initialize the amount of games won
-    playerAVictories = 0;
-    playerBVictories = 0;
+    //Set the internal match pointer to the passed by reference match
+    currentMatch = &currentMatchReference;
 
-    //Initialize the amount of games needed to win
-    firstTo = static_cast<int>(matchSettingsObjPtr->getNumberOfGames());
-
-    //Output this in the match display
-    ui->titleLabel->setText("First to " + QString::number(firstTo) + " Game Victories ");
+    //Output the rule of the match in the match display
+    if(currentMatch->getMatchType() == MATCH_FIRST_TO){
+        ui->titleLabel->setText("First to " + QString::number(currentMatch->getMatchGameCount()) + " Game Victories ");
+    }
+    else{
+        ui->titleLabel->setText("Best of " + QString::number(currentMatch->getMatchGameCount()) + " Games ");
+    }
     ui->titleLabel->setAlignment( Qt::AlignCenter);
 
-    //Output the player labels
-    ui->playerAlabel->setText(QString::fromStdString(playerAObjPtr->getName()));
-    ui->playerBlabel->setText(QString::fromStdString(playerBObjPtr->getName()));
+    //Output the player labels, with the rating each player starts the match with
+    ui->playerAlabel->setText(QString::fromStdString(playerAObjPtr->getName()) + " (" + QString::number(playerAObjPtr->getRating()) + ")");
+    ui->playerBlabel->setText(QString::fromStdString(playerBObjPtr->getName()) + " (" + QString::number(playerBObjPtr->getRating()) + ")");
 
-    //Set the internal game vector pointer to the passed by reference vector
-    gamesInMatch = &gamesInMatchReturnPointer;
+    //The game display returns one game at a time, which is then moved into the match
+    playedGame.reserve(1);
 
     //Save all the passed in pointers
     savedMatchSettingsObjPtr = matchSettingsObjPtr;
@@ -45,9 +46,6 @@ matchDisplay::matchDisplay(std::vector<game> &gamesInMatchReturnPointer, QWidget
     savedPlayerAObjPtr = playerAObjPtr;
     savedPlayerBObjPtr = playerBObjPtr;
 
-    //Initialize the match as not being over
-    matchOver = false;
-
 
 }
 
@@ -60,56 +58,26 @@ void matchDisplay::on_pushButton_clicked()
 {
 
     //If the match is not over
-    if(!matchOver){
+    if(!currentMatch->isMatchOver()){
 
         //Start the next game as a modal
-        gameDisplay curGameDisplay(*gamesInMatch, this, this->savedMatchSettingsObjPtr, this->savedTableConfigObjPtr,this->savedPlayerAObjPtr, this->savedPlayerBObjPtr);
+        gameDisplay curGameDisplay(playedGame, this, this->savedMatchSettingsObjPtr, this->savedTableConfigObjPtr,this->savedPlayerAObjPtr, this->savedPlayerBObjPtr);
         curGameDisplay.setModal(true);
         curGameDisplay.exec();
 
-        //If player A had the higher score
-        if((*gamesInMatch).back().getPlayerAScore() > (*gamesInMatch).back().getPlayerBScore()){
-
-            //Increment player a's count
-            playerAVictories++;
-            //Update player a's display
-            ui->playerAlcdNumber->display(playerAVictories);
-
-        }
-        //else If player B had the higher score
-        else if((*gamesInMatch).back().getPlayerBScore() > (*gamesInMatch).back().getPlayerAScore()){
-
-            //Increment player b's count
-            playerBVictories++;
-            //Update player b's display
-            ui->playerBlcdnumber->display(playerBVictories);
-
-        }
-        //Other wise if there was a tie
-        else if ((*gamesInMatch).back().getPlayerBScore() == (*gamesInMatch).back().getPlayerAScore()){
-
-            //Increment player a's count
-            playerAVictories++;
-            //Update player a's display
-            ui->playerAlcdNumber->display(playerAVictories);
-
-            //Increment player b's count
-            playerBVictories++;
-            //Update player b's display
-            ui->playerBlcdnumber->display(playerBVictories);
-
+        //Move the game into the match, which updates the standings (a game closed without the exit button is not returned)
+        if(!playedGame.empty()){
+            currentMatch->addGame(std::move(playedGame.back()));
+            playedGame.clear();
         }
 
-        //Update player a's display
-        //ui->playerAlcdNumber->display(playerAVictories);
-        //Update player b's display
-        //ui->playerBlcdnumber->display(playerBVictories);
+        //Update the victories of both players
+        matchStandings standings = currentMatch->getStandings();
+        ui->playerAlcdNumber->display(static_cast<int>(standings.playerAVictories));
+        ui->playerBlcdnumber->display(static_cast<int>(standings.playerBVictories));
 
-        //If only player A has won enough games to win the match
-        if ( (playerAVictories >= firstTo) && ( playerBVictories < firstTo) ){
-
-            //End the match
-            matchOver = true;
+        //If player A has won the match
+        if (currentMatch->getResult() == MATCH_RESULT_PLAYER_A){
 
             //Display that player a is the victor
             ui->titleLabel->setText( QString::fromStdString(savedPlayerAObjPtr->getName()) + " WINS!");
@@ -119,15 +87,9 @@ void matchDisplay::on_pushButton_clicked()
             ui->playerAlcdNumber->setSegmentStyle(QLCDNumber::Filled);
             ui->playerAlcdNumber->setPalette(QColor(25,255,100,255));
 
-            //Set the pushbutton to an exit label
-            ui->pushButton->setText(QString::fromStdString("Exit"));
-
         }
-        //If only player B has won enough games to win the match
-        else if ( (playerBVictories >= firstTo) && ( playerAVictories < firstTo) ){
-
-            //End the match
-            matchOver = true;
+        //If player B has won the match
+        else if (currentMatch->getResult() == MATCH_RESULT_PLAYER_B){
 
             //Display that player b is the victor
             ui->titleLabel->setText( QString::fromStdString(savedPlayerBObjPtr->getName()) + " WINS!");
@@ -137,16 +99,9 @@ void matchDisplay::on_pushButton_clicked()
             ui->playerBlcdnumber->setSegmentStyle(QLCDNumber::Filled);
             ui->playerBlcdnumber->setPalette(QColor(25,255,100,255));
 
-            //Set the pushbutton to an exit label
-            ui->pushButton->setText(QString::fromStdString("Exit"));
-
         }
-
-        //If both players have won enough games to win the match
-        else if ( (playerAVictories >= firstTo) && (playerBVictories == playerAVictories)){
-
-            //End the match
-            matchOver = true;
+        //If the match is over without a winner
+        else if (currentMatch->getResult() == MATCH_RESULT_TIE){
 
             //Display that there is a tie
             ui->titleLabel->setText( QString::fromStdString(" TIE!"));
@@ -161,11 +116,11 @@ void matchDisplay::on_pushButton_clicked()
             ui->playerBlcdnumber->setSegmentStyle(QLCDNumber::Filled);
             ui->playerBlcdnumber->setPalette(QColor(225,155,100,255));
 
-            //Set the pushbutton to an exit label
-            ui->pushButton->setText(QString::fromStdString("Exit"));
-
         }
 
+        //Once the match is over, set the pushbutton to an exit label
+        if (currentMatch->isMatchOver()) ui->pushButton->setText(QString::fromStdString("Exit"));
+
     }
     //If the match is finished
     else{
@@ -0,0 +1,108 @@
+/**
+ * @file nameindex.cpp
+ * @author Ali Sarfraz
+ * @brief Implementation file used to implement the nameIndex class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "nameindex.h"
+
+#include <QAbstractItemView>
+#include <QCompleter>
+#include <QStringListModel>
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+nameIndex::nameIndex()
+{
+}
+
+void nameIndex::load(const std::vector<std::string> &loaded)
+{
+    std::vector<std::pair<std::string, std::string> > added;
+    added.reserve(loaded.size());
+
+    for (auto &name : loaded) {
+        added.push_back(std::make_pair(fold(name), name));
+    }
+    std::sort(added.begin(), added.end());
+
+    // Merge with the names inserted while loading, and drop the names present in both.
+    std::vector<std::pair<std::string, std::string> > merged;
+    merged.reserve(names.size() + added.size());
+    std::set_union(names.begin(), names.end(), added.begin(), added.end(), std::back_inserter(merged));
+    merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+
+    names.swap(merged);
+}
+
+void nameIndex::insert(const std::string &name)
+{
+    auto entry = std::make_pair(fold(name), name);
+    auto found = std::lower_bound(names.begin(), names.end(), entry);
+
+    if ((found == names.end()) || (*found != entry)) {
+        names.insert(found, entry);
+    }
+}
+
+std::vector<std::string> nameIndex::suggest(const std::string &prefix, unsigned long limit)
+{
+    std::vector<std::string> found;
+    std::string key = fold(prefix);
+
+    // The names starting with the prefix are together, from the first name not before it.
+    auto next = std::lower_bound(names.begin(), names.end(), std::make_pair(key, std::string()));
+
+    for (; (next != names.end()) && (found.size() < limit); ++next) {
+        if (next->first.compare(0, key.size(), key) != 0) break;
+        found.push_back(next->second);
+    }
+
+    return found;
+}
+
+unsigned long nameIndex::size()
+{
+    return names.size();
+}
+
+void nameIndex::attach(QLineEdit *lineEdit)
+{
+    // The completer shows the names found by the index as they are, it does not filter them again.
+    QStringListModel *model = new QStringListModel(lineEdit);
+    QCompleter *completer = new QCompleter(model, lineEdit);
+    completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    completer->setCaseSensitivity(Qt::CaseInsensitive);
+    lineEdit->setCompleter(completer);
+
+    // Search again on every keystroke.
+    QObject::connect(lineEdit, &QLineEdit::textEdited, completer, [this, model, completer](const QString &text){
+        QStringList shown;
+
+        if (!text.isEmpty()) {
+            for (auto &name : suggest(text.toStdString())) {
+                shown << QString::fromStdString(name);
+            }
+        }
+
+        model->setStringList(shown);
+        if (shown.isEmpty()) completer->popup()->hide();
+        else completer->complete();
+    });
+}
+
+std::string nameIndex::fold(const std::string &name)
+{
+    std::string folded = name;
+
+    for (auto &c : folded) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    return folded;
+}
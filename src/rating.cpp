@@ -0,0 +1,251 @@
+/**
+ * @file rating.cpp
+ * @author Sanjayan Kulendran
+ * @brief Implementation file used to implement the ratingEngine class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "rating.h"
+
+#include<algorithm>  //Levels of the matches
+#include<cmath>  //Glicko-2 formulas
+#include<thread>  //Rating the levels of the history in parallel
+#include<mutex>  //Level barrier
+#include<condition_variable>  //Level barrier
+
+static const double pi = 3.14159265358979323846;
+
+/**
+ * @brief The levelBarrier class holds the threads of a recompute until every thread has rated the current level
+ */
+class levelBarrier
+{
+
+private:
+
+    std::mutex barrierMutex; //!< Protects the counts
+    std::condition_variable levelDone; //!< Signalled when the last thread reaches the barrier
+    unsigned threadCount; //!< Number of threads using the barrier
+    unsigned waiting; //!< Number of threads waiting for the current level
+    unsigned long level; //!< Number of levels passed
+
+public:
+
+    levelBarrier(unsigned threads) : threadCount(threads), waiting(0), level(0) {}
+
+    //Function that waits until every thread has reached the barrier
+    void wait(){
+
+        std::unique_lock<std::mutex> lock(barrierMutex);
+        unsigned long arrivedLevel = level;
+
+        //The last thread releases the others
+        if(++waiting == threadCount){
+            waiting = 0;
+            level++;
+            levelDone.notify_all();
+            return;
+        }
+
+        levelDone.wait(lock, [&](){ return level != arrivedLevel; });
+
+    }
+
+};
+
+
+//Engine constructor, with the default parameters
+ratingEngine::ratingEngine()
+{
+    parameters.initialRating = RATING_INITIAL;
+    parameters.initialDeviation = RATING_INITIAL_DEVIATION;
+    parameters.initialVolatility = RATING_INITIAL_VOLATILITY;
+    parameters.tau = RATING_TAU;
+}
+
+
+//Engine constructor, with given parameters
+ratingEngine::ratingEngine(const ratingParameters &engineParameters)
+{
+    parameters = engineParameters;
+}
+
+
+//Function that returns the rating of a new player
+playerRating ratingEngine::newRating() const{
+
+    playerRating rating;
+    rating.rating = parameters.initialRating;
+    rating.deviation = parameters.initialDeviation;
+    rating.volatility = parameters.initialVolatility;
+    rating.matches = 0;
+
+    return rating;
+
+}
+
+
+//Function that computes the rating of a player after a match (steps 2 to 8 of the Glicko-2 paper, with one game in the period)
+playerRating ratingEngine::updatePlayer(const playerRating &player, const playerRating &opponent, double score) const{
+
+    //Convert to the Glicko-2 scale
+    double mu = (player.rating - parameters.initialRating)/RATING_SCALE;
+    double phi = player.deviation/RATING_SCALE;
+    double opponentMu = (opponent.rating - parameters.initialRating)/RATING_SCALE;
+    double opponentPhi = opponent.deviation/RATING_SCALE;
+
+    //Expected score against the opponent, weighted down by the uncertainty of the opponent's rating
+    double g = 1/std::sqrt(1 + 3*opponentPhi*opponentPhi/(pi*pi));
+    double expected = 1/(1 + std::exp(-g*(mu - opponentMu)));
+
+    //Estimated variance of the rating from the match, and the estimated improvement
+    double variance = 1/(g*g*expected*(1 - expected));
+    double delta = variance*g*(score - expected);
+
+    //New volatility, found as the root of f(x) with the Illinois algorithm
+    double phiSquared = phi*phi;
+    double tauSquared = parameters.tau*parameters.tau;
+    double a = std::log(player.volatility*player.volatility);
+
+    auto f = [&](double x){
+        double ex = std::exp(x);
+        double denominator = phiSquared + variance + ex;
+        return ex*(delta*delta - phiSquared - variance - ex)/(2*denominator*denominator) - (x - a)/tauSquared;
+    };
+
+    double lower = a;
+    double upper;
+
+    if(delta*delta > phiSquared + variance){
+        upper = std::log(delta*delta - phiSquared - variance);
+    }
+    else{
+        unsigned k = 1;
+        while(f(a - k*parameters.tau) < 0) k++;
+        upper = a - k*parameters.tau;
+    }
+
+    double fLower = f(lower);
+    double fUpper = f(upper);
+
+    while(std::fabs(upper - lower) > RATING_CONVERGENCE){
+
+        double next = lower + (lower - upper)*fLower/(fUpper - fLower);
+        double fNext = f(next);
+
+        if(fNext*fUpper <= 0){
+            lower = upper;
+            fLower = fUpper;
+        }
+        else{
+            fLower /= 2;
+        }
+
+        upper = next;
+        fUpper = fNext;
+    }
+
+    double volatility = std::exp(lower/2);
+
+    //New deviation and rating
+    double phiStar = std::sqrt(phiSquared + volatility*volatility);
+    double newPhi = 1/std::sqrt(1/(phiStar*phiStar) + 1/variance);
+    double newMu = mu + newPhi*newPhi*g*(score - expected);
+
+    //Convert back to the Glicko scale
+    playerRating updated;
+    updated.rating = RATING_SCALE*newMu + parameters.initialRating;
+    updated.deviation = RATING_SCALE*newPhi;
+    updated.volatility = volatility;
+    updated.matches = player.matches + 1;
+
+    return updated;
+
+}
+
+
+//Function that updates the ratings of both players of a finished match
+void ratingEngine::rateMatch(playerRating &playerA, playerRating &playerB, double playerAScore) const{
+
+    //Both players are rated from the ratings they had before the match
+    playerRating updatedA = updatePlayer(playerA, playerB, playerAScore);
+    playerRating updatedB = updatePlayer(playerB, playerA, 1 - playerAScore);
+
+    playerA = updatedA;
+    playerB = updatedB;
+
+}
+
+
+//Function that computes the ratings of every player from the full match history
+std::vector<playerRating> ratingEngine::recompute(const std::vector<ratedMatch> &history, unsigned long playerCount, unsigned threadCount) const{
+
+    std::vector<playerRating> ratings(playerCount, newRating());
+
+    //Place every match one level after the last matches of its players, so the matches of a level have no player in common
+    std::vector<unsigned long> playerLevels(playerCount, 0);
+    std::vector<unsigned long> matchLevels(history.size());
+    unsigned long levelCount = 0;
+
+    for(unsigned long i = 0; i < history.size(); i++){
+
+        unsigned long level = std::max(playerLevels[history[i].playerA], playerLevels[history[i].playerB]);
+
+        matchLevels[i] = level;
+        playerLevels[history[i].playerA] = level + 1;
+        playerLevels[history[i].playerB] = level + 1;
+
+        if(level + 1 > levelCount) levelCount = level + 1;
+    }
+
+    //Sort the matches by level (counting sort, which keeps the order of the history within a level)
+    std::vector<unsigned long> levelStarts(levelCount + 1, 0);
+    for(unsigned long i = 0; i < history.size(); i++) levelStarts[matchLevels[i] + 1]++;
+    for(unsigned long level = 0; level < levelCount; level++) levelStarts[level + 1] += levelStarts[level];
+
+    std::vector<unsigned long> order(history.size());
+    std::vector<unsigned long> nextSlot(levelStarts.begin(), levelStarts.end() - 1);
+    for(unsigned long i = 0; i < history.size(); i++) order[nextSlot[matchLevels[i]]++] = i;
+
+    //One thread per core, but no more threads than matches in the widest level are useful
+    if(threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if(threadCount == 0) threadCount = 1;
+
+    unsigned long widestLevel = 0;
+    for(unsigned long level = 0; level < levelCount; level++){
+        widestLevel = std::max(widestLevel, levelStarts[level + 1] - levelStarts[level]);
+    }
+    if(threadCount > widestLevel) threadCount = (widestLevel > 0) ? static_cast<unsigned>(widestLevel) : 1;
+
+    //Each thread rates its share of every level, and waits for the others before the next level
+    levelBarrier barrier(threadCount);
+
+    auto rateLevels = [&](unsigned thread){
+
+        for(unsigned long level = 0; level < levelCount; level++){
+
+            for(unsigned long slot = levelStarts[level] + thread; slot < levelStarts[level + 1]; slot += threadCount){
+                const ratedMatch &ratedGame = history[order[slot]];
+                rateMatch(ratings[ratedGame.playerA], ratings[ratedGame.playerB], ratedGame.playerAScore);
+            }
+
+            if(threadCount > 1) barrier.wait();
+        }
+
+    };
+
+    std::vector<std::thread> threads;
+    for(unsigned thread = 1; thread < threadCount; thread++) threads.push_back(std::thread(rateLevels, thread));
+
+    rateLevels(0);
+
+    for(unsigned long i = 0; i < threads.size(); i++) threads[i].join();
+
+    return ratings;
+
+}
@@ -0,0 +1,129 @@
+/**
+ * @file storagewriter.cpp
+ * @author Ali Sarfraz
+ * @brief Implementation file used to implement the storageWriter class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+#include "storagewriter.h"
+
+#include <QDebug>
+
+storageWriter::storageWriter(matchStorage *storage, unsigned long capacity) :
+    QObject(nullptr),
+    storage(storage),
+    capacity((capacity > 0) ? capacity : 1),
+    nextJob(0),
+    finishedJobs(0),
+    stopping(false)
+{
+    writerThread = std::thread(&storageWriter::run, this);
+}
+
+storageWriter::~storageWriter()
+{
+    // The writer commits every job still waiting before it stops.
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+
+    writerThread.join();
+}
+
+unsigned long storageWriter::submit(storageJob job)
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+
+    // A job is never dropped, the caller waits for room instead.
+    jobsTaken.wait(lock, [&](){ return jobs.size() < capacity; });
+
+    unsigned long number = nextJob++;
+    jobs.push_back(std::make_pair(number, std::move(job)));
+
+    lock.unlock();
+    jobAvailable.notify_one();
+
+    return number;
+}
+
+void storageWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    unsigned long submitted = nextJob;
+
+    jobsTaken.wait(lock, [&](){ return finishedJobs >= submitted; });
+}
+
+void storageWriter::run()
+{
+    std::vector<std::pair<unsigned long, storageJob> > group;
+    std::vector<bool> results;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            jobAvailable.wait(lock, [&](){ return stopping || !jobs.empty(); });
+
+            // Stop once asked to, and every job has been committed.
+            if (jobs.empty()) return;
+
+            // Take every job waiting, they are committed together.
+            while (!jobs.empty() && (group.size() < STORAGE_GROUP_LIMIT)) {
+                group.push_back(std::move(jobs.front()));
+                jobs.pop_front();
+            }
+        }
+        jobsTaken.notify_all();
+
+        commitGroup(group, results);
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            finishedJobs += group.size();
+        }
+        jobsTaken.notify_all();
+
+        // Tell the GUI, the signals are queued to the thread of the receivers.
+        for (auto i = 0u; i < group.size(); i++) {
+            emit jobFinished(group[i].first, results[i]);
+        }
+
+        group.clear();
+    }
+}
+
+void storageWriter::commitGroup(std::vector<std::pair<unsigned long, storageJob> > &group, std::vector<bool> &results)
+{
+    sqlite3* db = storage->getWriter();
+    results.assign(group.size(), false);
+
+    if ((db == NULL) || (sqlite3_exec(db, "BEGIN;", NULL, NULL, NULL) != SQLITE_OK)) {
+        qDebug() << "Error: " << ((db != NULL) ? sqlite3_errmsg(db) : "database not open");
+        return;
+    }
+
+    // Each job runs in a savepoint, a job that fails is undone without undoing the others.
+    for (auto i = 0u; i < group.size(); i++) {
+        sqlite3_exec(db, "SAVEPOINT job;", NULL, NULL, NULL);
+
+        results[i] = group[i].second(*storage);
+
+        if (!results[i]) {
+            qDebug() << "Error: " << sqlite3_errmsg(db);
+            sqlite3_exec(db, "ROLLBACK TO job;", NULL, NULL, NULL);
+        }
+        sqlite3_exec(db, "RELEASE job;", NULL, NULL, NULL);
+    }
+
+    // One commit, and one sync of the file, for the whole group.
+    if (sqlite3_exec(db, "COMMIT;", NULL, NULL, NULL) != SQLITE_OK) {
+        qDebug() << "Error: " << sqlite3_errmsg(db);
+        sqlite3_exec(db, "ROLLBACK;", NULL, NULL, NULL);
+        results.assign(group.size(), false);
+    }
+}
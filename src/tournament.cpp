@@ -0,0 +1,597 @@
+/**
+ * @file tournament.cpp
+ * @author Sanjayan Kulendran
+ * @brief Implementation file used to implement the tournament class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "tournament.h"
+
+#include<algorithm>  //Seeding and standings
+
+//Tournament constructor, creates every match and schedules the first matches
+tournament::tournament(unsigned char tournamentFormat, const std::vector<std::string> &names, const std::vector<double> &ratings, unsigned long tableCount)
+{
+    format = tournamentFormat;
+    grandFinal = TOURNAMENT_NONE;
+    champion = TOURNAMENT_NONE;
+    matchesLeft = 0;
+
+    //The tournament is played on at least one table
+    tables.assign((tableCount > 0) ? tableCount : 1, TOURNAMENT_NONE);
+
+    //Add the entrants, an entrant without a rating is seeded as unrated
+    entrants.resize(names.size());
+    for(unsigned long i = 0; i < names.size(); i++){
+        entrants[i].name = names[i];
+        entrants[i].rating = (i < ratings.size()) ? ratings[i] : 0;
+        entrants[i].wins = 0;
+        entrants[i].losses = 0;
+        entrants[i].ties = 0;
+        entrants[i].points = 0;
+        entrants[i].eliminated = false;
+        entrants[i].eliminationChain = 0;
+        entrants[i].table = TOURNAMENT_NONE;
+    }
+    freeEntrants = entrants.size();
+
+    //Seed the entrants by rating, the highest rating first
+    std::vector<unsigned long> seeded(entrants.size());
+    for(unsigned long i = 0; i < seeded.size(); i++) seeded[i] = i;
+
+    std::stable_sort(seeded.begin(), seeded.end(), [&](unsigned long a, unsigned long b){
+        return entrants[a].rating > entrants[b].rating;
+    });
+
+    for(unsigned long i = 0; i < seeded.size(); i++) entrants[seeded[i]].seed = i + 1;
+
+    //Create the matches of the format
+    if(format == TOURNAMENT_ROUND_ROBIN) createRoundRobin(seeded);
+    else createBracket(seeded);
+
+    //Give the tables their first matches
+    scheduleTables();
+}
+
+
+//Function that adds a match with no entrants yet
+unsigned long tournament::addMatch(unsigned char bracket, unsigned long round){
+
+    tournamentMatch added;
+    added.entrants[0] = TOURNAMENT_NONE;
+    added.entrants[1] = TOURNAMENT_NONE;
+    added.bracket = bracket;
+    added.round = round;
+    added.state = TOURNAMENT_MATCH_WAITING;
+    added.result = MATCH_RESULT_UNDECIDED;
+    added.winner = TOURNAMENT_NONE;
+    added.loser = TOURNAMENT_NONE;
+    added.winnerMatch = TOURNAMENT_NONE;
+    added.winnerSlot = 0;
+    added.loserMatch = TOURNAMENT_NONE;
+    added.loserSlot = 0;
+    added.chain = 0;
+    added.priority = 0;
+    added.table = TOURNAMENT_NONE;
+
+    matches.push_back(added);
+    matchesLeft++;
+
+    return matches.size() - 1;
+
+}
+
+
+//Function that sends the winner of a match to a later match
+void tournament::linkWinner(unsigned long from, unsigned long to, unsigned char slot){
+
+    matches[from].winnerMatch = to;
+    matches[from].winnerSlot = slot;
+
+}
+
+
+//Function that sends the loser of a match to a later match
+void tournament::linkLoser(unsigned long from, unsigned long to, unsigned char slot){
+
+    matches[from].loserMatch = to;
+    matches[from].loserSlot = slot;
+
+}
+
+
+//Function that creates the matches of a single or double elimination bracket
+void tournament::createBracket(const std::vector<unsigned long> &seeded){
+
+    if(seeded.empty()) return;
+
+    //The bracket is filled up to a power of two with byes
+    unsigned long size = 2;
+    unsigned long rounds = 1;
+    while(size < seeded.size()){
+        size *= 2;
+        rounds++;
+    }
+
+    //Place the seeds so that seed s meets seed (size + 1 - s) in the first round, and the best seeds meet as late as possible
+    std::vector<unsigned long> positions(1, 1);
+    while(positions.size() < size){
+
+        unsigned long pairSum = 2*positions.size() + 1;
+        std::vector<unsigned long> expanded;
+
+        for(unsigned long i = 0; i < positions.size(); i++){
+            expanded.push_back(positions[i]);
+            expanded.push_back(pairSum - positions[i]);
+        }
+
+        positions.swap(expanded);
+    }
+
+    //Winners bracket, the winners of two matches meet in the next round
+    std::vector<std::vector<unsigned long> > winners(rounds);
+
+    for(unsigned long round = 0; round < rounds; round++){
+        for(unsigned long j = 0; j < (size >> (round + 1)); j++){
+
+            unsigned long added = addMatch(TOURNAMENT_BRACKET_WINNERS, round + 1);
+            winners[round].push_back(added);
+
+            if(round > 0){
+                linkWinner(winners[round - 1][2*j], added, 0);
+                linkWinner(winners[round - 1][2*j + 1], added, 1);
+            }
+        }
+    }
+
+    if(format == TOURNAMENT_DOUBLE_ELIMINATION){
+
+        unsigned long losersFinal = TOURNAMENT_NONE;
+
+        if(rounds > 1){
+
+            //First round of the losers bracket, between the losers of the first round of the winners bracket
+            std::vector<unsigned long> previous;
+            unsigned long loserRound = 1;
+
+            for(unsigned long j = 0; j < size/4; j++){
+                unsigned long added = addMatch(TOURNAMENT_BRACKET_LOSERS, loserRound);
+                linkLoser(winners[0][2*j], added, 0);
+                linkLoser(winners[0][2*j + 1], added, 1);
+                previous.push_back(added);
+            }
+
+            for(unsigned long round = 1; round < rounds; round++){
+
+                //The winners of the losers bracket meet the losers of the next round of the winners bracket, taken in reverse
+                //order every other round so that entrants do not meet again straight away
+                std::vector<unsigned long> current;
+                unsigned long count = previous.size();
+                loserRound++;
+
+                for(unsigned long j = 0; j < count; j++){
+                    unsigned long added = addMatch(TOURNAMENT_BRACKET_LOSERS, loserRound);
+                    linkWinner(previous[j], added, 0);
+                    linkLoser(winners[round][(round % 2 == 1) ? (count - 1 - j) : j], added, 1);
+                    current.push_back(added);
+                }
+
+                previous.swap(current);
+
+                //The winners of those matches then meet each other, until the final of the losers bracket
+                if(round + 1 < rounds){
+
+                    current.clear();
+                    loserRound++;
+
+                    for(unsigned long j = 0; j < previous.size()/2; j++){
+                        unsigned long added = addMatch(TOURNAMENT_BRACKET_LOSERS, loserRound);
+                        linkWinner(previous[2*j], added, 0);
+                        linkWinner(previous[2*j + 1], added, 1);
+                        current.push_back(added);
+                    }
+
+                    previous.swap(current);
+                }
+            }
+
+            losersFinal = previous[0];
+        }
+
+        //Grand final between the winners of both brackets (with two entrants, the loser of the only match goes straight to it)
+        grandFinal = addMatch(TOURNAMENT_BRACKET_FINAL, 1);
+        linkWinner(winners[rounds - 1][0], grandFinal, 0);
+        if(losersFinal != TOURNAMENT_NONE) linkWinner(losersFinal, grandFinal, 1);
+        else linkLoser(winners[rounds - 1][0], grandFinal, 1);
+
+        //The grand final is played again if the winner of the losers bracket wins it, as both entrants then have one loss
+        unsigned long reset = addMatch(TOURNAMENT_BRACKET_FINAL, 2);
+        linkWinner(grandFinal, reset, 0);
+        linkLoser(grandFinal, reset, 1);
+    }
+
+    prioritize();
+
+    //Place the seeds in the first round, seeds past the number of entrants are byes
+    for(unsigned long j = 0; j < size/2; j++){
+        for(unsigned char slot = 0; slot < 2; slot++){
+            unsigned long seed = positions[2*j + slot];
+            placeEntrant(winners[0][j], slot, (seed <= seeded.size()) ? seeded[seed - 1] : TOURNAMENT_BYE);
+        }
+    }
+
+}
+
+
+//Function that creates the matches of a round robin
+void tournament::createRoundRobin(const std::vector<unsigned long> &seeded){
+
+    if(seeded.size() < 2) return;
+
+    //Circle method: the first entrant stays in place while the others rotate, an odd number of entrants gets a bye each round
+    std::vector<unsigned long> circle(seeded);
+    if(circle.size() % 2 == 1) circle.push_back(TOURNAMENT_BYE);
+
+    unsigned long count = circle.size();
+
+    for(unsigned long round = 1; round < count; round++){
+
+        for(unsigned long j = 0; j < count/2; j++){
+
+            unsigned long entrantA = circle[j];
+            unsigned long entrantB = circle[count - 1 - j];
+            if((entrantA == TOURNAMENT_BYE) || (entrantB == TOURNAMENT_BYE)) continue;
+
+            //The fixed entrant changes sides every round
+            if((j == 0) && (round % 2 == 0)) std::swap(entrantA, entrantB);
+
+            unsigned long added = addMatch(TOURNAMENT_BRACKET_ROUND_ROBIN, round);
+            matches[added].entrants[0] = entrantA;
+            matches[added].entrants[1] = entrantB;
+        }
+
+        std::rotate(circle.begin() + 1, circle.end() - 1, circle.end());
+    }
+
+    prioritize();
+
+    //Every match is ready from the start
+    for(unsigned long i = 0; i < matches.size(); i++){
+        matches[i].state = TOURNAMENT_MATCH_READY;
+        readyMatches.insert(std::make_pair(matches[i].priority, i));
+    }
+
+}
+
+
+//Function that works out the chain and priority of every match
+void tournament::prioritize(){
+
+    //A match only feeds matches created after it, so the chains are worked out from the last match back
+    for(unsigned long i = matches.size(); i-- > 0;){
+
+        unsigned long longest = 0;
+        if(matches[i].winnerMatch != TOURNAMENT_NONE) longest = std::max(longest, matches[matches[i].winnerMatch].chain);
+        if(matches[i].loserMatch != TOURNAMENT_NONE) longest = std::max(longest, matches[matches[i].loserMatch].chain);
+
+        matches[i].chain = longest + 1;
+    }
+
+    //The longest chains are played first, then the earlier rounds, then the matches created first
+    std::vector<unsigned long> order(matches.size());
+    for(unsigned long i = 0; i < order.size(); i++) order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [&](unsigned long a, unsigned long b){
+        if(matches[a].chain != matches[b].chain) return matches[a].chain > matches[b].chain;
+        return matches[a].round < matches[b].round;
+    });
+
+    for(unsigned long i = 0; i < order.size(); i++) matches[order[i]].priority = i;
+
+}
+
+
+//Function that indicates if a slot holds an entrant
+bool tournament::isEntrant(unsigned long entrant){
+
+    return (entrant != TOURNAMENT_NONE) && (entrant != TOURNAMENT_BYE);
+
+}
+
+
+//Function that places an entrant or a bye in a slot of a match
+void tournament::placeEntrant(unsigned long matchIndex, unsigned char slot, unsigned long entrant){
+
+    tournamentMatch &placed = matches[matchIndex];
+    placed.entrants[slot] = entrant;
+
+    //Wait for the other entrant
+    unsigned long other = placed.entrants[1 - slot];
+    if(other == TOURNAMENT_NONE) return;
+
+    //Against a bye, the other entrant goes through without playing
+    if(entrant == TOURNAMENT_BYE) decideMatch(matchIndex, 1 - slot, false);
+    else if(other == TOURNAMENT_BYE) decideMatch(matchIndex, slot, false);
+    else{
+        placed.state = TOURNAMENT_MATCH_READY;
+        readyMatches.insert(std::make_pair(placed.priority, matchIndex));
+    }
+
+}
+
+
+//Function that decides a match and sends its winner and loser on
+void tournament::decideMatch(unsigned long matchIndex, unsigned char winnerSlot, bool played){
+
+    tournamentMatch &decided = matches[matchIndex];
+    decided.winner = decided.entrants[winnerSlot];
+    decided.loser = decided.entrants[1 - winnerSlot];
+    decided.state = played ? TOURNAMENT_MATCH_FINISHED : TOURNAMENT_MATCH_SKIPPED;
+    matchesLeft--;
+
+    if(played){
+        entrants[decided.winner].wins++;
+        entrants[decided.loser].losses++;
+    }
+
+    //If the winner of the winners bracket wins the grand final, the reset is not needed
+    bool resetSkipped = (matchIndex == grandFinal) && (winnerSlot == 0);
+
+    if(resetSkipped){
+        matches[decided.winnerMatch].state = TOURNAMENT_MATCH_SKIPPED;
+        matchesLeft--;
+    }
+
+    //Send the loser on, or eliminate them
+    if((decided.loserMatch != TOURNAMENT_NONE) && !resetSkipped) placeEntrant(decided.loserMatch, decided.loserSlot, decided.loser);
+    else if(isEntrant(decided.loser)){
+        entrants[decided.loser].eliminated = true;
+        entrants[decided.loser].eliminationChain = decided.chain;
+        freeEntrants--;
+    }
+
+    //Send the winner on, or crown them
+    if((decided.winnerMatch != TOURNAMENT_NONE) && !resetSkipped) placeEntrant(decided.winnerMatch, decided.winnerSlot, decided.winner);
+    else if(isEntrant(decided.winner)) champion = decided.winner;
+
+}
+
+
+//Function to report the result of a match being played
+bool tournament::reportResult(unsigned long matchIndex, unsigned char result){
+
+    if(matchIndex >= matches.size()) return false;
+
+    tournamentMatch &reported = matches[matchIndex];
+
+    //Only a match being played can be reported, with a decided result
+    if(reported.state != TOURNAMENT_MATCH_PLAYING) return false;
+    if((result != MATCH_RESULT_PLAYER_A) && (result != MATCH_RESULT_PLAYER_B) && (result != MATCH_RESULT_TIE)) return false;
+
+    //Free the table and the entrants (the match keeps the table it was played on)
+    tables[reported.table] = TOURNAMENT_NONE;
+    entrants[reported.entrants[0]].table = TOURNAMENT_NONE;
+    entrants[reported.entrants[1]].table = TOURNAMENT_NONE;
+    freeEntrants += 2;
+
+    reported.result = result;
+
+    if(format == TOURNAMENT_ROUND_ROBIN){
+
+        tournamentEntrant &entrantA = entrants[reported.entrants[0]];
+        tournamentEntrant &entrantB = entrants[reported.entrants[1]];
+
+        reported.state = TOURNAMENT_MATCH_FINISHED;
+        matchesLeft--;
+
+        //Score the match
+        if(result == MATCH_RESULT_PLAYER_A){
+            reported.winner = reported.entrants[0];
+            reported.loser = reported.entrants[1];
+            entrantA.wins++;
+            entrantA.points += 1;
+            entrantB.losses++;
+        }
+        else if(result == MATCH_RESULT_PLAYER_B){
+            reported.winner = reported.entrants[1];
+            reported.loser = reported.entrants[0];
+            entrantB.wins++;
+            entrantB.points += 1;
+            entrantA.losses++;
+        }
+        else{
+            entrantA.ties++;
+            entrantA.points += 0.5;
+            entrantB.ties++;
+            entrantB.points += 0.5;
+        }
+
+    }
+    else{
+
+        //In a bracket someone has to go through, so a tie goes to the better seed
+        unsigned char winnerSlot;
+        if(result == MATCH_RESULT_PLAYER_A) winnerSlot = 0;
+        else if(result == MATCH_RESULT_PLAYER_B) winnerSlot = 1;
+        else winnerSlot = (entrants[reported.entrants[0]].seed < entrants[reported.entrants[1]].seed) ? 0 : 1;
+
+        decideMatch(matchIndex, winnerSlot, true);
+
+    }
+
+    //Give the freed table its next match straight away
+    scheduleTables();
+
+    return true;
+
+}
+
+
+//Function that gives every free table a ready match
+unsigned long tournament::scheduleTables(){
+
+    unsigned long scheduled = 0;
+
+    for(unsigned long table = 0; table < tables.size(); table++){
+
+        if(tables[table] != TOURNAMENT_NONE) continue;
+
+        //No match can be played without two free entrants
+        if(freeEntrants < 2) break;
+
+        //Take the first ready match whose entrants are not playing on another table (in a bracket, that is always the first)
+        std::set<std::pair<unsigned long, unsigned long> >::iterator next = readyMatches.begin();
+        while(next != readyMatches.end()){
+            const tournamentMatch &candidate = matches[next->second];
+            if((entrants[candidate.entrants[0]].table == TOURNAMENT_NONE) && (entrants[candidate.entrants[1]].table == TOURNAMENT_NONE)) break;
+            ++next;
+        }
+
+        if(next == readyMatches.end()) break;
+
+        unsigned long matchIndex = next->second;
+        readyMatches.erase(next);
+
+        //Put the match on the table
+        tournamentMatch &assigned = matches[matchIndex];
+        assigned.state = TOURNAMENT_MATCH_PLAYING;
+        assigned.table = table;
+        tables[table] = matchIndex;
+        entrants[assigned.entrants[0]].table = table;
+        entrants[assigned.entrants[1]].table = table;
+        freeEntrants -= 2;
+        scheduled++;
+    }
+
+    return scheduled;
+
+}
+
+
+//Function that indicates if every match has been decided
+bool tournament::isTournamentOver(){
+
+    return matchesLeft == 0;
+
+}
+
+
+//Function that returns the format of the tournament
+unsigned char tournament::getFormat(){
+
+    return format;
+
+}
+
+
+//Function that returns the winner of the tournament
+unsigned long tournament::getChampion(){
+
+    if(!isTournamentOver() || entrants.empty()) return TOURNAMENT_NONE;
+
+    //The round robin is won by the leader of the standings
+    if(format == TOURNAMENT_ROUND_ROBIN) return getStandings()[0];
+
+    return champion;
+
+}
+
+
+//Function that returns the entrants in the order of their standing
+std::vector<unsigned long> tournament::getStandings(){
+
+    std::vector<unsigned long> order(entrants.size());
+    for(unsigned long i = 0; i < order.size(); i++) order[i] = i;
+
+    std::sort(order.begin(), order.end(), [&](unsigned long a, unsigned long b){
+
+        const tournamentEntrant &entrantA = entrants[a];
+        const tournamentEntrant &entrantB = entrants[b];
+
+        if(format == TOURNAMENT_ROUND_ROBIN){
+            if(entrantA.points != entrantB.points) return entrantA.points > entrantB.points;
+            if(entrantA.wins != entrantB.wins) return entrantA.wins > entrantB.wins;
+        }
+        else{
+            //The champion first, then the entrants still in, then the entrants eliminated in later rounds (shorter chains)
+            if((a == champion) != (b == champion)) return a == champion;
+            if(entrantA.eliminated != entrantB.eliminated) return !entrantA.eliminated;
+            if(entrantA.eliminated && (entrantA.eliminationChain != entrantB.eliminationChain)) return entrantA.eliminationChain < entrantB.eliminationChain;
+        }
+
+        return entrantA.seed < entrantB.seed;
+
+    });
+
+    return order;
+
+}
+
+
+//Function that returns the number of entrants
+unsigned long tournament::getEntrantCount(){
+
+    return entrants.size();
+
+}
+
+
+//Function that returns an entrant
+const tournamentEntrant &tournament::getEntrant(unsigned long entrantIndex){
+
+    return entrants[entrantIndex];
+
+}
+
+
+//Function that returns the number of matches
+unsigned long tournament::getMatchCount(){
+
+    return matches.size();
+
+}
+
+
+//Function that returns a match
+const tournamentMatch &tournament::getMatch(unsigned long matchIndex){
+
+    return matches[matchIndex];
+
+}
+
+
+//Function that returns the number of matches not decided yet
+unsigned long tournament::getMatchesLeft(){
+
+    return matchesLeft;
+
+}
+
+
+//Function that returns the number of ready matches waiting for a table
+unsigned long tournament::getReadyCount(){
+
+    return readyMatches.size();
+
+}
+
+
+//Function that returns the number of tables
+unsigned long tournament::getTableCount(){
+
+    return tables.size();
+
+}
+
+
+//Function that returns the match being played on a table
+unsigned long tournament::getTableMatch(unsigned long table){
+
+    return (table < tables.size()) ? tables[table] : TOURNAMENT_NONE;
+
+}